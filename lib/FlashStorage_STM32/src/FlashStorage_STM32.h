@@ -10,7 +10,7 @@
 
   Built by Khoi Hoang https://github.com/khoih-prog/FlashStorage_STM32
   Licensed under MIT license
-  Version: 1.2.0
+  Version: 1.2.2
 
   Version Modified By   Date        Comments
   ------- -----------  ----------   -----------
@@ -18,6 +18,8 @@
   1.0.1   K Hoang      23/02/2021  Fix compiler warnings.
   1.1.0   K Hoang      26/04/2021  Add support to new STM32 core v2.0.0 and new STM32L5 boards.
   1.2.0   K Hoang      25/01/2022  Fix `multiple-definitions` linker error
+  1.2.1   E Siami      16/10/2026  Bulk get/put, compare-before-write and dirty range tracking
+  1.2.2   E Siami      16/10/2026  Partial-page flush, skip the erase when units can be programmed in place
   ******************************************************************************************************************************************/
 
 // The .hpp contains only definitions, and can be included as many times as necessary, without `Multiple Definitions` Linker Error
@@ -10,7 +10,7 @@
 
   Built by Khoi Hoang https://github.com/khoih-prog/FlashStorage_STM32
   Licensed under MIT license
-  Version: 1.2.0
+  Version: 1.2.2
 
   Version Modified By   Date        Comments
   ------- -----------  ----------   -----------
@@ -18,6 +18,8 @@
   1.0.1   K Hoang      23/02/2021  Fix compiler warnings.
   1.1.0   K Hoang      26/04/2021  Add support to new STM32 core v2.0.0 and new STM32L5 boards.
   1.2.0   K Hoang      25/01/2022  Fix `multiple-definitions` linker error
+  1.2.1   E Siami      16/10/2026  Bulk get/put, compare-before-write and dirty range tracking
+  1.2.2   E Siami      16/10/2026  Partial-page flush, skip the erase when units can be programmed in place
   ******************************************************************************************************************************************/
 
 // The .hpp contains only definitions, and can be included as many times as necessary, without `Multiple Definitions` Linker Error
@@ -29,13 +31,13 @@
 #define FlashStorage_STM32_hpp
 
 #ifndef FLASH_STORAGE_STM32_VERSION
-  #define FLASH_STORAGE_STM32_VERSION            "FlashStorage_STM32 v1.2.0"
+  #define FLASH_STORAGE_STM32_VERSION            "FlashStorage_STM32 v1.2.2"
 
   #define FLASH_STORAGE_STM32_VERSION_MAJOR      1
   #define FLASH_STORAGE_STM32_VERSION_MINOR      2
-  #define FLASH_STORAGE_STM32_VERSION_PATCH      0
+  #define FLASH_STORAGE_STM32_VERSION_PATCH      2
 
-  #define FLASH_STORAGE_STM32_VERSION_INT        1002000
+  #define FLASH_STORAGE_STM32_VERSION_INT        1002002
 
 #endif
 
@@ -50,7 +52,8 @@
   {
     public:
     
-      EEPROMClass() : _initialized(false), _dirtyBuffer(false), _commitASAP(true) , _validEEPROM(true) {}
+      EEPROMClass() : _initialized(false), _dirtyBuffer(false), _commitASAP(true) , _validEEPROM(true),
+                      _dirtyStart(0), _dirtyEnd(0) {}
 
       /**
        * Read an eeprom cell
@@ -77,8 +80,8 @@
           
         if (eeprom_buffered_read_byte(address) != value)
         {
-          _dirtyBuffer = true;
           eeprom_buffered_write_byte(address, value);
+          markDirty(address, address);
         }
       }
 
@@ -104,13 +107,11 @@
         if (!_initialized) 
           init();
           
-        uint16_t offset = idx;
-        uint8_t* _pointer = (uint8_t *) &t;
-        
-        for ( uint16_t count = sizeof(T) ; count ; --count, ++offset )
-        {  
-          *_pointer++ = eeprom_buffered_read_byte(offset);
-        }
+        if (!inRange(idx, sizeof(T)))
+          return t;
+
+        // One bulk copy out of the RAM buffer
+        eeprom_buffered_read(idx, (uint8_t *) &t, sizeof(T));
           
         return t;
       }
@@ -121,28 +122,23 @@
         if (!_initialized) 
           init();
         
-        uint16_t offset = idx;
+        if (!inRange(idx, sizeof(T)))
+          return t;
+
+        uint32_t first, last;
            
-        const uint8_t* _pointer = (const uint8_t *) &t;
-        
-        for ( uint16_t count = sizeof(T) ; count ; --count, ++offset )
-        {              
-          eeprom_buffered_write_byte(offset, *_pointer++);
+        // Compare-before-write: only the bytes that differ reach the buffer
+        if (eeprom_buffered_update(idx, (const uint8_t *) &t, sizeof(T), &first, &last))
+        {
+          markDirty(first, last);
         }
 
         if (_commitASAP)
         {
-          // Save the data from the buffer to the flash right away
-          eeprom_buffer_flush();
-          
-          _dirtyBuffer = false;
-          _validEEPROM = true;
-        }
-        else  
-        {
-          // Delay saving the data from the buffer to the flash. Just flag and wait for commit() later
-          _dirtyBuffer = true;    
+          // Save the data from the buffer to the flash right away (only if something changed)
+          commit();
         }
+        // else: delay saving the data from the buffer to the flash. Just flag and wait for commit() later
              
         return t;
       }
@@ -156,6 +152,15 @@
         return _validEEPROM;
       }
 
+      /**
+       * Check whether the buffer holds changes that are not in flash yet
+       * @return true, if commit() would write to flash
+       */
+      bool isDirty()
+      {
+        return _dirtyBuffer;
+      }
+
       /**
        * Write previously made eeprom changes to the underlying flash storage
        * Use this with care: Each and every commit will harm the flash and reduce it's lifetime (like with every flash memory)
@@ -167,8 +172,8 @@
           
         if (_dirtyBuffer) 
         {
-          // Save the data from the buffer to the flash
-          eeprom_buffer_flush();
+          // Save only the changed part of the buffer to the flash
+          eeprom_buffer_flush_range(_dirtyStart, _dirtyEnd);
           
           _dirtyBuffer = false;
           _validEEPROM = true;
@@ -189,10 +194,34 @@
         _initialized = true;
       }
 
+      bool inRange(const int& idx, const uint32_t& len)
+      {
+        return (idx >= 0) && ((uint32_t) idx + len <= (uint32_t) E2END + 1);
+      }
+
+      void markDirty(const uint32_t& first, const uint32_t& last)
+      {
+        if (!_dirtyBuffer)
+        {
+          _dirtyStart = first;
+          _dirtyEnd   = last;
+          _dirtyBuffer = true;
+        }
+        else
+        {
+          if (first < _dirtyStart) _dirtyStart = first;
+          if (last  > _dirtyEnd)   _dirtyEnd   = last;
+        }
+      }
+
       bool _initialized;     
       bool _dirtyBuffer;
       bool _commitASAP;
       bool _validEEPROM;
+
+      // Inclusive byte range of the buffer that differs from flash (valid while _dirtyBuffer)
+      uint32_t _dirtyStart;
+      uint32_t _dirtyEnd;
   };
   
   static EEPROMClass EEPROM;
@@ -10,7 +10,7 @@
 
   Built by Khoi Hoang https://github.com/khoih-prog/FlashStorage_STM32
   Licensed under MIT license
-  Version: 1.2.0
+  Version: 1.2.2
 
   Version Modified By   Date        Comments
   ------- -----------  ----------   -----------
@@ -18,6 +18,8 @@
   1.0.1   K Hoang      23/02/2021  Fix compiler warnings.
   1.1.0   K Hoang      26/04/2021  Add support to new STM32 core v2.0.0 and new STM32L5 boards.
   1.2.0   K Hoang      25/01/2022  Fix `multiple-definitions` linker error
+  1.2.1   E Siami      16/10/2026  Bulk get/put, compare-before-write and dirty range tracking
+  1.2.2   E Siami      16/10/2026  Partial-page flush, skip the erase when units can be programmed in place
   ******************************************************************************************************************************************/
 
 /**
@@ -140,8 +142,12 @@ void    eeprom_write_byte(const uint32_t& pos, const uint8_t& value);
 #if !defined(DATA_EEPROM_BASE)
   void    eeprom_buffer_fill();
   void    eeprom_buffer_flush();
+  void    eeprom_buffer_flush_range(const uint32_t& first, const uint32_t& last);
   uint8_t eeprom_buffered_read_byte(const uint32_t& pos);
   void    eeprom_buffered_write_byte(const uint32_t& pos, const uint8_t& value);
+  void    eeprom_buffered_read(const uint32_t& pos, uint8_t* data, const uint32_t& len);
+  bool    eeprom_buffered_update(const uint32_t& pos, const uint8_t* data, const uint32_t& len,
+                                 uint32_t* first, uint32_t* last);
 #endif /* ! DATA_EEPROM_BASE */
 
 #ifdef __cplusplus
@@ -10,7 +10,7 @@
 
   Built by Khoi Hoang https://github.com/khoih-prog/FlashStorage_STM32
   Licensed under MIT license
-  Version: 1.2.0
+  Version: 1.2.2
 
   Version Modified By   Date        Comments
   ------- -----------  ----------   -----------
@@ -18,6 +18,8 @@
   1.0.1   K Hoang      23/02/2021  Fix compiler warnings.
   1.1.0   K Hoang      26/04/2021  Add support to new STM32 core v2.0.0 and new STM32L5 boards.
   1.2.0   K Hoang      25/01/2022  Fix `multiple-definitions` linker error
+  1.2.1   E Siami      16/10/2026  Bulk get/put, compare-before-write and dirty range tracking
+  1.2.2   E Siami      16/10/2026  Partial-page flush, skip the erase when units can be programmed in place
   ******************************************************************************************************************************************/
 /**
   ******************************************************************************
@@ -251,6 +253,52 @@ void eeprom_buffered_write_byte(const uint32_t& pos, const uint8_t& value)
   eeprom_buffer[pos] = value;
 }
 
+/**
+  * @brief  Function reads a block of bytes from the eeprom buffer
+  * @param  pos : first address to read
+  * @param  data : destination
+  * @param  len : number of bytes
+  * @retval none
+  */
+void eeprom_buffered_read(const uint32_t& pos, uint8_t* data, const uint32_t& len)
+{
+  memcpy(data, eeprom_buffer + pos, len);
+}
+
+/**
+  * @brief  Function writes a block of bytes to the eeprom buffer, only if it differs
+  * @param  pos : first address to write
+  * @param  data : source
+  * @param  len : number of bytes
+  * @param  first : receives the first changed address (if any)
+  * @param  last : receives the last changed address (if any)
+  * @retval true if at least one byte of the buffer changed
+  */
+bool eeprom_buffered_update(const uint32_t& pos, const uint8_t* data, const uint32_t& len,
+                            uint32_t* first, uint32_t* last)
+{
+  uint8_t* dst = eeprom_buffer + pos;
+  uint32_t start = 0;
+  uint32_t end = len;
+
+  /* Narrow down to the bytes that really differ */
+  while (start < end && dst[start] == data[start])
+    start++;
+
+  if (start == end)
+    return false;
+
+  while (dst[end - 1] == data[end - 1])
+    end--;
+
+  memcpy(dst + start, data + start, end - start);
+
+  *first = pos + start;
+  *last  = pos + end - 1;
+
+  return true;
+}
+
 /**
   * @brief  This function copies the data from flash into the buffer
   * @param  none
@@ -264,34 +312,96 @@ void eeprom_buffer_fill()
 #if defined(EEPROM_RETRAM_MODE)
 
   /**
-    * @brief  This function writes the buffer content into the flash
-    * @param  none
+    * @brief  This function writes a range of the buffer into the RETRAM
+    * @param  first : first address to write
+    * @param  last : last address to write (inclusive)
     * @retval none
     */
-  void eeprom_buffer_flush()
+  void eeprom_buffer_flush_range(const uint32_t& first, const uint32_t& last)
   {
-    memcpy((uint8_t *)(FLASH_BASE_ADDRESS), eeprom_buffer, E2END + 1);
+    if ((first > last) || (last > E2END))
+      return;
+      
+    memcpy((uint8_t *)(FLASH_BASE_ADDRESS) + first, eeprom_buffer + first, last - first + 1);
   }
 
 #else /* defined(EEPROM_RETRAM_MODE) */
 
+  /* Smallest unit HAL_FLASH_Program() writes on each family */
+  #if defined (STM32F0xx) || defined (STM32F1xx) || defined (STM32F3xx) || defined (STM32G0xx) || \
+      defined (STM32G4xx) || defined (STM32L4xx) || defined (STM32L5xx) || defined (STM32WBxx)
+    #define EEPROM_PAGE_ERASE
+    #define EEPROM_PROGRAM_UNIT     8
+  #elif defined(STM32H7xx)
+    #define EEPROM_PROGRAM_UNIT     32
+  #else
+    #define EEPROM_PROGRAM_UNIT     4
+  #endif
+
+  /*
+   * F2/F4/F7 accept programming a word that only clears bits (1 -> 0).
+   * The other families (halfword rules on F0/F1/F3, ECC on G/L/WB/H7) can only
+   * program a unit that is still fully erased.
+   */
+  #if defined(STM32F2xx) || defined(STM32F4xx) || defined(STM32F7xx)
+    #define EEPROM_PROGRAM_CLEARS_BITS
+  #endif
+
+  #if ((E2END + 1) % EEPROM_PROGRAM_UNIT) != 0
+    #error "E2END + 1 must be a multiple of EEPROM_PROGRAM_UNIT"
+  #endif
+
   /**
-    * @brief  This function writes the buffer content into the flash
+    * @brief  Checks whether a buffer unit can be programmed over the current flash content
+    * @param  offset : unit offset in the buffer
+    * @retval true if the unit can be programmed without erasing the page first
+    */
+  static bool eeprom_unit_programmable(const uint32_t& offset)
+  {
+    const uint8_t* flash = (const uint8_t *)(FLASH_BASE_ADDRESS) + offset;
+    
+    for (uint32_t i = 0; i < EEPROM_PROGRAM_UNIT; i++)
+    {
+  #if defined(EEPROM_PROGRAM_CLEARS_BITS)
+      /* Only 1 -> 0 transitions are allowed */
+      if ((flash[i] & eeprom_buffer[offset + i]) != eeprom_buffer[offset + i])
+  #else
+      if (flash[i] != 0xFF)
+  #endif
+        return false;
+    }
+    
+    return true;
+  }
+
+  /**
+    * @brief  Checks whether a buffer unit is in the erased state (all 0xFF)
+    * @param  offset : unit offset in the buffer
+    * @retval true if programming this unit after an erase is not needed
+    */
+  static bool eeprom_unit_erased(const uint32_t& offset)
+  {
+    for (uint32_t i = 0; i < EEPROM_PROGRAM_UNIT; i++)
+    {
+      if (eeprom_buffer[offset + i] != 0xFF)
+        return false;
+    }
+    
+    return true;
+  }
+
+  /**
+    * @brief  Erases the flash page / sector holding the emulated eeprom
     * @param  none
-    * @retval none
+    * @retval true on success
     */
-  void eeprom_buffer_flush()
+  static bool eeprom_flash_erase()
   {
     FLASH_EraseInitTypeDef EraseInitStruct;
-    uint32_t offset = 0;
-    uint32_t address = FLASH_BASE_ADDRESS;
-    uint32_t address_end = FLASH_BASE_ADDRESS + E2END;
     
-  #if defined (STM32F0xx) || defined (STM32F1xx) || defined (STM32F3xx) || defined (STM32G0xx) || \
-      defined (STM32G4xx) || defined (STM32L4xx) || defined (STM32L5xx) || defined (STM32WBxx)
-      
+  #if defined(EEPROM_PAGE_ERASE)
+  
     uint32_t pageError = 0;
-    uint64_t data = 0;
 
     /* ERASING page */
     EraseInitStruct.TypeErase = FLASH_TYPEERASE_PAGES;
@@ -312,44 +422,12 @@ void eeprom_buffer_fill()
   
     EraseInitStruct.NbPages = 1;
 
-    if (HAL_FLASH_Unlock() == HAL_OK) 
-    {
-  #if defined (STM32G0xx) || defined (STM32G4xx) || defined (STM32L4xx) || defined (STM32L5xx) || defined (STM32WBxx)       
-      __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
-  #else
-      __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_WRPERR | FLASH_FLAG_PGERR);
-  #endif
-  
-      if (HAL_FLASHEx_Erase(&EraseInitStruct, &pageError) == HAL_OK) 
-      {
-        while (address <= address_end) 
-        {
-          data = *((uint64_t *)((uint8_t *)eeprom_buffer + offset));
-
-          if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address, data) == HAL_OK) 
-          {
-            address += 8;
-            offset += 8;
-          } 
-          else 
-          {
-            address = address_end + 1;
-          }
-        }
-      }
-      
-      HAL_FLASH_Lock();
-    }
+    return (HAL_FLASHEx_Erase(&EraseInitStruct, &pageError) == HAL_OK);
+    
   #else
   
     uint32_t SectorError = 0;
 
-  #if defined(STM32H7xx)
-    uint64_t data[4] = {0x0000};
-  #else
-    uint32_t data = 0;
-  #endif
-
     /* ERASING page */
     EraseInitStruct.TypeErase = FLASH_TYPEERASE_SECTORS;
     
@@ -361,43 +439,127 @@ void eeprom_buffer_fill()
     EraseInitStruct.Sector = FLASH_DATA_SECTOR;
     EraseInitStruct.NbSectors = 1;
 
-    HAL_FLASH_Unlock();
+    return (HAL_FLASHEx_Erase(&EraseInitStruct, &SectorError) == HAL_OK);
+    
+  #endif
+  }
+
+  /**
+    * @brief  Programs one unit of the buffer into the flash
+    * @param  offset : unit offset in the buffer
+    * @retval true on success
+    */
+  static bool eeprom_flash_program_unit(const uint32_t& offset)
+  {
+    uint32_t address = FLASH_BASE_ADDRESS + offset;
+    
+  #if defined(EEPROM_PAGE_ERASE)
+    uint64_t data = 0;
+    
+    memcpy(&data, eeprom_buffer + offset, sizeof(uint64_t));
+    
+    return (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address, data) == HAL_OK);
+  #elif defined(STM32H7xx)
+    /* 256 bits */
+    uint64_t data[4] = {0x0000};
+    
+    memcpy(&data, eeprom_buffer + offset, 8 * sizeof(uint32_t));
+    
+    return (HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, address, (uint32_t)data) == HAL_OK);
+  #else
+    uint32_t data = 0;
+    
+    memcpy(&data, eeprom_buffer + offset, sizeof(uint32_t));
+    
+    return (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, data) == HAL_OK);
+  #endif
+  }
 
-    if (HAL_FLASHEx_Erase(&EraseInitStruct, &SectorError) == HAL_OK) 
+  /**
+    * @brief  This function writes a range of the buffer content into the flash
+    *
+    *         Only units that differ from the flash are programmed. If all of them can
+    *         be programmed over the current content (erased units, or 1 -> 0 only on
+    *         F2/F4/F7) the erase is skipped. Otherwise the page is erased and only
+    *         the units that are not 0xFF in the buffer are programmed again.
+    *
+    * @param  first : first address that changed
+    * @param  last : last address that changed (inclusive)
+    * @retval none
+    */
+  void eeprom_buffer_flush_range(const uint32_t& first, const uint32_t& last)
+  {
+    if ((first > last) || (last > E2END))
+      return;
+      
+    uint32_t start = first - (first % EEPROM_PROGRAM_UNIT);
+    uint32_t end   = last  - (last  % EEPROM_PROGRAM_UNIT) + EEPROM_PROGRAM_UNIT;
+    bool needErase = false;
+    bool changed   = false;
+    
+    for (uint32_t offset = start; offset < end; offset += EEPROM_PROGRAM_UNIT) 
     {
-      while (address <= address_end) 
+      if (memcmp(eeprom_buffer + offset, (const uint8_t *)(FLASH_BASE_ADDRESS) + offset, EEPROM_PROGRAM_UNIT) != 0) 
       {
-  #if defined(STM32H7xx)
-        /* 256 bits */
-        memcpy(&data, eeprom_buffer + offset, 8 * sizeof(uint32_t));
-        
-        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, address, (uint32_t)data) == HAL_OK) 
-        {
-          address += 32;
-          offset += 32;
-  #else
-        memcpy(&data, eeprom_buffer + offset, sizeof(uint32_t));
+        changed = true;
         
-        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, data) == HAL_OK) 
-        {
-          address += 4;
-          offset += 4;
-  #endif
-        } 
-        else 
+        if (!eeprom_unit_programmable(offset)) 
         {
-          address = address_end + 1;
+          needErase = true;
+          break;
         }
       }
     }
+
+    if (!changed)
+      return;
+
+    if (HAL_FLASH_Unlock() != HAL_OK)
+      return;
+      
+  #if defined (STM32G0xx) || defined (STM32G4xx) || defined (STM32L4xx) || defined (STM32L5xx) || defined (STM32WBxx)       
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+  #elif defined(EEPROM_PAGE_ERASE)
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_WRPERR | FLASH_FLAG_PGERR);
+  #endif
+
+    if (needErase) 
+    {
+      if (!eeprom_flash_erase()) 
+      {
+        HAL_FLASH_Lock();
+        return;
+      }
+      
+      /* The whole page is blank now, everything that is not 0xFF has to go back */
+      start = 0;
+      end   = E2END + 1;
+    }
     
-    HAL_FLASH_Lock();
+    for (uint32_t offset = start; offset < end; offset += EEPROM_PROGRAM_UNIT) 
+    {
+      bool skip = needErase ? eeprom_unit_erased(offset)
+                            : (memcmp(eeprom_buffer + offset, (const uint8_t *)(FLASH_BASE_ADDRESS) + offset, EEPROM_PROGRAM_UNIT) == 0);
+                            
+      if (!skip && !eeprom_flash_program_unit(offset))
+        break;
+    }
     
-  #endif
+    HAL_FLASH_Lock();
   }
 
 #endif /* defined(EEPROM_RETRAM_MODE) */
 
+/**
+  * @brief  This function writes the buffer content into the flash
+  * @param  none
+  * @retval none
+  */
+void eeprom_buffer_flush()
+{
+  eeprom_buffer_flush_range(0, E2END);
+}
+
 #endif /* ! DATA_EEPROM_BASE */
 
 #ifdef __cplusplus
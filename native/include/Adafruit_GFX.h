@@ -0,0 +1,23 @@
+/**
+ * @file Adafruit_GFX.h
+ * @author Ebrahim Siami
+ * @brief Minimal Adafruit_GFX shim, just enough for DisplayManager.h
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * DisplayManager.cpp itself is not built natively (see DisplayStub.cpp).
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class Adafruit_GFX {
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+protected:
+    int16_t _width, _height;
+};
@@ -0,0 +1,31 @@
+/**
+ * @file Adafruit_SSD1306.h
+ * @author Ebrahim Siami
+ * @brief Minimal Adafruit_SSD1306 shim for the native build
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_WHITE 1
+#define SSD1306_BLACK 0
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t rstPin = -1)
+        : Adafruit_GFX(w, h) { (void)twi; (void)rstPin; }
+
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0) {
+        (void)switchvcc; (void)i2caddr;
+        return true;
+    }
+    void clearDisplay() {}
+    void display() { frames++; }
+
+    uint32_t frames = 0;    // native only: how many times the panel was refreshed
+};
@@ -0,0 +1,107 @@
+/**
+ * @file Arduino.h
+ * @author Ebrahim Siami
+ * @brief Arduino API shim for the native (Linux) build
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Only the part of the Arduino / STM32duino API the firmware actually uses.
+ * Time, pins, ADC, Serial and the hardware UART are simulated in native/src/NativeHal.cpp and
+ * driven from the host side through NativeHal.h.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// =============================================================================
+// --- Pins ---
+// =============================================================================
+
+#define LOW  0
+#define HIGH 1
+
+enum PinModeType : uint8_t { INPUT, OUTPUT, INPUT_PULLUP, INPUT_PULLDOWN, INPUT_ANALOG };
+
+// Same numbering idea as the STM32 core: port * 16 + pin
+enum PinName : uint8_t {
+    PA0 = 0, PA1, PA2, PA3, PA4, PA5, PA6, PA7, PA8, PA9, PA10, PA11, PA12, PA13, PA14, PA15,
+    PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7, PB8, PB9, PB10, PB11, PB12, PB13, PB14, PB15,
+    PC13 = 45, PC14, PC15,
+    NATIVE_PIN_COUNT
+};
+
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t value);
+int  digitalRead(uint32_t pin);
+int  analogRead(uint32_t pin);
+void analogReadResolution(int bits);
+
+// =============================================================================
+// --- Time (simulated, advanced by the host) ---
+// =============================================================================
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+// =============================================================================
+// --- Math helpers ---
+// =============================================================================
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// =============================================================================
+// --- Serial (USB CDC on the real board) ---
+// =============================================================================
+
+class NativeSerial {
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t b) { return write(&b, 1); }
+    size_t write(const uint8_t* data, size_t len);
+    int available();
+    int read();
+    size_t readBytes(uint8_t* buffer, size_t length);   // never waits, at most available() bytes
+    void flush() {}
+    operator bool() const { return true; }
+};
+
+extern NativeSerial Serial;
+
+// =============================================================================
+// --- Hardware UART (USART1-3 on the real board) ---
+// =============================================================================
+
+// All instances share one capture buffer, see NativeHal::uartTx()
+class HardwareSerial {
+public:
+    explicit HardwareSerial(uint32_t rxtx) : HardwareSerial(rxtx, rxtx) {}
+    HardwareSerial(uint32_t rx, uint32_t tx) { (void)rx; (void)tx; }
+    void begin(unsigned long baud);
+    void end();
+    size_t write(uint8_t b) { return write(&b, 1); }
+    size_t write(const uint8_t* data, size_t len);
+};
+
+// =============================================================================
+// --- STM32 HAL ---
+// =============================================================================
+
+// 96-bit unique ID, see NativeHal::setUid()
+uint32_t HAL_GetUIDw0();
+uint32_t HAL_GetUIDw1();
+uint32_t HAL_GetUIDw2();
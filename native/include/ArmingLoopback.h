@@ -0,0 +1,32 @@
+/**
+ * @file ArmingLoopback.h
+ * @author Ebrahim Siami
+ * @brief Throttle interlock through the whole channel pipeline (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Moves the throttle stick (ADC) and the Aux3 switch and runs loop(), with
+ * throttle setups that keep the output away from the EPA end at the bottom
+ * of the stick. Checks:
+ *
+ *   - default settings arm with the stick down
+ *   - airplane mode with a 5-point curve starting at -60 % arms with the stick
+ *     down, the output is the EPA end until then and the curve value after
+ *   - the same curve on an inverted throttle
+ *   - mix lines adding a constant to the throttle don't stop the arming
+ *   - with the stick up it waits until the stick comes down
+ *   - the throttle cut (Aux3) holds the EPA end, released with the stick up it
+ *     waits for the stick again
+ */
+
+#pragma once
+
+namespace ArmingLoopback {
+
+/**
+ * @brief Runs the test. setup() must have run already.
+ * @return Number of failed checks (0 = pass).
+ */
+int run(bool verbose);
+
+} // namespace ArmingLoopback
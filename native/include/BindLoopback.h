@@ -0,0 +1,32 @@
+/**
+ * @file BindLoopback.h
+ * @author Ebrahim Siami
+ * @brief Bind procedure against a stand-in receiver (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Puts a simulated receiver on the air (NativeHal::onRadioAir()) that
+ * behaves like the receiver side of bind_format.h: it listens on the legacy
+ * link until it is put in bind mode, takes the first good ANNOUNCE, moves to
+ * the announced address and channel and ACKs there. Then checks:
+ *
+ *   - the address derivation: every UID gets a usable address, no two alike
+ *   - an unbound model still talks to an unbound receiver (legacy address)
+ *   - no receiver in bind mode: the procedure gives up, nothing changes
+ *   - with lost packets and a lost ACK the handshake still completes, the
+ *     model stores the address of this transmitter and the channels follow
+ *   - a receiver on the legacy address no longer hears the bound model
+ *   - after a power cycle the model is still on its own link
+ */
+
+#pragma once
+
+namespace BindLoopback {
+
+/**
+ * @brief Runs the test. setup() must have run already.
+ * @return Number of failed checks (0 = pass).
+ */
+int run(bool verbose);
+
+} // namespace BindLoopback
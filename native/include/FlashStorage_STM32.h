@@ -0,0 +1,11 @@
+/**
+ * @file FlashStorage_STM32.h
+ * @author Ebrahim Siami
+ * @brief Native build: the EEPROM object lives in NativeHal.cpp
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "FlashStorage_STM32.hpp"
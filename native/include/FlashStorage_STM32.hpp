@@ -0,0 +1,88 @@
+/**
+ * @file FlashStorage_STM32.hpp
+ * @author Ebrahim Siami
+ * @brief RAM backed EEPROMClass for the native build
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Same API and the same compare-before-write behaviour as lib/FlashStorage_STM32
+ * (v1.2.2), so the number of flash write cycles seen on the host matches the
+ * board. The image can be loaded from / saved to a file via NativeHal.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+// One 1 KB flash page, like the Blue Pill
+#ifndef E2END
+  #define E2END 0x3FF
+#endif
+
+class EEPROMClass {
+public:
+    EEPROMClass() { memset(_data, 0xFF, sizeof(_data)); }
+
+    uint8_t read(const int& address) { return inRange(address, 1) ? _data[address] : 0; }
+
+    void update(const int& address, const uint8_t& value) { put(address, value); }
+
+    void write(const int& address, const uint8_t& value) { update(address, value); }
+
+    template< typename T > T &get( const int& idx, T &t )
+    {
+        if (inRange(idx, sizeof(T)))
+            memcpy(&t, &_data[idx], sizeof(T));
+        return t;
+    }
+
+    template< typename T > const T &put( const int& idx, const T &t )
+    {
+        if (!inRange(idx, sizeof(T)))
+            return t;
+
+        if (memcmp(&_data[idx], &t, sizeof(T)) != 0)
+        {
+            memcpy(&_data[idx], &t, sizeof(T));
+            _dirty = true;
+        }
+
+        if (_commitASAP)
+            commit();
+
+        return t;
+    }
+
+    bool isValid() { return true; }
+    bool isDirty() { return _dirty; }
+
+    void commit()
+    {
+        if (!_dirty)
+            return;
+        _dirty = false;
+        _commits++;
+    }
+
+    uint16_t length() { return E2END + 1; }
+
+    void setCommitASAP(bool value = true) { _commitASAP = value; }
+    bool getCommitASAP() { return _commitASAP; }
+
+    // --- native only ---
+    uint8_t* data() { return _data; }
+    uint32_t commits() const { return _commits; }
+
+private:
+    uint8_t _data[E2END + 1];
+    bool _dirty = false;
+    bool _commitASAP = true;
+    uint32_t _commits = 0;
+
+    bool inRange(const int& idx, const uint32_t& len)
+    {
+        return (idx >= 0) && ((uint32_t) idx + len <= (uint32_t) E2END + 1);
+    }
+};
+
+extern EEPROMClass EEPROM;
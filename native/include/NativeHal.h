@@ -0,0 +1,94 @@
+/**
+ * @file NativeHal.h
+ * @author Ebrahim Siami
+ * @brief Host-side control of the simulated hardware (native build only)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * The firmware talks to the Arduino shim as if it was a Blue Pill. This is
+ * the other side: the native main (or a replay tool) sets stick voltages and
+ * switch levels, moves the clock forward and looks at what came out of the
+ * radio, the USB port, the hardware UART and the buzzer pin.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace NativeHal {
+
+/**
+ * @brief Puts time, pins, serial and radio back to power-on state.
+ * All inputs float high (released buttons), all analog inputs read 2048.
+ * The EEPROM keeps its content, like the real flash.
+ */
+void reset();
+
+// --- Time ---
+uint64_t nowMicros();
+void advanceMicros(uint32_t us);
+
+// --- Inputs ---
+void setAnalog(uint8_t pin, uint16_t value);   // 12-bit ADC reading
+void setDigital(uint8_t pin, bool level);      // level seen by digitalRead()
+
+// --- Outputs ---
+bool digitalOutput(uint8_t pin);               // last digitalWrite() level
+
+// --- USB CDC ---
+std::vector<uint8_t>& serialTx();              // everything the firmware wrote
+void serialInject(const uint8_t* data, size_t len);
+
+// --- Hardware UART ---
+std::vector<uint8_t>& uartTx();                // everything written while the UART was open
+uint32_t uartBaud();                           // baud rate of begin(), 0 while closed
+
+// --- NRF24 ---
+typedef void (*RadioWriteHook)(const void* payload, uint8_t len, uint64_t timeUs);
+
+struct RadioStats {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    bool powered = false;
+};
+
+const RadioStats& radioStats();
+void onRadioWrite(RadioWriteHook hook);        // called for every radio.write()
+
+// A receiver on the air: gets every packet with the address and channel it was
+// sent on and returns true if it takes it. With auto-ack on, that's what write() returns.
+typedef bool (*RadioAirHook)(uint64_t address, uint8_t channel, const void* payload, uint8_t len);
+void onRadioAir(RadioAirHook hook);
+
+// What's on the air at the time: true if a channel has a carrier above -64 dBm
+// now. radio.testRPD() asks it, without a hook every channel is quiet.
+typedef bool (*RadioCarrierHook)(uint8_t channel, uint64_t timeUs);
+void onRadioCarrier(RadioCarrierHook hook);
+
+// --- MCU ---
+void setUid(uint32_t w0, uint32_t w1, uint32_t w2);   // HAL_GetUIDw0..2(), kept by reset() like the chip
+
+// --- Simulated execution time ---
+// Off by default: the clock only moves in advanceMicros() and delay(). With a
+// model set, the slow hardware calls move it too, so micros() inside loop()
+// (and the latency stamps of -D LATENCY_TRACE) see roughly what the board sees.
+// Plain computation stays free, so the pipeline itself takes no time.
+struct TimingModel {
+    uint32_t analogReadNs = 0;     // per analogRead()
+    uint32_t radioWriteNs = 0;     // per radio.write(), it waits until the packet is on the air
+    uint32_t radioUploadNs = 0;    // per radio.startFastWrite() (RadioDma.h), it doesn't even wait for the SPI
+    uint32_t serialCallNs = 0;     // per Serial.write() call (USB CDC)
+    uint32_t serialByteNs = 0;     // ... plus per byte
+};
+
+TimingModel bluePillTiming();                  // rough figures of the F103 at 72 MHz
+void setTimingModel(const TimingModel& model); // TimingModel() turns it off again
+
+// --- Emulated EEPROM ---
+bool eepromLoad(const char* path);             // false if the file does not exist
+bool eepromSave(const char* path);
+uint32_t eepromCommits();                      // number of flash write cycles
+
+} // namespace NativeHal
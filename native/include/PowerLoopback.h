@@ -0,0 +1,33 @@
+/**
+ * @file PowerLoopback.h
+ * @author Ebrahim Siami
+ * @brief Adaptive TX power against a simulated receiver at a distance (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Puts a receiver on the air (NativeHal::onRadioAir()) whose packet loss
+ * follows the link margin: the PA level of the transmitter plus a path
+ * margin set by each scenario. Its ACKs come back over the same path. Checks:
+ *
+ *   - a receiver that doesn't ACK: the PA stays at MAX
+ *   - close range: down to MIN within a few seconds, no packets lost
+ *   - a sudden fade (model behind a tree): back up within a few probes
+ *   - walking away: never more than a point of packets lost against a fixed MAX
+ *   - sitting on the edge of a level for minutes: few level changes (hysteresis)
+ *   - switched off: MAX and no ACKs again
+ *
+ * Loss per direction is 1 / (1 + e^(0.8 * margin dB)): 50 % at 0 dB, 8 % at
+ * 3 dB, under 1 % from 6 dB. The PA levels are 6 dB apart.
+ */
+
+#pragma once
+
+namespace PowerLoopback {
+
+/**
+ * @brief Runs the test. setup() must have run already.
+ * @return Number of failed checks (0 = pass).
+ */
+int run(bool verbose);
+
+} // namespace PowerLoopback
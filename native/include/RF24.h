@@ -0,0 +1,70 @@
+/**
+ * @file RF24.h
+ * @author Ebrahim Siami
+ * @brief RF24 shim for the native build
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Same method names as nrf24/RF24, the payloads end up in NativeHal
+ * (see NativeHal::onRadioWrite()). A simulated receiver can listen in with
+ * NativeHal::onRadioAir(), it sees the address and channel of every packet
+ * and its answer is the ACK. What the receiver hears (testRPD()) comes from
+ * NativeHal::onRadioCarrier().
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef enum { RF24_PA_MIN = 0, RF24_PA_LOW, RF24_PA_HIGH, RF24_PA_MAX, RF24_PA_ERROR } rf24_pa_dbm_e;
+typedef enum { RF24_1MBPS = 0, RF24_2MBPS, RF24_250KBPS } rf24_datarate_e;
+
+class RF24 {
+public:
+    RF24(uint16_t cePin, uint16_t csnPin, uint32_t spiSpeed = 10000000) : _ce(cePin), _csn(csnPin) { (void)spiSpeed; }
+
+    bool begin();
+    bool isChipConnected() { return true; }
+    void openWritingPipe(uint64_t address) { _address = address; }
+    void setChannel(uint8_t channel);
+    uint8_t getChannel() { return _channel; }
+    void setAutoAck(bool enable) { _autoAck = enable; }
+    void setRetries(uint8_t delay, uint8_t count) { (void)delay; (void)count; }
+    void enableDynamicAck() { _dynamicAck = true; }
+    bool setDataRate(rf24_datarate_e rate) { _dataRate = rate; return true; }
+    rf24_datarate_e getDataRate() { return _dataRate; }
+    void setPALevel(uint8_t level, bool lnaEnable = 1) { _paLevel = level; (void)lnaEnable; }
+    uint8_t getPALevel() { return _paLevel; }
+    void startListening();
+    void stopListening() { _listening = false; }
+    void powerUp();
+    void powerDown();
+    // With auto-ack: true if a receiver on the air ACKed. multicast = NO_ACK, like
+    // the chip that needs enableDynamicAck() for it and drops the payload otherwise.
+    bool write(const void* buf, uint8_t len, bool multicast);
+    bool write(const void* buf, uint8_t len) { return write(buf, len, false); }
+
+    // Non-blocking: the packet is on the air at once, whatHappened() tells how it went
+    // (TX_DS / MAX_RT, read and cleared like the STATUS register)
+    void startFastWrite(const void* buf, uint8_t len, bool multicast, bool startTx = true);
+    void whatHappened(bool& txOk, bool& txFail, bool& rxReady);
+    uint8_t flush_tx() { return 0; }
+    uint8_t getPayloadSize() { return 32; }
+
+    // Carrier above -64 dBm on the channel. Like the chip only valid 170 us after
+    // RX was entered or the channel changed (PLL settling + AGC), false before.
+    bool testRPD();
+
+private:
+    uint16_t _ce, _csn;
+    uint64_t _address = 0;
+    uint8_t _channel = 76;
+    bool _autoAck = true;
+    bool _dynamicAck = false;
+    rf24_datarate_e _dataRate = RF24_1MBPS;
+    uint8_t _paLevel = RF24_PA_MAX;
+    bool _listening = false;
+    uint64_t _tunedUs = 0;
+    bool _txDs = false;
+    bool _maxRt = false;
+};
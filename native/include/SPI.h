@@ -0,0 +1,19 @@
+/**
+ * @file SPI.h
+ * @author Ebrahim Siami
+ * @brief SPI shim for the native build (the radio is simulated above SPI)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class SPIClass {
+public:
+    void begin() {}
+    void end() {}
+};
+
+extern SPIClass SPI;
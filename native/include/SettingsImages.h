@@ -0,0 +1,33 @@
+/**
+ * @file SettingsImages.h
+ * @author Ebrahim Siami
+ * @brief Settings images of every schema version through the decoder (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Writes the byte image of each stored layout the firmware ever had, byte by
+ * byte from the layout description and not from the structs in
+ * SettingsStore.cpp: v1 (legacy magic + XOR checksum inside RadioSettings),
+ * v2 (plain RadioSettings behind the header) and the packed v3 .. v10. Each
+ * one goes through settingsDecodeImage(). Checks:
+ *
+ *   - the values of the image survive the migration (trims, calibration, EPA,
+ *     sub-trim, expo, flags, inversion mask, rates and everything added later)
+ *   - the fields appended after that version come out at their defaults
+ *   - bad CRC, bad length, a version from the future, a bad v1 checksum and
+ *     erased flash are rejected, and the output is left alone then
+ *   - settingsLoad() migrates a v1 image from the EEPROM, settingsSave() and
+ *     settingsLoad() give the same settings back
+ */
+
+#pragma once
+
+namespace SettingsImages {
+
+/**
+ * @brief Runs the test.
+ * @return Number of failed checks (0 = pass).
+ */
+int run(bool verbose);
+
+} // namespace SettingsImages
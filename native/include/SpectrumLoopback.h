@@ -0,0 +1,34 @@
+/**
+ * @file SpectrumLoopback.h
+ * @author Ebrahim Siami
+ * @brief Channel survey against a simulated 2.4 GHz band (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Puts traffic on the band (NativeHal::onRadioCarrier()): two WiFi networks
+ * on channels 6 and 11, another transmitter sitting in the hop range, a
+ * legacy one on channel 100 and a little noise everywhere. Checks:
+ *
+ *   - the scan goes one channel per loop() at most and no channel packets go out
+ *   - the WiFi networks and the transmitters show up, the rest stays low
+ *   - the counts halve instead of overflowing: the busiest channel stays on top
+ *     and the channels still rank by how busy they are
+ *   - the quietest hop channel is away from the busy ones, the next bind takes it
+ *   - leaving the page brings the channel packets back
+ *   - no scan without the NRF24, and switching to CRSF ends one
+ *
+ * NRF24 channel n is 2400 + n MHz, a WiFi channel c is 22 MHz wide around
+ * 2407 + 5c MHz.
+ */
+
+#pragma once
+
+namespace SpectrumLoopback {
+
+/**
+ * @brief Runs the test. setup() must have run already.
+ * @return Number of failed checks (0 = pass).
+ */
+int run(bool verbose);
+
+} // namespace SpectrumLoopback
@@ -0,0 +1,63 @@
+/**
+ * @file TraceReplay.h
+ * @author Ebrahim Siami
+ * @brief Replays a recorded input trace through the firmware (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Every record sets the ADC and pin levels of the simulated board, moves the
+ * clock to the recorded time and runs loop() once, so the firmware sees the
+ * same inputs at the same millis() as during the flight. Nothing waits for
+ * real time, an hour of flight replays in seconds.
+ *
+ * Outputs, both with a CRC-32 for bit-for-bit comparisons between builds:
+ *   - the data_t of every ADC tick (the bytes the radio sends)
+ *   - everything written to USB, i.e. the SimProto stream in simulator mode
+ *   - everything written to the hardware UART, i.e. the CRSF frames
+ *
+ * It also watches the throttle interlock (Arming.h): how many frames were
+ * held at idle and, with the throttle cut on an aux switch, whether any frame
+ * left with the switch on but the throttle not at idle.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace TraceReplay {
+
+struct Options {
+    bool simulatorMode = false;     // switch simulator mode on after setup(), like the menu does
+    int simBatch = 0;               // > 0: the host asks for SimProto v2 with this batch ...
+    int simChannels = 0;            // ... and this many channels per sample
+    const char* dataOut = nullptr;  // file for the data_t frames (sizeof(data_t) bytes each)
+    const char* simOut = nullptr;   // file for the USB output
+    int throttleCutSwitch = -1;     // LsRef used as throttle cut for the replay, -1 = from the settings
+    int crsfRateHz = 0;             // switch the RF output to CRSF at this rate, 0 = from the settings
+    const char* crsfOut = nullptr;  // file for the UART output
+};
+
+struct Result {
+    uint64_t records = 0;
+    uint64_t skippedBytes = 0;      // garbage / corrupted records in the trace
+    uint64_t frames = 0;            // data_t frames produced (ADC ticks that ran)
+    uint64_t simBytes = 0;
+    uint32_t framesCrc = 0;         // CRC-32 of all data_t frames
+    uint32_t simCrc = 0;            // CRC-32 of the USB output
+    uint64_t uartBytes = 0;
+    uint32_t uartCrc = 0;           // CRC-32 of the UART output
+    int64_t  armedFrame = -1;       // first frame with a live throttle, -1 = never
+    uint64_t heldFrames = 0;        // frames with the throttle held at idle by the interlock
+    uint64_t cutFrames = 0;         // ... of them by the throttle cut
+    uint64_t cutLateFrames = 0;     // cut switch on in the trace, throttle not at idle (must be 0)
+    double simulatedSec = 0;
+    double hostSec = 0;
+};
+
+/**
+ * @brief Replays 'path'. setup() must have run already.
+ * @return false if the file could not be read or written.
+ */
+bool run(const char* path, const Options& options, Result& result);
+
+} // namespace TraceReplay
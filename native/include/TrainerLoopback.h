@@ -0,0 +1,29 @@
+/**
+ * @file TrainerLoopback.h
+ * @author Ebrahim Siami
+ * @brief Loopback test of the trainer / HIL mode (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Plays the host: streams channel frames into the simulated USB port, split
+ * into random chunks and bursts like a real CDC link delivers them, with
+ * corrupted and repeated frames mixed in, and checks what the NRF24 sends:
+ *
+ *   - every packet carries the channels of one of the last good host frames
+ *   - no corrupted or repeated frame ever reaches the radio
+ *   - the throttle interlock still holds the host throttle until it was at idle
+ *   - when the host goes quiet the sticks are back within the watchdog time
+ *   - a restarted host (sequence from 0 again) takes over again
+ */
+
+#pragma once
+
+namespace TrainerLoopback {
+
+/**
+ * @brief Runs the test. setup() must have run already.
+ * @return Number of failed checks (0 = pass).
+ */
+int run(bool verbose);
+
+} // namespace TrainerLoopback
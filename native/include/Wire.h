@@ -0,0 +1,19 @@
+/**
+ * @file Wire.h
+ * @author Ebrahim Siami
+ * @brief I2C shim for the native build (the OLED is stubbed out)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+class TwoWire {
+public:
+    void begin() {}
+    void setClock(uint32_t) {}
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,173 @@
+/**
+ * @file ArmingLoopback.cpp
+ * @author Ebrahim Siami
+ * @brief Throttle interlock through the whole channel pipeline (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "ArmingLoopback.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "NativeHal.h"
+#include "InputTrace.h"
+#include "ChannelPipeline.h"
+#include "Arming.h"
+#include "Outputs.h"
+#include "Mixer.h"
+#include "Curves.h"
+#include "FlightModes.h"
+#include "Settings.h"
+
+void loop();
+
+// Firmware state we look at from the outside (main.cpp)
+extern RadioSettings settings;
+extern ArmingState armingState;
+extern ChannelFrame outputFrame;
+extern MixLine flightModeMixTables[FLIGHT_MODES][MIX_LINES];
+
+namespace ArmingLoopback {
+
+static const uint32_t LOOP_US = 100;
+static const int STICK_DOWN = 0;
+static const int STICK_UP = 3000;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    printf("  %-62s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static void runFor(uint32_t ms) {
+    uint64_t until = NativeHal::nowMicros() + (uint64_t)ms * 1000;
+    while (NativeHal::nowMicros() < until) {
+        loop();
+        NativeHal::advanceMicros(LOOP_US);
+    }
+}
+
+static void stick(int value) {
+    NativeHal::setAnalog(InputTrace::ADC_PINS[InputTrace::ADC_THROTTLE], (uint16_t)value);
+}
+
+static int throttleOut() {
+    return outputFrame.ch[MIX_CH_THROTTLE];
+}
+
+static void report(bool verbose, const char* what) {
+    if (!verbose) return;
+    printf("    (%s: state %u, throttle %d, idle %d)\n", what, armingState.state, throttleOut(),
+           throttleIdleValue(settings));
+}
+
+static void setCurve(bool on) {
+    static const int8_t Y[5] = { -60, -20, 20, 60, 100 };
+    CustomCurve& c = settings.stickCurves[MIX_CH_THROTTLE];
+    c.points = on ? 5 : 0;
+    for (uint8_t i = 0; i < 5; i++) c.y[i] = Y[i];
+    curveBuild(c);
+}
+
+// Stick down, interlock reset as after power-up or a model change, then a while
+static void restart(int stickValue) {
+    stick(stickValue);
+    runFor(20);                       // input filter settles
+    armingReset(armingState);
+}
+
+int run(bool verbose) {
+    failures = 0;
+    settings.throttleCutSwitch = LS_REF_AUX3;
+    NativeHal::setDigital(PB4, false);
+
+    // --- 1. defaults ---
+    printf("defaults:\n");
+    restart(STICK_DOWN);
+    runFor(300);
+    report(verbose, "stick down");
+    check(armingState.state == ARM_ARMED, "arms with the stick down");
+    check(throttleOut() == throttleIdleValue(settings), "output at the EPA end");
+
+    // --- 2. airplane mode and a throttle curve ---
+    printf("airplane mode, curve -60 -20 20 60 100:\n");
+    settings.airplaneMode = true;
+    setCurve(true);
+    int curveIdle = processThrottle(STICK_DOWN, settings, 0);
+    if (verbose) printf("    (stick down gives %d through the curve, idle is %d)\n", curveIdle, throttleIdleValue(settings));
+    check(abs(curveIdle - throttleIdleValue(settings)) > ARM_THROTTLE_LOW_BAND, "curve keeps the output off the EPA end");
+    restart(STICK_DOWN);
+    runFor(ARM_THROTTLE_LOW_MS / 2);
+    check(armingState.state == ARM_WAIT_THROTTLE && throttleOut() == throttleIdleValue(settings),
+          "EPA end until armed");
+    runFor(300);
+    report(verbose, "stick down");
+    check(armingState.state == ARM_ARMED, "arms with the stick down");
+    check(abs(throttleOut() - curveIdle) <= 2, "then the curve value");
+
+    printf("inverted throttle, same curve:\n");
+    settings.airplaneMode = false;
+    settings.channelInverted[MIX_CH_THROTTLE] = true;
+    restart(STICK_DOWN);
+    runFor(ARM_THROTTLE_LOW_MS / 2);
+    check(throttleOut() == settings.epaMax[MIX_CH_THROTTLE], "held at the top EPA end");
+    runFor(300);
+    report(verbose, "stick down");
+    check(armingState.state == ARM_ARMED, "arms with the stick down");
+    check(abs(throttleOut() - processThrottle(STICK_DOWN, settings, 0)) <= 2, "then the inverted curve value");
+    settings.channelInverted[MIX_CH_THROTTLE] = false;
+    setCurve(false);
+
+    // --- 3. a mix line on the throttle ---
+    printf("mix lines Throttle 100 %% + Max 30 %% -> Throttle:\n");
+    static const MixLine LINES[2] = {
+        { MIX_SRC_THROTTLE, MIX_CH_THROTTLE, 100, 0, MIX_CURVE_NONE, MIX_SW_ALWAYS },
+        { MIX_SRC_MAX,      MIX_CH_THROTTLE,  30, 0, MIX_CURVE_NONE, MIX_SW_ALWAYS },
+    };
+    mixerApplyPreset(settings.mixLines, MIX_PRESET_NORMAL);
+    settings.mixLines[0] = LINES[0];
+    settings.mixLines[1] = LINES[1];
+    flightModesBuild(settings, flightModeMixTables);
+    restart(STICK_DOWN);
+    runFor(300);
+    report(verbose, "stick down");
+    check(armingState.state == ARM_ARMED, "arms with the stick down");
+    check(throttleOut() - throttleIdleValue(settings) > ARM_THROTTLE_LOW_BAND, "output is the mixed one");
+
+    // --- 4. stick up ---
+    printf("stick up:\n");
+    restart(STICK_UP);
+    runFor(500);
+    report(verbose, "stick up");
+    check(armingState.state == ARM_WAIT_THROTTLE, "waits");
+    check(throttleOut() == throttleIdleValue(settings), "output at the EPA end");
+    stick(STICK_DOWN);
+    runFor(300);
+    check(armingState.state == ARM_ARMED, "arms once the stick is down");
+
+    // --- 5. throttle cut ---
+    printf("throttle cut on Aux3:\n");
+    NativeHal::setDigital(PB4, true);
+    runFor(50);
+    check(armingState.state == ARM_CUT && throttleOut() == throttleIdleValue(settings), "cut holds the EPA end");
+    stick(STICK_UP);
+    runFor(200);
+    NativeHal::setDigital(PB4, false);
+    runFor(300);
+    report(verbose, "released, stick up");
+    check(armingState.state == ARM_WAIT_THROTTLE && throttleOut() == throttleIdleValue(settings),
+          "released with the stick up: waits");
+    stick(STICK_DOWN);
+    runFor(300);
+    check(armingState.state == ARM_ARMED, "arms once the stick is down");
+
+    mixerApplyPreset(settings.mixLines, MIX_PRESET_NORMAL);
+    flightModesBuild(settings, flightModeMixTables);
+    settings.throttleCutSwitch = LS_REF_NONE;
+
+    printf("\n%s (%d failed)\n", failures ? "FAIL" : "OK", failures);
+    return failures;
+}
+
+} // namespace ArmingLoopback
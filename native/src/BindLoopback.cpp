@@ -0,0 +1,243 @@
+/**
+ * @file BindLoopback.cpp
+ * @author Ebrahim Siami
+ * @brief Bind procedure against a stand-in receiver (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "BindLoopback.h"
+#include <stdio.h>
+#include <random>
+#include <set>
+#include "NativeHal.h"
+#include "Bind.h"
+#include "Radio.h"
+#include "Settings.h"
+#include "SettingsStore.h"
+
+void setup();
+void loop();
+
+// Firmware state we look at from the outside (main.cpp)
+extern RadioSettings settings;
+void applyRfOutput();
+void bindStart();
+
+namespace BindLoopback {
+
+static const uint32_t LOOP_US = 100;
+
+/**
+ * @brief The receiver side of bind_format.h, as a receiver firmware would do it.
+ */
+struct Receiver {
+    bool bindMode = false;
+    Bind::Binding link = {};     // all zero = never bound, legacy link
+    bool dropFirstAck = false;   // takes the first ANNOUNCE but its ACK never arrives
+
+    uint32_t dataPackets = 0;
+    uint32_t announces = 0;
+    uint32_t confirms = 0;
+
+    uint64_t address() const {
+        return Bind::isBound(link.address) ? Bind::pipeAddress(link.address) : Bind::LEGACY_ADDRESS;
+    }
+    uint8_t channel() const {
+        return Bind::isBound(link.address) ? Bind::channelOf(link.hopSeed) : Bind::LEGACY_CHANNEL;
+    }
+
+    // true = the packet was received and the hardware ACKs it
+    bool receive(uint64_t addr, uint8_t ch, const uint8_t* payload, uint8_t len) {
+        Bind::PacketType type;
+        Bind::Binding b;
+
+        if (bindMode) {
+            if (addr != Bind::BIND_ADDRESS || ch != Bind::BIND_CHANNEL) return false;
+            if (Bind::parsePacket(payload, len, type, b) && type == Bind::PACKET_ANNOUNCE) {
+                announces++;
+                link = b;
+                bindMode = false;     // stored, on the new link from now on
+                if (dropFirstAck) {
+                    dropFirstAck = false;
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        if (addr != address() || ch != channel()) return false;
+        if (len == sizeof(data_t)) dataPackets++;
+        if (Bind::parsePacket(payload, len, type, b) && type == Bind::PACKET_CONFIRM) confirms++;
+        return true;
+    }
+};
+
+static Receiver rx;           // the one being bound
+static Receiver oldRx;        // somebody else's receiver, never bound
+static std::mt19937 rng(4646);
+static uint32_t lossPercent = 0;
+static uint64_t dataWhileBinding = 0;
+static int failures = 0;
+
+static bool onAir(uint64_t address, uint8_t channel, const void* payload, uint8_t len) {
+    if (Bind::active() && len == sizeof(data_t)) dataWhileBinding++;
+    if (lossPercent && rng() % 100 < lossPercent) return false;    // lost on the way there
+
+    const uint8_t* p = (const uint8_t*)payload;
+    bool acked = rx.receive(address, channel, p, len);
+    acked = oldRx.receive(address, channel, p, len) || acked;
+
+    if (lossPercent && rng() % 100 < lossPercent) return false;    // ACK lost on the way back
+    return acked;
+}
+
+static void check(bool ok, const char* what) {
+    printf("  %-62s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static void runFor(uint32_t ms) {
+    uint64_t until = NativeHal::nowMicros() + (uint64_t)ms * 1000;
+    while (NativeHal::nowMicros() < until) {
+        loop();
+        NativeHal::advanceMicros(LOOP_US);
+    }
+}
+
+// Runs until the bind procedure is over, returns how long it took
+static uint32_t runBind(uint32_t limitMs) {
+    uint64_t start = NativeHal::nowMicros();
+    while (Bind::active() && NativeHal::nowMicros() - start < (uint64_t)limitMs * 1000) {
+        loop();
+        NativeHal::advanceMicros(LOOP_US);
+    }
+    return (uint32_t)((NativeHal::nowMicros() - start) / 1000);
+}
+
+static bool sameLink(const Bind::Binding& a, const uint8_t address[5], uint8_t hopSeed) {
+    return memcmp(a.address, address, Bind::ADDRESS_SIZE) == 0 && a.hopSeed == hopSeed;
+}
+
+static bool goodByte(uint8_t b) {
+    return b != 0x00 && b != 0xFF && b != 0x55 && b != 0xAA;
+}
+
+int run(bool verbose) {
+    failures = 0;
+    rx = Receiver();
+    oldRx = Receiver();
+    NativeHal::onRadioAir(onAir);
+
+    // NRF24 output, never bound (an --eeprom image may have been)
+    settings.rfOutput = RF_OUTPUT_NRF24;
+    memset(settings.rfAddress, 0, sizeof(settings.rfAddress));
+    radioSetLink(settings.rfAddress, settings.hopSeed);
+    applyRfOutput();
+
+    // --- 1. address derivation ---
+    printf("derivation:\n");
+    uint32_t uid[3];
+    Bind::readUid(uid);
+    Bind::Binding mine, again;
+    Bind::derive(uid, mine);
+    Bind::derive(uid, again);
+
+    std::set<uint64_t> seen;
+    uint32_t badBytes = 0, badChannels = 0, reserved = 0, derived = 0;
+    for (uint32_t i = 0; i < 20000; i++) {
+        // half of them like chips from one wafer (neighbours differ in a few bits), half random
+        uint32_t u[3] = { uid[0] + (i & 0xFF), uid[1] ^ (i >> 8), uid[2] };
+        if (i & 1) { u[0] = rng(); u[1] = rng(); u[2] = rng(); }
+        Bind::Binding b;
+        Bind::derive(u, b);
+        for (uint8_t k = 0; k < Bind::ADDRESS_SIZE; k++) badBytes += !goodByte(b.address[k]);
+        uint8_t ch = Bind::channelOf(b.hopSeed);
+        badChannels += (ch < Bind::HOP_FIRST || ch >= Bind::HOP_FIRST + Bind::HOP_CHANNELS);
+        uint64_t a = Bind::pipeAddress(b.address);
+        reserved += (a == Bind::LEGACY_ADDRESS || a == Bind::BIND_ADDRESS);
+        seen.insert(a);
+        derived++;
+    }
+    if (verbose) {
+        printf("  (this transmitter: %010llx, channel %u; %u UIDs, %zu different addresses)\n",
+               (unsigned long long)Bind::pipeAddress(mine.address), Bind::channelOf(mine.hopSeed),
+               derived, seen.size());
+    }
+    check(sameLink(mine, again.address, again.hopSeed), "same UID, same address and hop seed");
+    check(badBytes == 0 && reserved == 0, "no 00/FF/55/AA address bytes, never a shared address");
+    check(badChannels == 0, "channels inside the hop range");
+    check(seen.size() == derived, "every UID its own address");
+
+    // --- 2. not bound: the legacy link, as before ---
+    printf("unbound:\n");
+    runFor(100);
+    check(!Bind::isBound(settings.rfAddress), "a fresh model is not bound");
+    check(rx.dataPackets > 0 && oldRx.dataPackets > 0, "both receivers hear it on the legacy address");
+
+    // --- 3. nobody in bind mode: gives up, nothing changes ---
+    printf("no receiver:\n");
+    bindStart();
+    check(Bind::active(), "bind started from the menu path");
+    uint32_t tookMs = runBind(Bind::TIMEOUT_MS + 1000);
+    uint32_t before = rx.dataPackets;
+    runFor(100);
+    if (verbose) printf("  (gave up after %u ms)\n", tookMs);
+    check(!Bind::active() && tookMs >= Bind::TIMEOUT_MS, "gives up after the timeout");
+    check(!Bind::isBound(settings.rfAddress), "model still unbound");
+    check(rx.dataPackets > before, "channels back on the legacy link");
+    check(dataWhileBinding == 0, "no channel packets while binding");
+
+    // --- 4. bind with 20% of the packets and ACKs lost, and the first good ACK lost ---
+    printf("bind:\n");
+    rx.bindMode = true;
+    rx.dropFirstAck = true;
+    lossPercent = 20;
+    bindStart();
+    tookMs = runBind(Bind::TIMEOUT_MS + 1000);
+    lossPercent = 0;
+    if (verbose) {
+        printf("  (took %u ms, receiver saw %u announces and %u confirms)\n", tookMs, rx.announces, rx.confirms);
+    }
+    check(!Bind::active() && tookMs < Bind::TIMEOUT_MS, "handshake completes");
+    check(sameLink(mine, settings.rfAddress, settings.hopSeed), "model stores the address of this transmitter");
+    check(sameLink(rx.link, settings.rfAddress, settings.hopSeed), "receiver has the same address and hop seed");
+    check(rx.confirms > 0, "the receiver ACKed on the new link");
+
+    RadioSettings stored;
+    check(settingsLoad(stored) == SETTINGS_LOADED && sameLink(mine, stored.rfAddress, stored.hopSeed),
+          "saved to flash");
+
+    before = rx.dataPackets;
+    uint32_t oldBefore = oldRx.dataPackets;
+    runFor(200);
+    check(rx.dataPackets >= 90, "channels on the new link");
+    check(oldRx.dataPackets == oldBefore, "the legacy receiver doesn't hear the model anymore");
+    check(dataWhileBinding == 0, "no channel packets while binding");
+
+    // Another transmitter, same firmware: a different address, the bound receiver doesn't take it
+    Bind::Binding other;
+    uint32_t otherUid[3] = { uid[0] + 1, uid[1], uid[2] };
+    Bind::derive(otherUid, other);
+    uint8_t packet[sizeof(data_t)] = { 0 };
+    Receiver probe = rx;
+    bool heard = probe.receive(Bind::pipeAddress(other.address), Bind::channelOf(other.hopSeed),
+                               packet, sizeof(packet));
+    check(!heard, "the next transmitter's packets are not taken");
+
+    // --- 5. power cycle: loaded from flash, straight on the bound link ---
+    printf("power cycle:\n");
+    NativeHal::reset();
+    NativeHal::onRadioAir(onAir);
+    NativeHal::setAnalog(PA4, 2378);
+    setup();
+    before = rx.dataPackets;
+    oldBefore = oldRx.dataPackets;
+    runFor(200);
+    check(rx.dataPackets >= 90 && oldRx.dataPackets == oldBefore, "still on its own link");
+
+    printf("\n%s (%d failed)\n", failures ? "FAIL" : "OK", failures);
+    return failures;
+}
+
+} // namespace BindLoopback
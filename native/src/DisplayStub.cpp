@@ -0,0 +1,60 @@
+/**
+ * @file DisplayStub.cpp
+ * @author Ebrahim Siami
+ * @brief DisplayManager replacement for the native build
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * DisplayManager.cpp is all Adafruit_GFX drawing, so natively it is swapped
+ * for this file. The blocking parts (splash, "Saving..." screen) keep their
+ * delays and beeps, so the timing of setup() and the menus matches the board.
+ */
+
+#include "DisplayManager.h"
+#include "buzzer.h"
+
+Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+
+void setupDisplay() {
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    display.display();
+    delay(2000);
+}
+
+void showSplashScreen(const char* productName, const unsigned long durationMs) {
+    (void)productName;
+    display.display();
+    delay(durationMs);
+}
+
+void showSavingFeedback() {
+    display.display();
+    playBeepEvent(EVT_CONFIRM);
+    delay(300);
+}
+
+void drawCurrentPage(
+    DisplayState currentPage,
+    int trimsMenuIndex,
+    int settingsMenuIndex,
+    int featuresMenuIndex,
+    const RadioSettings& settings,
+    uint16_t throttle, uint16_t pitch, uint16_t roll, uint16_t yaw,
+    byte aux1, byte aux2, bool aux3, bool aux4,
+    float voltage,
+    int timerSelection,
+    bool timerIsArmed,
+    bool timerIsRunning,
+    long timerValue,
+    bool isTimeEditMode,
+    int invertMenuIndex,
+    int drMenuIndex,
+    int advChannelSelectIndex,
+    int advConfigMenuIndex,
+    int currentEditingChannel,
+    bool isAdvEditMode,
+    int expoMenuIndex,
+    bool isExpoEditMode)
+{
+    display.display();
+}
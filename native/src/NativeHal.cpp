@@ -0,0 +1,300 @@
+/**
+ * @file NativeHal.cpp
+ * @author Ebrahim Siami
+ * @brief Simulated Blue Pill for the native build
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Implements the Arduino shim (time, GPIO, ADC, Serial, UART, UID), the RF24 shim and
+ * the EEPROM object, plus the NativeHal interface used to drive them.
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+#include <RF24.h>
+#include <FlashStorage_STM32.hpp>
+#include <stdio.h>
+#include "NativeHal.h"
+
+// =============================================================================
+// --- State ---
+// =============================================================================
+
+NativeSerial Serial;
+SPIClass SPI;
+TwoWire Wire;
+EEPROMClass EEPROM;
+
+static uint64_t clockUs = 0;
+static uint16_t analogIn[NATIVE_PIN_COUNT];
+static bool digitalIn[NATIVE_PIN_COUNT];
+static bool digitalOut[NATIVE_PIN_COUNT];
+
+static std::vector<uint8_t> serialOut;
+static std::vector<uint8_t> serialIn;
+static size_t serialReadPos = 0;
+
+static std::vector<uint8_t> uartOut;
+static uint32_t uartBaudRate = 0;
+
+static NativeHal::TimingModel timing;
+static uint32_t spentNs = 0;      // below one microsecond, not on the clock yet
+
+static NativeHal::RadioStats radio;
+static NativeHal::RadioWriteHook radioHook = nullptr;
+static NativeHal::RadioAirHook airHook = nullptr;
+static NativeHal::RadioCarrierHook carrierHook = nullptr;
+
+static uint32_t uid[3] = { 0x0669FF48, 0x51775078, 0x87142540 };   // from a Blue Pill
+
+// Moves the clock by the simulated duration of a hardware call
+static void spend(uint32_t ns) {
+    spentNs += ns;
+    clockUs += spentNs / 1000;
+    spentNs %= 1000;
+}
+
+// =============================================================================
+// --- Arduino API ---
+// =============================================================================
+
+void pinMode(uint32_t pin, uint32_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint32_t pin, uint32_t value) {
+    if (pin < NATIVE_PIN_COUNT) digitalOut[pin] = (value != LOW);
+}
+
+int digitalRead(uint32_t pin) {
+    return (pin < NATIVE_PIN_COUNT && digitalIn[pin]) ? HIGH : LOW;
+}
+
+int analogRead(uint32_t pin) {
+    spend(timing.analogReadNs);
+    return (pin < NATIVE_PIN_COUNT) ? analogIn[pin] : 0;
+}
+
+void analogReadResolution(int bits) {
+    (void)bits;   // always 12 bit, like the F103 ADC
+}
+
+uint32_t millis() { return (uint32_t)(clockUs / 1000); }
+uint32_t micros() { return (uint32_t)clockUs; }
+
+// Blocking waits just move the clock, nothing else runs meanwhile (same as on the board)
+void delay(uint32_t ms) { clockUs += (uint64_t)ms * 1000; }
+void delayMicroseconds(uint32_t us) { clockUs += us; }
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+size_t NativeSerial::write(const uint8_t* data, size_t len) {
+    spend(timing.serialCallNs + timing.serialByteNs * (uint32_t)len);
+    serialOut.insert(serialOut.end(), data, data + len);
+    return len;
+}
+
+int NativeSerial::available() {
+    return (int)(serialIn.size() - serialReadPos);
+}
+
+int NativeSerial::read() {
+    if (serialReadPos >= serialIn.size()) return -1;
+    int b = serialIn[serialReadPos++];
+    if (serialReadPos == serialIn.size()) {
+        serialIn.clear();
+        serialReadPos = 0;
+    }
+    return b;
+}
+
+size_t NativeSerial::readBytes(uint8_t* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length && available() > 0) buffer[n++] = (uint8_t)read();
+    return n;
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    uartBaudRate = (uint32_t)baud;
+}
+
+void HardwareSerial::end() {
+    uartBaudRate = 0;
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t len) {
+    if (uartBaudRate == 0) return 0;
+    uartOut.insert(uartOut.end(), data, data + len);
+    return len;
+}
+
+// =============================================================================
+// --- RF24 ---
+// =============================================================================
+
+bool RF24::begin() {
+    radio.powered = true;
+    return true;
+}
+
+void RF24::setChannel(uint8_t channel) {
+    _channel = channel;
+    _tunedUs = clockUs;
+}
+
+void RF24::startListening() {
+    _listening = true;
+    _tunedUs = clockUs;
+}
+
+bool RF24::testRPD() {
+    if (!radio.powered || !_listening || clockUs - _tunedUs < 170) return false;
+    return carrierHook && carrierHook(_channel, clockUs);
+}
+
+void RF24::powerUp() { radio.powered = true; }
+void RF24::powerDown() { radio.powered = false; }
+
+bool RF24::write(const void* buf, uint8_t len, bool multicast) {
+    if (!radio.powered || _listening || len > 32) return false;   // nothing goes out in RX
+    if (multicast && !_dynamicAck) return false;   // W_TX_PAYLOAD_NO_ACK is ignored, nothing sent
+    radio.packets++;
+    radio.bytes += len;
+    if (radioHook) radioHook(buf, len, clockUs);
+    bool acked = airHook && airHook(_address, _channel, buf, len);
+    spend(timing.radioWriteNs);
+    return (_autoAck && !multicast) ? acked : true;
+}
+
+void RF24::startFastWrite(const void* buf, uint8_t len, bool multicast, bool startTx) {
+    (void)startTx;
+    if (!radio.powered || _listening || len > 32) return;
+    if (multicast && !_dynamicAck) return;
+    radio.packets++;
+    radio.bytes += len;
+    if (radioHook) radioHook(buf, len, clockUs);
+    bool acked = airHook && airHook(_address, _channel, buf, len);
+    spend(timing.radioUploadNs);
+
+    bool wantsAck = _autoAck && !multicast;
+    _txDs = !wantsAck || acked;
+    _maxRt = !_txDs;
+}
+
+void RF24::whatHappened(bool& txOk, bool& txFail, bool& rxReady) {
+    txOk = _txDs;
+    txFail = _maxRt;
+    rxReady = false;
+    _txDs = _maxRt = false;
+}
+
+// =============================================================================
+// --- STM32 HAL ---
+// =============================================================================
+
+uint32_t HAL_GetUIDw0() { return uid[0]; }
+uint32_t HAL_GetUIDw1() { return uid[1]; }
+uint32_t HAL_GetUIDw2() { return uid[2]; }
+
+// =============================================================================
+// --- Host side ---
+// =============================================================================
+
+namespace NativeHal {
+
+void reset() {
+    clockUs = 0;
+    spentNs = 0;
+    for (int i = 0; i < NATIVE_PIN_COUNT; i++) {
+        analogIn[i] = 2048;
+        digitalIn[i] = true;
+        digitalOut[i] = false;
+    }
+    serialOut.clear();
+    serialIn.clear();
+    serialReadPos = 0;
+    uartOut.clear();
+    uartBaudRate = 0;
+    radio = RadioStats();
+    radioHook = nullptr;
+    airHook = nullptr;
+    carrierHook = nullptr;
+}
+
+TimingModel bluePillTiming() {
+    TimingModel m;
+    m.analogReadNs = 12000;     // STM32duino sets the ADC channel up on every call
+    m.radioWriteNs = 660000;    // SPI + 130 us PLL settling + ~16 bytes at 250 kbps
+    m.radioUploadNs = 6000;     // status exchange + starting the DMA, the 33 bytes and the air go on without the CPU
+    m.serialCallNs = 8000;      // USB CDC transmit queue
+    m.serialByteNs = 50;
+    return m;
+}
+
+void setTimingModel(const TimingModel& model) {
+    timing = model;
+}
+
+uint64_t nowMicros() { return clockUs; }
+void advanceMicros(uint32_t us) { clockUs += us; }
+
+void setAnalog(uint8_t pin, uint16_t value) {
+    if (pin < NATIVE_PIN_COUNT) analogIn[pin] = value & 0x0FFF;
+}
+
+void setDigital(uint8_t pin, bool level) {
+    if (pin < NATIVE_PIN_COUNT) digitalIn[pin] = level;
+}
+
+bool digitalOutput(uint8_t pin) {
+    return pin < NATIVE_PIN_COUNT && digitalOut[pin];
+}
+
+std::vector<uint8_t>& serialTx() { return serialOut; }
+
+void serialInject(const uint8_t* data, size_t len) {
+    serialIn.insert(serialIn.end(), data, data + len);
+}
+
+std::vector<uint8_t>& uartTx() { return uartOut; }
+uint32_t uartBaud() { return uartBaudRate; }
+
+const RadioStats& radioStats() { return radio; }
+void onRadioWrite(RadioWriteHook hook) { radioHook = hook; }
+void onRadioAir(RadioAirHook hook) { airHook = hook; }
+void onRadioCarrier(RadioCarrierHook hook) { carrierHook = hook; }
+
+void setUid(uint32_t w0, uint32_t w1, uint32_t w2) {
+    uid[0] = w0;
+    uid[1] = w1;
+    uid[2] = w2;
+}
+
+bool eepromLoad(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    size_t n = fread(EEPROM.data(), 1, EEPROM.length(), f);
+    fclose(f);
+    return n == EEPROM.length();
+}
+
+bool eepromSave(const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    size_t n = fwrite(EEPROM.data(), 1, EEPROM.length(), f);
+    fclose(f);
+    return n == EEPROM.length();
+}
+
+uint32_t eepromCommits() { return EEPROM.commits(); }
+
+} // namespace NativeHal
+
+// Power-on state before setup() runs, so a bare setup()/loop() behaves like the board
+static struct PowerOn {
+    PowerOn() { NativeHal::reset(); }
+} powerOn;
@@ -0,0 +1,196 @@
+/**
+ * @file PowerLoopback.cpp
+ * @author Ebrahim Siami
+ * @brief Adaptive TX power against a simulated receiver at a distance (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "PowerLoopback.h"
+#include <stdio.h>
+#include <math.h>
+#include <random>
+#include "NativeHal.h"
+#include "PowerControl.h"
+#include "Radio.h"
+#include "Settings.h"
+
+void loop();
+
+// Firmware state we look at from the outside (main.cpp)
+extern RadioSettings settings;
+void applyRfOutput();
+
+namespace PowerLoopback {
+
+static const uint32_t LOOP_US = 100;
+
+// Chip output per PA level (RF24_PA_MIN..MAX), the margin of a scenario is the one at MAX
+static const double PA_DBM[4] = { -18, -12, -6, 0 };
+
+static std::mt19937 rng(4848);
+static std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+static bool   receiverAcks = true;
+static double marginAtMaxDb = 40;
+
+// Packets of the running scenario, and what a fixed MAX would have lost on the same path
+static uint64_t sent = 0;
+static uint64_t received = 0;
+static double   lostAtMax = 0;
+static uint32_t levelMs[4];
+
+static int failures = 0;
+
+static double lossAt(double marginDb) {
+    return 1.0 / (1.0 + exp(0.8 * marginDb));
+}
+
+static bool onAir(uint64_t address, uint8_t channel, const void* payload, uint8_t len) {
+    (void)address; (void)channel; (void)payload;
+    if (len < sizeof(data_t)) return false;
+
+    double loss = lossAt(marginAtMaxDb + PA_DBM[radio.getPALevel()]);
+    sent++;
+    lostAtMax += lossAt(marginAtMaxDb);
+    if (uniform(rng) < loss) return false;      // lost on the way there
+    received++;
+
+    if (!receiverAcks) return false;
+    return uniform(rng) >= loss;                // the ACK on the way back
+}
+
+static void check(bool ok, const char* what) {
+    printf("  %-62s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static void startScenario() {
+    sent = 0;
+    received = 0;
+    lostAtMax = 0;
+    memset(levelMs, 0, sizeof(levelMs));
+}
+
+static double lossPercent() {
+    return sent ? 100.0 * (sent - received) / sent : 0;
+}
+
+static double lossAtMaxPercent() {
+    return sent ? 100.0 * lostAtMax / sent : 0;
+}
+
+// Runs the firmware, marginFromDb -> marginToDb over the time. Returns the time
+// until stop() was true first (or ms if never).
+template <typename F>
+static uint32_t runFor(uint32_t ms, double marginFromDb, double marginToDb, F stop) {
+    uint64_t start = NativeHal::nowMicros();
+    uint64_t until = start + (uint64_t)ms * 1000;
+    uint32_t stoppedMs = ms;
+    uint64_t lastMs = start / 1000;
+
+    while (NativeHal::nowMicros() < until) {
+        double f = (double)(NativeHal::nowMicros() - start) / ((uint64_t)ms * 1000);
+        marginAtMaxDb = marginFromDb + (marginToDb - marginFromDb) * f;
+        loop();
+        NativeHal::advanceMicros(LOOP_US);
+
+        uint64_t nowMs = NativeHal::nowMicros() / 1000;
+        if (nowMs != lastMs) {
+            levelMs[radio.getPALevel()] += (uint32_t)(nowMs - lastMs);
+            lastMs = nowMs;
+        }
+        if (stoppedMs == ms && stop()) stoppedMs = (uint32_t)((NativeHal::nowMicros() - start) / 1000);
+    }
+    return stoppedMs;
+}
+
+static uint32_t runFor(uint32_t ms, double marginDb) {
+    return runFor(ms, marginDb, marginDb, [] { return false; });
+}
+
+static void report(bool verbose) {
+    if (!verbose) return;
+    printf("    (%llu packets, %.3f %% lost, fixed MAX %.3f %%; MIN/LOW/HIGH/MAX %u/%u/%u/%u ms; %u changes)\n",
+           (unsigned long long)sent, lossPercent(), lossAtMaxPercent(),
+           levelMs[0], levelMs[1], levelMs[2], levelMs[3], PowerControl::levelChanges());
+}
+
+int run(bool verbose) {
+    failures = 0;
+    NativeHal::onRadioAir(onAir);
+
+    settings.rfOutput = RF_OUTPUT_NRF24;
+    settings.rfAdaptivePower = true;
+    applyRfOutput();
+
+    // --- 1. receiver with auto-ack off: nothing to go by ---
+    printf("receiver without ACKs:\n");
+    receiverAcks = false;
+    startScenario();
+    runFor(5000, 40);
+    report(verbose);
+    check(radio.getPALevel() == RF24_PA_MAX && levelMs[RF24_PA_MAX] >= 4990, "PA stays at MAX");
+    check(!PowerControl::receiverAcks(), "shown as not ACKing");
+    check(sent >= 2490 && received == sent, "every channel packet still goes out");
+
+    // --- 2. on the bench / close range ---
+    printf("close range:\n");
+    receiverAcks = true;
+    settings.rfAdaptivePower = false;      // start over
+    applyRfOutput();
+    settings.rfAdaptivePower = true;
+    applyRfOutput();
+    startScenario();
+    uint32_t toMinMs = runFor(15000, 40, 40, [] { return radio.getPALevel() == RF24_PA_MIN; });
+    report(verbose);
+    if (verbose) printf("    (MIN after %u ms, est. %u mA saved, +%u %% runtime)\n", toMinMs,
+                        PowerControl::savedMilliAmps(), PowerControl::runtimeGainPercent());
+    check(toMinMs < 10000, "down to MIN within 10 s");
+    check(received == sent, "no packets lost on the way down");
+    check(PowerControl::savedMilliAmps() > 0 && PowerControl::runtimeGainPercent() > 0, "battery estimate shows a saving");
+
+    // --- 3. sudden fade at MIN: 22 dB margin -> 2 dB ---
+    printf("sudden fade:\n");
+    startScenario();
+    uint32_t upMs = runFor(2000, 20, 20, [] { return radio.getPALevel() > RF24_PA_MIN; });
+    report(verbose);
+    if (verbose) printf("    (off MIN after %u ms)\n", upMs);
+    check(upMs <= 300, "up to a working level within 300 ms");
+    check(lossPercent() < 2.0, "under 2 % of the packets lost in the fade");
+
+    // --- 4. walking away: 20 dB at MAX -> 6 dB over 40 s ---
+    printf("walking away:\n");
+    startScenario();
+    runFor(40000, 20, 6, [] { return false; });
+    report(verbose);
+    check(radio.getPALevel() == RF24_PA_MAX, "at MAX at the far end");
+    check(lossPercent() < lossAtMaxPercent() + 1.0, "at most 1 % more lost than with a fixed MAX");
+
+    // --- 5. two minutes where HIGH is just not enough (4 dB) and MAX is (10 dB) ---
+    printf("on the edge:\n");
+    startScenario();
+    uint32_t changesBefore = PowerControl::levelChanges();
+    runFor(120000, 10);
+    uint32_t changes = PowerControl::levelChanges() - changesBefore;
+    report(verbose);
+    check(changes <= 12, "12 level changes at most in 2 minutes");
+    check(levelMs[RF24_PA_MAX] >= 100000, "mostly at MAX");
+    check(lossPercent() < lossAtMaxPercent() + 0.5, "at most 0.5 % more lost than with a fixed MAX");
+
+    // --- 6. switched off from the menu ---
+    printf("off:\n");
+    runFor(PowerControl::HOLD_MAX_MS + 10000, 40);   // back down first, after the longest hold
+    uint8_t wasLevel = radio.getPALevel();
+    settings.rfAdaptivePower = false;
+    applyRfOutput();
+    check(wasLevel < RF24_PA_MAX && radio.getPALevel() == RF24_PA_MAX, "back to MAX at once");
+    startScenario();
+    runFor(1000, 40);
+    check(!PowerControl::probeDue() && radio.getPALevel() == RF24_PA_MAX, "no more probes, stays at MAX");
+
+    printf("\n%s (%d failed)\n", failures ? "FAIL" : "OK", failures);
+    return failures;
+}
+
+} // namespace PowerLoopback
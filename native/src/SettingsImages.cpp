@@ -0,0 +1,435 @@
+/**
+ * @file SettingsImages.cpp
+ * @author Ebrahim Siami
+ * @brief Settings images of every schema version through the decoder (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "SettingsImages.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "SettingsStore.h"
+#include "Crc.h"
+#include "CrsfOutput.h"
+#include <FlashStorage_STM32.hpp>
+
+namespace SettingsImages {
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    printf("  %-62s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+// =============================================================================
+// --- What the images hold ---
+// =============================================================================
+
+// Values of the oldest layout, nothing in them is a default
+static const int TRIM[3]          = { 2100, 1990, 2085 };
+static const int CALIB_MIN[4]     = { 110, 120, 130, 140 };
+static const int CALIB_CENTER[4]  = { 2000, 2010, 2020, 2030 };
+static const int CALIB_MAX[4]     = { 3900, 3910, 3920, 3930 };
+static const int EPA_MIN[4]       = { 200, 300, 400, 500 };
+static const int SUB_TRIM[4]      = { 2040, 2050, 2060, 2070 };
+static const int EPA_MAX[4]       = { 3800, 3700, 3600, 3500 };
+static const int EXPO[3]          = { 25, -30, 40 };
+static const uint8_t INVERT_MASK  = 0xA5;
+static const uint8_t RATE[3]      = { 70, 80, 90 };
+static const uint8_t MIX_MODE     = MIX_PRESET_VTAIL_A;
+
+// Added later: v4 mix line, v5 throttle curve, v6 flight mode 1, v7 logical switch,
+// v8 CRSF, v9 bind result, v10 redundancy and (flag only) adaptive power
+static const MixLine LINE         = { MIX_SRC_THROTTLE, MIX_CH_ROLL, 50, -10, MIX_CURVE_ABS, MIX_SW_AUX3_ON };
+static const int8_t  CURVE_Y[5]   = { -60, -20, 20, 60, 100 };
+static const uint16_t FADE_MS     = 500;
+static const int     FM_TRIM[3]   = { 2000, 2100, 2200 };
+static const int     FM_EXPO[3]   = { 10, 20, 30 };
+static const uint8_t FM_RATE[3]   = { 50, 60, 70 };
+static const LogicalSwitch LS     = { LS_FUNC_GT, MIX_SRC_AUX1, 0, 40 };
+static const uint8_t CUT_SWITCH   = LS_REF_L1;
+static const uint8_t TIMER_SWITCH = LS_REF_AUX4 | LS_REF_NOT;
+static const uint8_t FM_SWITCH[2] = { LS_REF_L1 + 1, LS_REF_AUX3 };
+static const uint16_t CRSF_HZ     = 333;
+static const uint8_t ADDRESS[5]   = { 0x12, 0x34, 0x56, 0x78, 0x9A };
+static const uint8_t HOP_SEED     = 17;
+static const uint8_t REDUNDANCY   = 2;
+
+// Bool members of v1/v2, as StoredSettings::flags from v3 on
+static const bool BUZZER = false, LIGHT = true, AIRPLANE = true, DUAL_RATE = true;
+
+// =============================================================================
+// --- Writing the images ---
+// =============================================================================
+
+struct Image {
+    std::vector<uint8_t> bytes;
+
+    void u8(uint8_t v) { bytes.push_back(v); }
+    void u16(uint16_t v) { u8((uint8_t)v); u8((uint8_t)(v >> 8)); }
+    void u32(uint32_t v) { u16((uint16_t)v); u16((uint16_t)(v >> 16)); }
+    void pad(size_t to) { while (bytes.size() < to) u8(0); }
+};
+
+// v1 / v2: RadioSettings of that time with its natural alignment (int = 4 bytes)
+static void writeRadioSettings(Image& img) {
+    for (int i = 0; i < 3; i++) img.u32((uint32_t)TRIM[i]);
+    for (int i = 0; i < 4; i++) img.u32((uint32_t)CALIB_MIN[i]);
+    for (int i = 0; i < 4; i++) img.u32((uint32_t)CALIB_CENTER[i]);
+    for (int i = 0; i < 4; i++) img.u32((uint32_t)CALIB_MAX[i]);
+    for (int i = 0; i < 4; i++) img.u32((uint32_t)EPA_MIN[i]);
+    for (int i = 0; i < 4; i++) img.u32((uint32_t)SUB_TRIM[i]);
+    for (int i = 0; i < 4; i++) img.u32((uint32_t)EPA_MAX[i]);
+    for (int i = 0; i < 3; i++) img.u32((uint32_t)EXPO[i]);
+    img.u8(BUZZER);
+    img.u8(LIGHT);
+    for (int i = 0; i < 8; i++) img.u8((INVERT_MASK >> i) & 1);
+    img.u8(AIRPLANE);
+    img.u8(DUAL_RATE);
+    for (int i = 0; i < 3; i++) img.u8(RATE[i]);
+    img.u8(MIX_MODE);
+}
+
+static Image imageV1() {
+    Image img;
+    img.u32(SETTINGS_LEGACY_MAGIC);
+    writeRadioSettings(img);
+    uint8_t sum = 0;
+    for (uint8_t b : img.bytes) sum ^= b;
+    img.u8(sum);
+    img.pad(144);
+    return img;
+}
+
+// Packed payload of v3 .. v10, every version appends to the one before
+static Image payload(uint16_t version) {
+    Image img;
+    if (version == 2) {
+        writeRadioSettings(img);
+        img.pad(136);
+        return img;
+    }
+
+    // --- v3: 64 bytes ---
+    for (int i = 0; i < 3; i++) img.u16((uint16_t)TRIM[i]);
+    for (int i = 0; i < 4; i++) img.u16((uint16_t)CALIB_MIN[i]);
+    for (int i = 0; i < 4; i++) img.u16((uint16_t)CALIB_CENTER[i]);
+    for (int i = 0; i < 4; i++) img.u16((uint16_t)CALIB_MAX[i]);
+    for (int i = 0; i < 4; i++) img.u16((uint16_t)EPA_MIN[i]);
+    for (int i = 0; i < 4; i++) img.u16((uint16_t)SUB_TRIM[i]);
+    for (int i = 0; i < 4; i++) img.u16((uint16_t)EPA_MAX[i]);
+    for (int i = 0; i < 3; i++) img.u8((uint8_t)EXPO[i]);
+    uint8_t flags = (BUZZER ? 1 : 0) | (LIGHT ? 2 : 0) | (AIRPLANE ? 4 : 0) | (DUAL_RATE ? 8 : 0);
+    if (version >= 6) flags |= 16;          // flight modes on
+    if (version >= 10) flags |= 32;         // adaptive power
+    img.u8(flags);
+    img.u8(INVERT_MASK);
+    for (int i = 0; i < 3; i++) img.u8(RATE[i]);
+    img.u8(MIX_MODE);
+    img.u8(0);
+    if (version == 3) return img;
+
+    // --- v4: 16 mix lines of 4 bytes, the first one used ---
+    img.u8((uint8_t)(LINE.source | LINE.destination << 4));
+    img.u8((uint8_t)LINE.weight);
+    img.u8((uint8_t)LINE.offset);
+    img.u8((uint8_t)(LINE.curve | LINE.sw << 4));
+    img.pad(128);
+    if (version == 4) return img;
+
+    // --- v5: point counts, then 17 points per curve; only throttle has one ---
+    for (int c = 0; c < 4; c++) img.u8(c == 2 ? 5 : 0);
+    for (int c = 0; c < 4; c++) {
+        for (int p = 0; p < 17; p++) img.u8(c == 2 && p < 5 ? (uint8_t)CURVE_Y[p] : 0);
+    }
+    if (version == 5) return img;
+
+    // --- v6: fade, modes 1-3 (13 bytes each), reserved ---
+    img.u16(FADE_MS);
+    for (int m = 0; m < 3; m++) {
+        for (int a = 0; a < 3; a++) img.u16((uint16_t)(m == 0 ? FM_TRIM[a] : 2048));
+        for (int a = 0; a < 3; a++) img.u8((uint8_t)(m == 0 ? FM_EXPO[a] : 0));
+        for (int a = 0; a < 3; a++) img.u8(m == 0 ? FM_RATE[a] : 100);
+        img.u8(m == 0 ? (uint8_t)MIX_PRESET_DELTA_A : (uint8_t)FLIGHT_MODE_MIX_BASE);
+    }
+    img.u8(0);
+    if (version == 6) return img;
+
+    // --- v7: 16 logical switches of 5 bytes, the first one used, then the four references ---
+    img.u8(LS.func);
+    img.u8(LS.a);
+    img.u8(LS.b);
+    img.u16((uint16_t)LS.value);
+    img.pad(242 + 80);
+    img.u8(CUT_SWITCH);
+    img.u8(TIMER_SWITCH);
+    img.u8(FM_SWITCH[0]);
+    img.u8(FM_SWITCH[1]);
+    if (version == 7) return img;
+
+    // --- v8: RF output ---
+    img.u8(RF_OUTPUT_CRSF);
+    img.u8(0);
+    img.u16(CRSF_HZ);
+    if (version == 8) return img;
+
+    // --- v9: bind result ---
+    for (int i = 0; i < 5; i++) img.u8(ADDRESS[i]);
+    img.u8(HOP_SEED);
+    if (version == 9) return img;
+
+    // --- v10: redundancy ---
+    img.u8(REDUNDANCY);
+    img.u8(0);
+    return img;
+}
+
+// Header in front: [magic][version][length][crc16 of version, length, payload][reserved]
+static Image withHeader(uint16_t version, const Image& body, uint16_t length) {
+    Image crcInput;
+    crcInput.u16(version);
+    crcInput.u16(length);
+    uint16_t crc = Crc::crc16(crcInput.bytes.data(), crcInput.bytes.size());
+    crc = Crc::crc16(body.bytes.data(), body.bytes.size() < length ? body.bytes.size() : length, crc);
+
+    Image img;
+    img.u32(SETTINGS_HEADER_MAGIC);
+    img.u16(version);
+    img.u16(length);
+    img.u16(crc);
+    img.u16(0);
+    img.bytes.insert(img.bytes.end(), body.bytes.begin(), body.bytes.end());
+    return img;
+}
+
+static Image imageOf(uint16_t version) {
+    if (version == 1) return imageV1();
+    Image body = payload(version);
+    return withHeader(version, body, (uint16_t)body.bytes.size());
+}
+
+// =============================================================================
+// --- What should come out ---
+// =============================================================================
+
+// Defaults, with everything the image of that version holds on top
+static void expected(uint16_t version, RadioSettings& s) {
+    settingsSetDefaults(s);
+
+    s.trim1 = TRIM[0]; s.trim2 = TRIM[1]; s.trim3 = TRIM[2];
+    for (int i = 0; i < 4; i++) {
+        s.calibMin[i] = CALIB_MIN[i];
+        s.calibCenter[i] = CALIB_CENTER[i];
+        s.calibMax[i] = CALIB_MAX[i];
+        s.epaMin[i] = EPA_MIN[i];
+        s.subTrim[i] = SUB_TRIM[i];
+        s.epaMax[i] = EPA_MAX[i];
+    }
+    s.expoRoll = EXPO[0]; s.expoPitch = EXPO[1]; s.expoYaw = EXPO[2];
+    s.buzzerEnabled = BUZZER;
+    s.lightModeEnabled = LIGHT;
+    for (int i = 0; i < 8; i++) s.channelInverted[i] = (INVERT_MASK >> i) & 1;
+    s.airplaneMode = AIRPLANE;
+    s.dualRateEnabled = DUAL_RATE;
+    s.dualRateRoll = RATE[0]; s.dualRatePitch = RATE[1]; s.dualRateYaw = RATE[2];
+    s.mixMode = MIX_MODE;
+
+    // Before v4 the mixer is the preset of mixMode
+    if (version < 4) {
+        mixerApplyPreset(s.mixLines, MIX_MODE);
+    } else {
+        memset(s.mixLines, 0, sizeof(s.mixLines));
+        s.mixLines[0] = LINE;
+    }
+
+    if (version >= 5) {
+        s.stickCurves[2].points = 5;
+        memcpy(s.stickCurves[2].y, CURVE_Y, sizeof(CURVE_Y));
+        curveBuild(s.stickCurves[2]);
+    }
+
+    if (version >= 6) {
+        s.flightModesEnabled = true;
+        s.flightModeFadeMs = FADE_MS;
+        for (int a = 0; a < 3; a++) {
+            s.flightModes[0].trim[a] = FM_TRIM[a];
+            s.flightModes[0].expo[a] = FM_EXPO[a];
+            s.flightModes[0].rate[a] = FM_RATE[a];
+        }
+        s.flightModes[0].mixMode = MIX_PRESET_DELTA_A;
+    }
+
+    if (version >= 7) {
+        s.logicalSwitches[0] = LS;
+        s.throttleCutSwitch = CUT_SWITCH;
+        s.timerSwitch = TIMER_SWITCH;
+        s.flightModeSwitch[0] = FM_SWITCH[0];
+        s.flightModeSwitch[1] = FM_SWITCH[1];
+    }
+
+    if (version >= 8) {
+        s.rfOutput = RF_OUTPUT_CRSF;
+        s.crsfRateHz = CRSF_HZ;
+    }
+
+    if (version >= 9) {
+        memcpy(s.rfAddress, ADDRESS, sizeof(ADDRESS));
+        s.hopSeed = HOP_SEED;
+    }
+
+    if (version >= 10) {
+        s.rfRedundancy = REDUNDANCY;
+        s.rfAdaptivePower = true;
+    }
+}
+
+// Names of the members that differ, empty if none
+static std::string differences(const RadioSettings& a, const RadioSettings& b) {
+    std::string out;
+    auto same = [&](bool equal, const char* name) {
+        if (!equal && out.find(name) == std::string::npos) { out += " "; out += name; }
+    };
+    #define SAME(m) same(memcmp(&a.m, &b.m, sizeof(a.m)) == 0, #m)
+
+    SAME(trim1); SAME(trim2); SAME(trim3);
+    SAME(calibMin); SAME(calibCenter); SAME(calibMax);
+    SAME(epaMin); SAME(subTrim); SAME(epaMax);
+    SAME(expoRoll); SAME(expoPitch); SAME(expoYaw);
+    SAME(buzzerEnabled); SAME(lightModeEnabled); SAME(channelInverted);
+    SAME(airplaneMode); SAME(dualRateEnabled);
+    SAME(dualRateRoll); SAME(dualRatePitch); SAME(dualRateYaw);
+    SAME(mixMode);
+    for (int i = 0; i < MIX_LINES; i++) {
+        const MixLine& x = a.mixLines[i];
+        const MixLine& y = b.mixLines[i];
+        same(x.source == y.source && x.destination == y.destination && x.weight == y.weight &&
+             x.offset == y.offset && x.curve == y.curve && x.sw == y.sw, "mixLines");
+    }
+    for (int i = 0; i < CURVE_CHANNELS; i++) {
+        const CustomCurve& x = a.stickCurves[i];
+        const CustomCurve& y = b.stickCurves[i];
+        same(x.points == y.points && memcmp(x.y, y.y, sizeof(x.y)) == 0 &&
+             memcmp(x.value, y.value, sizeof(x.value)) == 0, "stickCurves");
+    }
+    SAME(flightModesEnabled); SAME(flightModeFadeMs);
+    for (int m = 0; m < FLIGHT_MODES - 1; m++) {
+        const FlightMode& x = a.flightModes[m];
+        const FlightMode& y = b.flightModes[m];
+        same(memcmp(x.trim, y.trim, sizeof(x.trim)) == 0 && memcmp(x.expo, y.expo, sizeof(x.expo)) == 0 &&
+             memcmp(x.rate, y.rate, sizeof(x.rate)) == 0 && x.mixMode == y.mixMode, "flightModes");
+    }
+    for (int i = 0; i < LS_COUNT; i++) {
+        const LogicalSwitch& x = a.logicalSwitches[i];
+        const LogicalSwitch& y = b.logicalSwitches[i];
+        same(x.func == y.func && x.a == y.a && x.b == y.b && x.value == y.value, "logicalSwitches");
+    }
+    SAME(throttleCutSwitch); SAME(timerSwitch); SAME(flightModeSwitch);
+    SAME(rfOutput); SAME(crsfRateHz); SAME(rfRedundancy); SAME(rfAdaptivePower);
+    SAME(rfAddress); SAME(hopSeed);
+
+    #undef SAME
+    return out;
+}
+
+static SettingsLoadResult decode(const Image& img, RadioSettings& out) {
+    return settingsDecodeImage(img.bytes.data(), img.bytes.size(), out);
+}
+
+// A bad image: rejected, and the output not touched
+static bool rejected(const Image& img) {
+    RadioSettings out;
+    memset(&out, 0x5A, sizeof(out));
+    RadioSettings before = out;
+    return decode(img, out) == SETTINGS_DEFAULTED && memcmp(&out, &before, sizeof(out)) == 0;
+}
+
+// =============================================================================
+// --- Test ---
+// =============================================================================
+
+int run(bool verbose) {
+    failures = 0;
+
+    // --- 1. every layout through the decoder ---
+    printf("older layouts:\n");
+    for (uint16_t version = 1; version <= SETTINGS_VERSION; version++) {
+        Image img = imageOf(version);
+        RadioSettings out, want;
+        expected(version, want);
+        SettingsLoadResult result = decode(img, out);
+        std::string diff = differences(out, want);
+
+        SettingsLoadResult wantResult = version < SETTINGS_VERSION ? SETTINGS_MIGRATED : SETTINGS_LOADED;
+        char what[80];
+        snprintf(what, sizeof(what), "v%u (%u bytes): %s, values kept, the rest defaults", version,
+                 (unsigned)img.bytes.size(), version < SETTINGS_VERSION ? "migrated" : "loaded");
+        if (verbose && !diff.empty()) printf("    (differs:%s)\n", diff.c_str());
+        check(result == wantResult && diff.empty(), what);
+    }
+
+    // --- 2. images that must not load ---
+    printf("bad images:\n");
+    Image good = imageOf(SETTINGS_VERSION);
+    const size_t header = sizeof(SettingsHeader);
+
+    Image img = good;
+    img.bytes[header + 7] ^= 0x01;
+    check(rejected(img), "payload bit flipped (CRC)");
+
+    img = good;
+    img.bytes[header - 4] ^= 0x80;
+    check(rejected(img), "CRC field wrong");
+
+    Image body = payload(SETTINGS_VERSION);
+    body.bytes.pop_back();
+    check(rejected(withHeader(SETTINGS_VERSION, body, (uint16_t)body.bytes.size())), "current version, one byte short (CRC right)");
+
+    body = payload(5);
+    body.bytes.pop_back();
+    check(rejected(withHeader(5, body, (uint16_t)body.bytes.size())), "v5, one byte short (CRC right)");
+
+    img = good;
+    img.bytes.resize(img.bytes.size() - 1);
+    check(rejected(img), "image cut off before the end of the payload");
+
+    body = payload(SETTINGS_VERSION);
+    check(rejected(withHeader(SETTINGS_VERSION + 1, body, (uint16_t)body.bytes.size())), "version from the future (CRC right)");
+    check(rejected(withHeader(0, body, (uint16_t)body.bytes.size())), "version 0 (CRC right)");
+
+    img = imageV1();
+    img.bytes[20] ^= 0x10;
+    check(rejected(img), "v1 with a wrong XOR checksum");
+
+    img.bytes.assign(header + sizeof(StoredSettings), 0xFF);
+    check(rejected(img), "erased flash");
+
+    img = good;
+    img.bytes.resize(3);
+    check(rejected(img), "shorter than the magic");
+
+    // --- 3. the same through the EEPROM ---
+    printf("EEPROM:\n");
+    img = imageV1();
+    memset(EEPROM.data(), 0xFF, EEPROM.length());
+    memcpy(EEPROM.data() + SETTINGS_EEPROM_ADDRESS, img.bytes.data(), img.bytes.size());
+    RadioSettings loaded, want;
+    expected(1, want);
+    check(settingsLoad(loaded) == SETTINGS_MIGRATED && differences(loaded, want).empty(), "settingsLoad() migrates a v1 image");
+
+    settingsSave(loaded);
+    RadioSettings again;
+    check(settingsLoad(again) == SETTINGS_LOADED && differences(again, loaded).empty(), "saved as the current version and loaded back");
+
+    memset(EEPROM.data(), 0xFF, EEPROM.length());
+    RadioSettings defaults;
+    settingsSetDefaults(defaults);
+    check(settingsLoad(again) == SETTINGS_DEFAULTED && differences(again, defaults).empty(), "erased EEPROM gives the defaults");
+
+    printf("\n%s (%d failed)\n", failures ? "FAIL" : "OK", failures);
+    return failures;
+}
+
+} // namespace SettingsImages
@@ -0,0 +1,193 @@
+/**
+ * @file SpectrumLoopback.cpp
+ * @author Ebrahim Siami
+ * @brief Channel survey against a simulated 2.4 GHz band (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "SpectrumLoopback.h"
+#include <stdio.h>
+#include <random>
+#include "NativeHal.h"
+#include "Spectrum.h"
+#include "Bind.h"
+#include "Radio.h"
+#include "Settings.h"
+
+void loop();
+
+// Firmware state we look at from the outside (main.cpp)
+extern RadioSettings settings;
+void applyRfOutput();
+bool spectrumStart();
+void spectrumStop();
+void bindStart();
+
+namespace SpectrumLoopback {
+
+static const uint32_t LOOP_US = 100;
+
+// The band: share of the time each source is on the air
+struct Source {
+    uint8_t first, last;    // NRF24 channels it covers
+    double busy;
+};
+
+static const Source SOURCES[] = {
+    {  24,  46, 0.35 },     // WiFi channel 6 (2437 MHz)
+    {  49,  71, 0.20 },     // WiFi channel 11 (2462 MHz)
+    {  89,  95, 0.50 },     // another transmitter, in our hop range
+    {  99, 101, 0.60 },     // a legacy one on channel 100
+};
+static const double NOISE = 0.005;
+
+static std::mt19937 rng(5050);
+static std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+static int failures = 0;
+
+static bool onCarrier(uint8_t channel, uint64_t timeUs) {
+    (void)timeUs;
+    double busy = NOISE;
+    for (const Source& s : SOURCES) {
+        if (channel >= s.first && channel <= s.last && s.busy > busy) busy = s.busy;
+    }
+    return uniform(rng) < busy;
+}
+
+static bool busyChannel(uint8_t channel) {
+    for (const Source& s : SOURCES) {
+        if (channel + 2 >= s.first && channel <= s.last + 2) return true;   // with the neighbours
+    }
+    return false;
+}
+
+// Channel packets on the air and the channel of the last one
+static uint64_t packets = 0;
+static uint8_t  packetChannel = 0;
+
+static bool onAir(uint64_t address, uint8_t channel, const void* payload, uint8_t len) {
+    (void)address; (void)payload; (void)len;
+    packets++;
+    packetChannel = channel;
+    return false;
+}
+
+static void check(bool ok, const char* what) {
+    printf("  %-62s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static double meanHits(uint8_t first, uint8_t last) {
+    uint32_t sum = 0;
+    for (uint8_t ch = first; ch <= last; ch++) sum += Spectrum::hits()[ch];
+    return (double)sum / (last - first + 1);
+}
+
+// Runs the firmware, returns the most channels the scan moved on in one loop()
+static uint8_t runFor(uint32_t ms) {
+    uint64_t until = NativeHal::nowMicros() + (uint64_t)ms * 1000;
+    uint8_t maxStep = 0;
+    while (NativeHal::nowMicros() < until) {
+        uint8_t before = Spectrum::position();
+        loop();
+        NativeHal::advanceMicros(LOOP_US);
+        uint8_t step = (uint8_t)((Spectrum::position() + Spectrum::CHANNELS - before) % Spectrum::CHANNELS);
+        if (step > maxStep) maxStep = step;
+    }
+    return maxStep;
+}
+
+static void report(bool verbose) {
+    if (!verbose) return;
+    printf("    (%u sweeps, peak %u; mean hits WiFi 6 %.1f, WiFi 11 %.1f, quiet 0-20 %.1f, ch 100 %u)\n",
+           Spectrum::sweeps(), Spectrum::peak(), meanHits(24, 46), meanHits(49, 71), meanHits(0, 20),
+           Spectrum::hits()[100]);
+}
+
+int run(bool verbose) {
+    failures = 0;
+    NativeHal::onRadioCarrier(onCarrier);
+    NativeHal::onRadioAir(onAir);
+
+    settings.rfOutput = RF_OUTPUT_NRF24;
+    applyRfOutput();
+
+    // --- 1. a few seconds of scanning ---
+    printf("scan:\n");
+    check(spectrumStart() && Spectrum::active(), "starts with the NRF24 on");
+    uint64_t packetsBefore = packets;
+    uint64_t startUs = NativeHal::nowMicros();
+    uint8_t maxStep = runFor(5000);
+    report(verbose);
+    check(maxStep <= 1, "one channel per loop() at most");
+    check(packets == packetsBefore, "no channel packets while scanning");
+    uint32_t sweepUs = (uint32_t)((NativeHal::nowMicros() - startUs) / Spectrum::sweeps());
+    if (verbose) printf("    (%u us per sweep)\n", sweepUs);
+    check(sweepUs >= Spectrum::CHANNELS * Spectrum::DWELL_US, "every channel gets its dwell time");
+    check(Spectrum::sweeps() >= Spectrum::MIN_SWEEPS, "enough sweeps for a result");
+
+    // --- 2. what it found ---
+    printf("picture:\n");
+    double quiet = meanHits(0, 20);
+    check(meanHits(24, 46) > 10 * (quiet + 1), "WiFi channel 6 stands out");
+    check(meanHits(49, 71) > 5 * (quiet + 1), "WiFi channel 11 stands out");
+    check(Spectrum::hits()[100] > 10 * (quiet + 1) && meanHits(90, 94) > 10 * (quiet + 1), "both transmitters stand out");
+    check(meanHits(105, 125) < 2 * (quiet + 1), "the top of the band stays low");
+
+    uint8_t channel = Spectrum::quietest(Bind::HOP_FIRST, Bind::HOP_CHANNELS);
+    if (verbose) printf("    (quietest hop channel %u, %u hits)\n", channel, Spectrum::hits()[channel]);
+    check(channel >= Bind::HOP_FIRST && channel < Bind::HOP_FIRST + Bind::HOP_CHANNELS, "quietest channel in the hop range");
+    check(!busyChannel(channel), "quietest channel away from the busy ones");
+
+    // --- 3. long enough to overflow a byte ---
+    printf("long scan:\n");
+    runFor(40000);
+    report(verbose);
+    // Without the halving channel 100 would have wrapped its byte a few times by now
+    check(Spectrum::sweeps() * 0.6 > 2 * 255, "long enough to overflow the busiest channel");
+    uint8_t top = 0;
+    for (uint8_t ch = 1; ch < Spectrum::CHANNELS; ch++) {
+        if (Spectrum::hits()[ch] > Spectrum::hits()[top]) top = ch;
+    }
+    if (verbose) printf("    (busiest channel %u, %u hits)\n", top, Spectrum::hits()[top]);
+    check(Spectrum::peak() >= 128 && Spectrum::hits()[top] == Spectrum::peak(), "counts halved, the peak stays in the upper half");
+    check(top >= 99 && top <= 101, "the 60 % transmitter is still on top");
+    check(meanHits(99, 101) > meanHits(89, 95) && meanHits(89, 95) > meanHits(24, 46) &&
+          meanHits(24, 46) > meanHits(49, 71), "hits still rank by how busy the channel is");
+    check(meanHits(24, 46) > 10 * (meanHits(0, 20) + 1) && Spectrum::hits()[100] > 2 * meanHits(49, 71),
+          "the picture keeps its shape (60 % vs 20 % busy: 3 to 1)");
+    check(!busyChannel(Spectrum::quietest(Bind::HOP_FIRST, Bind::HOP_CHANNELS)), "still a quiet channel");
+
+    // --- 4. back to the model, then bind on the quiet channel ---
+    printf("after the scan:\n");
+    channel = Spectrum::quietest(Bind::HOP_FIRST, Bind::HOP_CHANNELS);
+    uint8_t linkChannel = Bind::isBound(settings.rfAddress) ? Bind::channelOf(settings.hopSeed) : Bind::LEGACY_CHANNEL;
+    spectrumStop();
+    packetsBefore = packets;
+    runFor(100);
+    check(!Spectrum::active() && packets >= packetsBefore + 45, "channel packets back at once");
+    check(packetChannel == linkChannel, "on the link channel of the model");
+
+    bindStart();
+    check(Bind::active() && Bind::channelOf(Bind::result().hopSeed) == channel, "bind takes the quietest channel");
+    Bind::cancel();
+    radioSetLink(settings.rfAddress, settings.hopSeed);
+    applyRfOutput();
+
+    // --- 5. only with the NRF24 ---
+    printf("other outputs:\n");
+    check(spectrumStart(), "scan again");
+    settings.rfOutput = RF_OUTPUT_CRSF;
+    applyRfOutput();
+    check(!Spectrum::active(), "switching to CRSF ends it");
+    check(!spectrumStart() && !Spectrum::active(), "no scan without the NRF24");
+    settings.rfOutput = RF_OUTPUT_NRF24;
+    applyRfOutput();
+
+    printf("\n%s (%d failed)\n", failures ? "FAIL" : "OK", failures);
+    return failures;
+}
+
+} // namespace SpectrumLoopback
@@ -0,0 +1,171 @@
+/**
+ * @file TraceReplay.cpp
+ * @author Ebrahim Siami
+ * @brief Replays a recorded input trace through the firmware (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "TraceReplay.h"
+#include <stdio.h>
+#include <chrono>
+#include <vector>
+#include "NativeHal.h"
+#include "InputTrace.h"
+#include "Radio.h"
+#include "Crc.h"
+#include "Settings.h"
+#include "ChannelPipeline.h"
+#include "Arming.h"
+#include "sim_protocol_format.h"
+
+void loop();
+
+// Firmware state we look at from the outside (main.cpp)
+extern data_t data;
+extern unsigned long lastAdcTime;
+extern bool simulatorMode;
+extern RadioSettings settings;
+extern ArmingState armingState;
+void applyRfOutput();
+
+namespace TraceReplay {
+
+static bool readFile(const char* path, std::vector<uint8_t>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+// Throttle cut wanted by the trace itself, for a cut on Aux3/Aux4 (false for other switches)
+static bool traceCutOn(const InputTrace::Record& r, uint8_t ref) {
+    uint8_t bit = ref & ~LS_REF_NOT;
+    if (bit != LS_REF_AUX3 && bit != LS_REF_AUX4) return false;
+
+    uint8_t channel = (bit == LS_REF_AUX3) ? 6 : 7;
+    bool level = (r.inputs >> (bit == LS_REF_AUX3 ? InputTrace::IN_AUX3 : InputTrace::IN_AUX4)) & 1;
+    bool on = settings.channelInverted[channel] ? !level : level;
+    return (ref & LS_REF_NOT) ? !on : on;
+}
+
+static void applyInputs(const InputTrace::Record& r) {
+    for (uint8_t i = 0; i < InputTrace::ADC_CHANNELS; i++) {
+        NativeHal::setAnalog(InputTrace::ADC_PINS[i], r.adc[i]);
+    }
+    for (uint8_t i = 0; i < InputTrace::INPUT_COUNT; i++) {
+        NativeHal::setDigital(InputTrace::INPUT_PINS[i], (r.inputs >> i) & 1);
+    }
+}
+
+bool run(const char* path, const Options& options, Result& result) {
+    std::vector<uint8_t> trace;
+    if (!readFile(path, trace)) {
+        perror(path);
+        return false;
+    }
+
+    FILE* dataFile = options.dataOut ? fopen(options.dataOut, "wb") : nullptr;
+    FILE* simFile = options.simOut ? fopen(options.simOut, "wb") : nullptr;
+    FILE* uartFile = options.crsfOut ? fopen(options.crsfOut, "wb") : nullptr;
+    if ((options.dataOut && !dataFile) || (options.simOut && !simFile) || (options.crsfOut && !uartFile)) {
+        perror("replay output");
+        if (dataFile) fclose(dataFile);
+        if (simFile) fclose(simFile);
+        if (uartFile) fclose(uartFile);
+        return false;
+    }
+
+    if (options.crsfRateHz > 0) {
+        settings.rfOutput = RF_OUTPUT_CRSF;
+        settings.crsfRateHz = (uint16_t)options.crsfRateHz;
+    }
+    if (options.simulatorMode) simulatorMode = true;
+    applyRfOutput();
+    if (options.simulatorMode && options.simBatch > 0) {
+        // what tools/simproto sends with -v 2 -b batch -c channels, read by the first loop()
+        uint8_t request[SimProto::REQUEST_SIZE] = { SimProto::HEADER1, SimProto::HEADER2, SimProto::REQUEST_VERSION,
+                                                    SimProto::VERSION_2, (uint8_t)options.simBatch, (uint8_t)options.simChannels };
+        request[SimProto::REQUEST_SIZE - 1] = Crc::crc8(&request[2], SimProto::REQUEST_SIZE - 3);
+        NativeHal::serialInject(request, sizeof(request));
+    }
+    NativeHal::serialTx().clear();
+    NativeHal::uartTx().clear();
+    if (options.throttleCutSwitch >= 0) settings.throttleCutSwitch = (uint8_t)options.throttleCutSwitch;
+
+    result = Result();
+    std::vector<uint8_t>& usb = NativeHal::serialTx();
+    std::vector<uint8_t>& uart = NativeHal::uartTx();
+    const uint64_t replayStart = NativeHal::nowMicros();
+    uint64_t clock = 0;          // replay time of the current record
+    uint32_t lastTraceUs = 0;
+    bool first = true;
+
+    auto t0 = std::chrono::steady_clock::now();
+    size_t pos = 0;
+    while (pos + InputTrace::RECORD_SIZE <= trace.size()) {
+        InputTrace::Record r;
+        if (!InputTrace::decode(&trace[pos], r)) {
+            pos++;
+            result.skippedBytes++;
+            continue;
+        }
+        pos += InputTrace::RECORD_SIZE;
+        result.records++;
+
+        if (first) {
+            // Keep the sub-millisecond phase of the recording, millis() then ticks at the same records
+            clock = (replayStart / 1000 + 1) * 1000 + r.timeUs % 1000;
+            first = false;
+        } else {
+            clock += (uint32_t)(r.timeUs - lastTraceUs);   // wrap-safe, traces can be hours long
+        }
+        lastTraceUs = r.timeUs;
+
+        uint64_t now = NativeHal::nowMicros();
+        if (clock > now) NativeHal::advanceMicros((uint32_t)(clock - now));
+
+        applyInputs(r);
+        unsigned long adcBefore = lastAdcTime;
+        loop();
+
+        if (lastAdcTime != adcBefore) {
+            result.frames++;
+            result.framesCrc = Crc::crc32((const uint8_t*)&data, sizeof(data_t), result.framesCrc);
+            if (dataFile) fwrite(&data, sizeof(data_t), 1, dataFile);
+
+            bool idle = data.throttle == (throttleIdleValue(settings) >> 1);
+            if (armingState.state != ARM_ARMED) result.heldFrames++;
+            else if (result.armedFrame < 0) result.armedFrame = (int64_t)result.frames - 1;
+            if (armingState.state == ARM_CUT) result.cutFrames++;
+            if (traceCutOn(r, settings.throttleCutSwitch) && !idle) result.cutLateFrames++;
+        }
+
+        if (!usb.empty()) {
+            result.simBytes += usb.size();
+            result.simCrc = Crc::crc32(usb.data(), usb.size(), result.simCrc);
+            if (simFile) fwrite(usb.data(), 1, usb.size(), simFile);
+            usb.clear();
+        }
+
+        if (!uart.empty()) {
+            result.uartBytes += uart.size();
+            result.uartCrc = Crc::crc32(uart.data(), uart.size(), result.uartCrc);
+            if (uartFile) fwrite(uart.data(), 1, uart.size(), uartFile);
+            uart.clear();
+        }
+    }
+    result.skippedBytes += trace.size() - pos;
+    result.hostSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    result.simulatedSec = (NativeHal::nowMicros() - replayStart) / 1e6;
+
+    if (dataFile) fclose(dataFile);
+    if (simFile) fclose(simFile);
+    if (uartFile) fclose(uartFile);
+    return true;
+}
+
+} // namespace TraceReplay
@@ -0,0 +1,239 @@
+/**
+ * @file TrainerLoopback.cpp
+ * @author Ebrahim Siami
+ * @brief Loopback test of the trainer / HIL mode (native build)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "TrainerLoopback.h"
+#include <stdio.h>
+#include <deque>
+#include <random>
+#include <vector>
+#include "NativeHal.h"
+#include "Trainer.h"
+#include "Radio.h"
+#include "Outputs.h"
+#include "Mixer.h"
+#include "Settings.h"
+#include "ChannelPipeline.h"
+#include "Arming.h"
+
+void loop();
+
+// Firmware state we look at from the outside (main.cpp)
+extern bool trainerMode;
+extern bool simulatorMode;
+extern RadioSettings settings;
+extern ArmingState armingState;
+void applyRfOutput();
+
+namespace TrainerLoopback {
+
+static const uint32_t LOOP_US = 100;
+static const uint32_t FRAME_US = 2000;      // host streams at 500 Hz
+
+struct Packet {
+    uint64_t timeUs;
+    data_t   data;
+};
+
+static std::vector<Packet> packets;
+static int failures = 0;
+
+static void onRadioPacket(const void* payload, uint8_t len, uint64_t timeUs) {
+    if (len != sizeof(data_t)) return;
+    Packet p;
+    p.timeUs = timeUs;
+    memcpy(&p.data, payload, sizeof(data_t));
+    packets.push_back(p);
+}
+
+static void check(bool ok, const char* what) {
+    printf("  %-62s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+// What the radio sends for these host channels (throttle compared separately)
+static data_t expected(const uint16_t ch[MIX_CHANNELS]) {
+    int in[MIX_CHANNELS];
+    for (uint8_t i = 0; i < MIX_CHANNELS; i++) in[i] = ch[i];
+    ChannelFrame frame;
+    outputsBuildFrame(frame, in, MIX_CHANNELS, 0);
+    data_t d;
+    radioPack(frame, d);
+    return d;
+}
+
+static bool sameExceptThrottle(const data_t& a, const data_t& b) {
+    return a.roll == b.roll && a.pitch == b.pitch && a.yaw == b.yaw &&
+           a.aux1 == b.aux1 && a.aux2 == b.aux2 && a.aux3 == b.aux3 && a.aux4 == b.aux4;
+}
+
+// Runs loop() until 'untilUs', handing 'pending' to the USB port in random chunks
+static void runUntil(uint64_t untilUs, std::vector<uint8_t>& pending, std::mt19937& rng) {
+    while (NativeHal::nowMicros() < untilUs) {
+        if (!pending.empty()) {
+            size_t n = 1 + rng() % 48;
+            if (n > pending.size()) n = pending.size();
+            NativeHal::serialInject(pending.data(), n);
+            pending.erase(pending.begin(), pending.begin() + n);
+        }
+        loop();
+        NativeHal::advanceMicros(LOOP_US);
+    }
+}
+
+// Channels of host frame 'i': every channel moving, never the stick values
+static void pattern(uint32_t i, int throttleIdle, bool throttleLive, uint16_t ch[MIX_CHANNELS]) {
+    for (uint8_t c = 0; c < MIX_CHANNELS; c++) {
+        ch[c] = (uint16_t)(100 + (i * 7 + c * 409) % 1800);
+    }
+    ch[MIX_CH_THROTTLE] = (uint16_t)(throttleLive ? 2600 + (i * 5) % 1400 : throttleIdle);
+    ch[MIX_CH_AUX3] = (i & 64) ? 4095 : 0;
+    ch[MIX_CH_AUX4] = (i & 128) ? 4095 : 0;
+}
+
+int run(bool verbose) {
+    std::mt19937 rng(4343);
+    failures = 0;
+    packets.clear();
+    NativeHal::onRadioWrite(onRadioPacket);
+
+    // NRF24 output with the sticks centered, then the trainer is switched on like the menu does
+    std::vector<uint8_t> pending;
+    settings.rfOutput = RF_OUTPUT_NRF24;
+    simulatorMode = false;
+    applyRfOutput();
+    runUntil(NativeHal::nowMicros() + 50000, pending, rng);
+    if (packets.empty()) {
+        printf("no radio packets from the sticks\n");
+        return 1;
+    }
+    const data_t stickPacket = packets.back().data;
+    const int throttleIdle = throttleIdleValue(settings);
+    const uint16_t idlePacked = (uint16_t)(throttleIdle >> 1);
+
+    trainerMode = true;
+    Trainer::begin(millis());
+
+    // --- 1. stream 2000 frames, with corrupted, repeated and bunched up frames ---
+    printf("streaming:\n");
+    std::deque<data_t> recent;           // expected packets of the last good frames
+    uint32_t good = 0, corrupted = 0, repeated = 0;
+    uint64_t mismatches = 0, leaked = 0, heldEarly = 0, leakedEarly = 0, heldLate = 0;
+    bool lastWasGood = false;     // the frame of this round, only good ones are sent twice
+    uint8_t seq = 0;
+    uint64_t t = NativeHal::nowMicros();
+    uint64_t lastGoodUs = t;
+
+    for (uint32_t i = 0; i < 2000; i++) {
+        uint16_t ch[MIX_CHANNELS];
+        pattern(i, throttleIdle, i < 50 || i >= 150, ch);   // starts with the throttle up
+
+        uint8_t frame[SimProto::HOST_MAX_FRAME];
+        size_t len = SimProto::makeChannelFrame(seq, ch, MIX_CHANNELS, frame);
+
+        if (i > 200 && rng() % 40 == 0) {
+            // one flipped bit after the header, the sequence number moves on anyway
+            frame[SimProto::HOST_HEADER_SIZE + rng() % (len - SimProto::HOST_HEADER_SIZE)] ^= (uint8_t)(1 << (rng() % 8));
+            corrupted++;
+            lastWasGood = false;
+        } else {
+            recent.push_back(expected(ch));
+            if (recent.size() > 3) recent.pop_front();
+            good++;
+            lastGoodUs = t;
+            lastWasGood = true;
+        }
+        seq++;
+        pending.insert(pending.end(), frame, frame + len);
+
+        if (i > 200 && lastWasGood && rng() % 60 == 0) {
+            pending.insert(pending.end(), frame, frame + len);   // sent twice, the copy must be dropped
+            repeated++;
+        }
+
+        // now and then the host (or the USB stack) sends three frames in one go
+        if (rng() % 100 == 0 && i + 1 < 2000) continue;
+
+        size_t first = packets.size();
+        t += FRAME_US;
+        runUntil(t, pending, rng);
+
+        for (size_t k = first; k < packets.size(); k++) {
+            const data_t& d = packets[k].data;
+            const data_t* match = nullptr;
+            for (const data_t& e : recent) {
+                if (sameExceptThrottle(d, e)) match = &e;
+            }
+            if (i < 5) continue;    // link coming up
+            if (!match) mismatches++;
+            if (sameExceptThrottle(d, stickPacket)) leaked++;
+            if (i < 50 && d.throttle == idlePacked) heldEarly++;
+            if (i < 50 && d.throttle != idlePacked) leakedEarly++;
+            if (i >= 160 && match && d.throttle != match->throttle) heldLate++;
+        }
+    }
+    pending.clear();
+
+    const Trainer::Stats& st = Trainer::stats();
+    if (verbose) {
+        printf("  (%u good, %u corrupted, %u repeated; trainer saw %u frames, %u crc errors, %u stale, "
+               "%u lost, %u bytes skipped)\n", good, corrupted, repeated, st.frames, st.crcErrors,
+               st.staleFrames, st.lostFrames, st.skippedBytes);
+    }
+    check(Trainer::linkUp(), "link is up while the host streams");
+    check(mismatches == 0, "every packet carries one of the last good host frames");
+    check(leaked == 0, "no stick packet while the host streams");
+    check(st.frames == good, "every good frame taken");
+    check(st.crcErrors == corrupted, "every corrupted frame caught by the CRC");
+    check(st.staleFrames == repeated, "every repeated frame dropped by the sequence check");
+    check(st.lostFrames == corrupted, "sequence gaps = corrupted frames");
+    check(heldEarly > 0 && leakedEarly == 0, "host throttle up at the start held at idle by the interlock");
+    check(heldLate == 0, "host throttle live after it was at idle");
+
+    // --- 2. the host goes quiet: sticks back within the watchdog time ---
+    printf("watchdog:\n");
+    size_t first = packets.size();
+    runUntil(t + 500000, pending, rng);
+    t = NativeHal::nowMicros();
+
+    uint64_t backUs = 0;
+    bool backToSticks = false;
+    for (size_t k = first; k < packets.size(); k++) {
+        if (sameExceptThrottle(packets[k].data, stickPacket)) {
+            backUs = packets[k].timeUs - lastGoodUs;
+            backToSticks = true;
+            break;
+        }
+    }
+    if (verbose) printf("  (sticks back %.1f ms after the last good frame)\n", backUs / 1000.0);
+    check(!Trainer::linkUp() && st.timeouts == 1, "link down, one watchdog timeout");
+    check(backToSticks, "sticks in control again");
+    check(backUs > Trainer::TIMEOUT_MS * 1000ULL && backUs <= Trainer::TIMEOUT_MS * 1000ULL + 3 * FRAME_US,
+          "within the watchdog time plus a tick and a radio period");
+    check(armingState.state != ARM_ARMED, "throttle interlock waits for the stick after the switch");
+
+    // --- 3. the host restarts from sequence 0 ---
+    printf("restart:\n");
+    uint16_t ch[MIX_CHANNELS];
+    data_t restartPacket = data_t();
+    for (uint32_t i = 0; i < 50; i++) {
+        pattern(5000 + i, throttleIdle, false, ch);
+        uint8_t frame[SimProto::HOST_MAX_FRAME];
+        size_t len = SimProto::makeChannelFrame((uint8_t)i, ch, MIX_CHANNELS, frame);
+        pending.insert(pending.end(), frame, frame + len);
+        restartPacket = expected(ch);
+        t += FRAME_US;
+        runUntil(t, pending, rng);
+    }
+    check(Trainer::linkUp(), "link is up again");
+    check(!packets.empty() && sameExceptThrottle(packets.back().data, restartPacket), "the new stream is on the radio");
+
+    printf("\n%s (%d failed)\n", failures ? "FAIL" : "OK", failures);
+    return failures;
+}
+
+} // namespace TrainerLoopback
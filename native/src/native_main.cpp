@@ -0,0 +1,265 @@
+/**
+ * @file native_main.cpp
+ * @author Ebrahim Siami
+ * @brief Runs the whole transmitter firmware on Linux (pio run -e native)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Calls setup() once and then loop() against the simulated clock, moving the
+ * sticks on slow sine waves. At the end it prints what the radio sent and how
+ * long loop() took on the host, which makes it a cheap benchmark of the 500 Hz
+ * path without a board. Both modes also print the sample -> transmit latency
+ * of every output (Outputs.h); the simulated clock stands still inside loop(),
+ * so on the host that is the scheduling part only, without the processing time.
+ * --timing lets the slow hardware calls move the clock (NativeHal::TimingModel);
+ * with -D LATENCY_TRACE the 'L' records in the USB output then show roughly
+ * the stage timing of the board (tools/latency).
+ *
+ * Usage:
+ *   .pio/build/native/program [--seconds 10] [--loop-us 100] [--jitter-us 0] [--eeprom eeprom.bin]
+ *                             [--timing] [--sim-out f]
+ *   .pio/build/native/program --replay flight.trace [--sim] [--sim-v2 batch,channels] [--data-out f] [--sim-out f]
+ *                             [--throttle-cut sw] [--crsf hz] [--crsf-out f]
+ *   .pio/build/native/program --trainer-test [-v]
+ *   .pio/build/native/program --bind-test [-v]
+ *   .pio/build/native/program --power-test [-v]
+ *   .pio/build/native/program --spectrum-test [-v]
+ *   .pio/build/native/program --settings-test [-v]
+ *   .pio/build/native/program --arming-test [-v]
+ *
+ *   --seconds  simulated run time after setup()
+ *   --loop-us  simulated time between two loop() calls (the F103 needs ~100 us)
+ *   --jitter-us  up to this much more per loop() call, random (display refresh, menus, EEPROM)
+ *   --timing   simulated execution time of ADC reads, radio and USB writes (F103 figures)
+ *   --eeprom   load the emulated EEPROM from this file and write it back at the end
+ *   --replay   feed a recorded input trace instead of the sine sweep (see TraceReplay.h)
+ *   --sim      replay with simulator mode on, so the SimProto output is produced too
+ *   --sim-v2   with --sim: the host asks for SimProto v2 with this batch (1-4) and channel count (8-16)
+ *   --data-out / --sim-out  write the data_t frames / the USB output of the replay (--sim-out works
+ *              for the sweep too)
+ *   --throttle-cut  replay with this switch as throttle cut: aux3, aux4, l1..l16, '!' inverts
+ *   --crsf     replay with the CRSF output at this rate (150-500 Hz) instead of the NRF24
+ *   --crsf-out write the UART output of the replay (decode it with tools/crsf)
+ *   --trainer-test  loopback test of the trainer / HIL mode (see TrainerLoopback.h), exit code 1 on failure
+ *   --bind-test  bind procedure against a stand-in receiver (see BindLoopback.h), exit code 1 on failure
+ *   --power-test  adaptive TX power against a receiver at a distance (see PowerLoopback.h), exit code 1 on failure
+ *   --spectrum-test  channel survey against a simulated busy band (see SpectrumLoopback.h), exit code 1 on failure
+ *   --settings-test  settings images of every schema version through the decoder (see SettingsImages.h), exit code 1 on failure
+ *   --arming-test  throttle interlock with curves, mix lines and the cut switch (see ArmingLoopback.h), exit code 1 on failure
+ *
+ * For bit-for-bit comparisons always pass the same --eeprom image, the
+ * settings change the output as much as the sticks do.
+ */
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <chrono>
+#include "NativeHal.h"
+#include "TraceReplay.h"
+#include "TrainerLoopback.h"
+#include "BindLoopback.h"
+#include "PowerLoopback.h"
+#include "SpectrumLoopback.h"
+#include "SettingsImages.h"
+#include "ArmingLoopback.h"
+#include "Radio.h"
+#include "LogicalSwitches.h"
+#include "CrsfOutput.h"
+#include "sim_protocol.h"
+
+void setup();
+void loop();
+
+static data_t lastPacket;
+
+// "aux3", "!aux4", "l12" -> LsRef, -1 if unknown
+static int parseSwitch(const char* name) {
+    int not_ = 0;
+    if (*name == '!') { not_ = LS_REF_NOT; name++; }
+    if (!strcasecmp(name, "aux3")) return LS_REF_AUX3 | not_;
+    if (!strcasecmp(name, "aux4")) return LS_REF_AUX4 | not_;
+    if ((*name == 'l' || *name == 'L') && atoi(name + 1) >= 1 && atoi(name + 1) <= LS_COUNT) {
+        return (LS_REF_L1 + atoi(name + 1) - 1) | not_;
+    }
+    return -1;
+}
+
+static void onRadioPacket(const void* payload, uint8_t len, uint64_t timeUs) {
+    (void)timeUs;
+    if (len >= sizeof(data_t)) memcpy(&lastPacket, payload, sizeof(data_t));   // redundant packets start with it too
+}
+
+static void printLatency() {
+    const OutputSink* sinks[] = { &radioSink, &Crsf::sink, &SimProto::sink };
+    for (const OutputSink* s : sinks) {
+        if (s->writes == 0) continue;
+        printf("latency:       %-8s sample->TX avg %u us, max %u us, write() avg %u us, max %u us (%u writes)\n",
+               s->name, outputLatencyAvgUs(*s), s->latencyMaxUs, outputWriteAvgUs(*s), s->writeMaxUs, s->writes);
+    }
+}
+
+// Slow stick movement, full travel on the main channels
+static uint16_t sweep(uint64_t us, uint32_t periodMs, uint16_t center, uint16_t amplitude) {
+    double phase = (double)(us % (periodMs * 1000ULL)) / (periodMs * 1000.0);
+    return (uint16_t)(center + amplitude * sin(phase * 2.0 * M_PI));
+}
+
+int main(int argc, char** argv) {
+    double seconds = 10.0;
+    uint32_t loopUs = 100;
+    uint32_t jitterUs = 0;
+    const char* eepromPath = nullptr;
+    const char* replayPath = nullptr;
+    TraceReplay::Options replay;
+    bool trainerTest = false;
+    bool bindTest = false;
+    bool powerTest = false;
+    bool spectrumTest = false;
+    bool settingsTest = false;
+    bool armingTest = false;
+    bool verbose = false;
+    bool timing = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--loop-us") && i + 1 < argc) loopUs = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--jitter-us") && i + 1 < argc) jitterUs = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--timing")) timing = true;
+        else if (!strcmp(argv[i], "--eeprom") && i + 1 < argc) eepromPath = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) replayPath = argv[++i];
+        else if (!strcmp(argv[i], "--sim")) replay.simulatorMode = true;
+        else if (!strcmp(argv[i], "--sim-v2") && i + 1 < argc &&
+                 sscanf(argv[i + 1], "%d,%d", &replay.simBatch, &replay.simChannels) == 2) i++;
+        else if (!strcmp(argv[i], "--data-out") && i + 1 < argc) replay.dataOut = argv[++i];
+        else if (!strcmp(argv[i], "--sim-out") && i + 1 < argc) replay.simOut = argv[++i];
+        else if (!strcmp(argv[i], "--crsf") && i + 1 < argc) replay.crsfRateHz = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--crsf-out") && i + 1 < argc) replay.crsfOut = argv[++i];
+        else if (!strcmp(argv[i], "--trainer-test")) trainerTest = true;
+        else if (!strcmp(argv[i], "--bind-test")) bindTest = true;
+        else if (!strcmp(argv[i], "--power-test")) powerTest = true;
+        else if (!strcmp(argv[i], "--spectrum-test")) spectrumTest = true;
+        else if (!strcmp(argv[i], "--settings-test")) settingsTest = true;
+        else if (!strcmp(argv[i], "--arming-test")) armingTest = true;
+        else if (!strcmp(argv[i], "-v")) verbose = true;
+        else if (!strcmp(argv[i], "--throttle-cut") && i + 1 < argc && (replay.throttleCutSwitch = parseSwitch(argv[i + 1])) >= 0) i++;
+        else {
+            fprintf(stderr, "usage: %s [--seconds s] [--loop-us us] [--jitter-us us] [--eeprom file] [--timing]\n"
+                            "          [--sim-out file]\n"
+                            "       %s --replay trace [--sim] [--sim-v2 batch,channels] [--data-out file] [--sim-out file]\n"
+                            "          [--eeprom file] [--throttle-cut aux3|aux4|l1..l16, ! to invert] [--crsf hz] [--crsf-out file] [--timing]\n"
+                            "       %s --trainer-test [-v]\n"
+                            "       %s --bind-test [-v]\n"
+                            "       %s --power-test [-v]\n"
+                            "       %s --spectrum-test [-v]\n"
+                            "       %s --settings-test [-v]\n"
+                            "       %s --arming-test [-v]\n",
+                    argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
+            return 1;
+        }
+    }
+    if (loopUs == 0) loopUs = 1;
+    if (replay.crsfRateHz) replay.crsfRateHz = constrain(replay.crsfRateHz, (int)Crsf::RATE_MIN_HZ, (int)Crsf::RATE_MAX_HZ);
+
+    NativeHal::reset();
+    if (eepromPath && !NativeHal::eepromLoad(eepromPath)) {
+        printf("eeprom: %s not found, starting blank\n", eepromPath);
+    }
+    NativeHal::onRadioWrite(onRadioPacket);
+    if (timing) NativeHal::setTimingModel(NativeHal::bluePillTiming());
+
+    // ~8.4 V on the battery divider, so the low battery alarm stays quiet
+    NativeHal::setAnalog(PA4, 2378);
+
+    setup();
+
+    if (trainerTest) {
+        return TrainerLoopback::run(verbose) ? 1 : 0;
+    }
+    if (bindTest) {
+        return BindLoopback::run(verbose) ? 1 : 0;
+    }
+    if (powerTest) {
+        return PowerLoopback::run(verbose) ? 1 : 0;
+    }
+    if (spectrumTest) {
+        return SpectrumLoopback::run(verbose) ? 1 : 0;
+    }
+    if (settingsTest) {
+        return SettingsImages::run(verbose) ? 1 : 0;
+    }
+    if (armingTest) {
+        return ArmingLoopback::run(verbose) ? 1 : 0;
+    }
+
+    if (replayPath) {
+        TraceReplay::Result r;
+        if (!TraceReplay::run(replayPath, replay, r)) return 1;
+
+        printf("replayed %llu records (%llu bytes skipped), %.1f s of flight in %.3f s (%.0fx real time)\n",
+               (unsigned long long)r.records, (unsigned long long)r.skippedBytes,
+               r.simulatedSec, r.hostSec, r.hostSec > 0 ? r.simulatedSec / r.hostSec : 0.0);
+        printf("data_t frames: %llu  crc32 %08x\n", (unsigned long long)r.frames, r.framesCrc);
+        printf("usb output:    %llu bytes  crc32 %08x\n", (unsigned long long)r.simBytes, r.simCrc);
+        printf("uart output:   %llu bytes  crc32 %08x\n", (unsigned long long)r.uartBytes, r.uartCrc);
+        printf("throttle:      live from frame %lld, %llu frames held at idle (%llu by the cut), %llu cut frames late\n",
+               (long long)r.armedFrame, (unsigned long long)r.heldFrames,
+               (unsigned long long)r.cutFrames, (unsigned long long)r.cutLateFrames);
+        printLatency();
+        return 0;
+    }
+
+    const uint64_t start = NativeHal::nowMicros();
+    const uint64_t end = start + (uint64_t)(seconds * 1e6);
+    const uint64_t packetsBefore = NativeHal::radioStats().packets;
+    uint64_t loops = 0;
+    uint32_t jitterSeed = 12345;
+
+    auto t0 = std::chrono::steady_clock::now();
+    while (NativeHal::nowMicros() < end) {
+        uint64_t now = NativeHal::nowMicros();
+        NativeHal::setAnalog(PA0, sweep(now, 2000, 2048, 1900));   // roll
+        NativeHal::setAnalog(PA1, sweep(now, 3000, 2048, 1900));   // pitch
+        NativeHal::setAnalog(PA2, sweep(now, 5000, 2048, 2000));   // throttle
+        NativeHal::setAnalog(PA3, sweep(now, 7000, 2048, 1900));   // yaw
+
+        loop();
+        loops++;
+
+        uint32_t step = loopUs;
+        if (jitterUs) {
+            jitterSeed = jitterSeed * 1103515245u + 12345u;     // same sequence on every run
+            step += (jitterSeed >> 8) % (jitterUs + 1);
+        }
+        NativeHal::advanceMicros(step);
+    }
+    double hostSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    double simSec = (NativeHal::nowMicros() - start) / 1e6;
+    uint64_t packets = NativeHal::radioStats().packets - packetsBefore;
+
+    printf("simulated %.1f s, %llu loop() calls, %.0f ns per loop() on this host\n",
+           simSec, (unsigned long long)loops, hostSec * 1e9 / (loops ? loops : 1));
+    printf("radio: %llu packets (%.1f Hz), last roll=%u pitch=%u throttle=%u yaw=%u aux1=%u aux2=%u aux3=%u aux4=%u\n",
+           (unsigned long long)packets, packets / simSec,
+           lastPacket.roll, lastPacket.pitch, lastPacket.throttle, lastPacket.yaw,
+           lastPacket.aux1, lastPacket.aux2, lastPacket.aux3, lastPacket.aux4);
+    printLatency();
+    printf("eeprom: %u flash write cycles\n", NativeHal::eepromCommits());
+
+    if (replay.simOut) {
+        const std::vector<uint8_t>& usb = NativeHal::serialTx();
+        FILE* f = fopen(replay.simOut, "wb");
+        if (!f || fwrite(usb.data(), 1, usb.size(), f) != usb.size()) {
+            perror(replay.simOut);
+            return 1;
+        }
+        fclose(f);
+        printf("usb output:    %zu bytes -> %s\n", usb.size(), replay.simOut);
+    }
+
+    if (eepromPath && !NativeHal::eepromSave(eepromPath)) {
+        perror(eepromPath);
+        return 1;
+    }
+    return 0;
+}
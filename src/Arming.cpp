@@ -0,0 +1,51 @@
+/**
+ * @file Arming.cpp
+ * @author Ebrahim Siami
+ * @brief Throttle interlock: arming at boot and the throttle cut override
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "Arming.h"
+
+void armingReset(ArmingState& s) {
+    s.state = ARM_WAIT_THROTTLE;
+    s.warned = false;
+    s.low = false;
+    s.lowSinceMs = 0;
+}
+
+ArmEvent armingUpdate(ArmingState& s, bool cut, int fromIdle, uint32_t nowMs) {
+    bool low = fromIdle <= ARM_THROTTLE_LOW_BAND;
+    if (low && !s.low) s.lowSinceMs = nowMs;
+    s.low = low;
+
+    // The cut wins over everything, whatever the throttle does
+    if (cut) {
+        if (s.state == ARM_CUT) return ARM_EVT_NONE;
+        s.state = ARM_CUT;
+        return ARM_EVT_CUT_ON;
+    }
+
+    switch (s.state) {
+        case ARM_CUT:
+            // Released: the throttle has to come back to idle before it's live again
+            s.state = ARM_WAIT_THROTTLE;
+            s.warned = false;
+            return ARM_EVT_CUT_OFF;
+
+        case ARM_WAIT_THROTTLE:
+            if (low && nowMs - s.lowSinceMs >= ARM_THROTTLE_LOW_MS) {
+                s.state = ARM_ARMED;
+                return s.warned ? ARM_EVT_ARMED : ARM_EVT_NONE;
+            }
+            if (!low && !s.warned) {
+                s.warned = true;
+                return ARM_EVT_BLOCKED;
+            }
+            return ARM_EVT_NONE;
+
+        default:
+            return ARM_EVT_NONE;
+    }
+}
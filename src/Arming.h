@@ -0,0 +1,79 @@
+/**
+ * @file Arming.h
+ * @author Ebrahim Siami
+ * @brief Throttle interlock: arming at boot and the throttle cut override
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * The throttle output is held at idle until it's safe to let it through:
+ *
+ *   WAIT_THROTTLE --(throttle at idle for ARM_THROTTLE_LOW_MS)--> ARMED
+ *   any state     --(throttle cut on)--------------------------> CUT
+ *   CUT           --(throttle cut off)-------------------------> WAIT_THROTTLE
+ *
+ * The transmitter starts in WAIT_THROTTLE, so a throttle that is up at
+ * power-on (or when the cut is released) never reaches the model, the stick
+ * has to come back to idle first.
+ *
+ * "At idle" is about the throttle stick, not the output: a throttle curve or
+ * a mix line writing to the throttle may hold the output well away from the
+ * EPA end at the bottom of the stick (throttleStickTravel()). Only host
+ * channels in trainer mode, which skip the curve and the mixer, are measured
+ * from the idle output.
+ *
+ * armingApply() is the very last stage of the channel pipeline: it replaces
+ * the throttle after mixing, flight mode fades and everything else, so a cut
+ * switched on during a tick is in the frame that tick sends.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+// Throttle counts as "at idle" within this many 12-bit steps (~5 %)
+const int ARM_THROTTLE_LOW_BAND = 205;
+
+// How long the throttle has to stay at idle before it's let through
+const uint32_t ARM_THROTTLE_LOW_MS = 100;
+
+enum ArmState : uint8_t {
+    ARM_WAIT_THROTTLE,   // held at idle until the throttle stick is at idle
+    ARM_ARMED,           // throttle passes through
+    ARM_CUT              // held at idle by the throttle cut switch
+};
+
+// What changed in this update, for the buzzer / UI
+enum ArmEvent : uint8_t {
+    ARM_EVT_NONE,
+    ARM_EVT_BLOCKED,     // waiting and the throttle is not at idle (once per wait)
+    ARM_EVT_ARMED,       // armed after ARM_EVT_BLOCKED
+    ARM_EVT_CUT_ON,
+    ARM_EVT_CUT_OFF
+};
+
+struct ArmingState {
+    uint8_t  state;          // ArmState
+    bool     warned;         // ARM_EVT_BLOCKED sent for this wait
+    bool     low;            // throttle was at idle on the last update
+    uint32_t lowSinceMs;     // since when
+};
+
+/**
+ * @brief Power-on state: waiting for the throttle.
+ */
+void armingReset(ArmingState& s);
+
+/**
+ * @brief Steps the state machine, call once per control tick.
+ * @param cut Throttle cut switch.
+ * @param fromIdle Distance of the throttle from idle in 12-bit steps
+ *                 (throttleStickTravel(), or |host throttle - idle| in trainer mode).
+ */
+ArmEvent armingUpdate(ArmingState& s, bool cut, int fromIdle, uint32_t nowMs);
+
+/**
+ * @brief Final pipeline stage: idle throttle (throttleIdleValue(), motor off) unless armed.
+ */
+static inline int armingApply(const ArmingState& s, int throttle, int idle) {
+    return s.state == ARM_ARMED ? throttle : idle;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file Bind.cpp
+ * @author Ebrahim Siami
+ * @brief Bind procedure: per-transmitter NRF24 address from the MCU unique ID
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "Bind.h"
+#include "Radio.h"
+#include "RadioDma.h"
+
+namespace Bind {
+
+enum Phase : uint8_t {
+    PHASE_IDLE,
+    PHASE_ANNOUNCE,     // on the bind link, waiting for a receiver to ACK
+    PHASE_CONFIRM       // on the new link, waiting for the same receiver to ACK there
+};
+
+static Phase    phase = PHASE_IDLE;
+static Binding  binding;
+static uint32_t startMs = 0;
+static uint32_t lastPacketMs = 0;
+static uint32_t confirmMs = 0;
+static uint16_t announced = 0;
+
+// Every PROBE_EVERY-th packet of the ANNOUNCE phase is a CONFIRM on the new link
+static const uint8_t PROBE_EVERY = 4;
+
+// Bytes the NRF24 can't use well in an address: long runs of one level, or the preamble pattern
+static uint8_t fixAddressByte(uint8_t b) {
+    if (b == 0x00 || b == 0xFF || b == 0x55 || b == 0xAA) return b ^ 0x5A;
+    return b;
+}
+
+void derive(const uint32_t uid[3], Binding& out) {
+    uint8_t bytes[12];
+    for (uint8_t i = 0; i < 3; i++) {
+        bytes[4 * i]     = (uint8_t)uid[i];
+        bytes[4 * i + 1] = (uint8_t)(uid[i] >> 8);
+        bytes[4 * i + 2] = (uint8_t)(uid[i] >> 16);
+        bytes[4 * i + 3] = (uint8_t)(uid[i] >> 24);
+    }
+
+    // The UID is mostly lot / wafer / position, so hash all of it into every byte
+    uint32_t h1 = Crc::crc32(bytes, sizeof(bytes));
+    uint32_t h2 = Crc::crc32(bytes, sizeof(bytes), h1 ^ 0xA5C3E1F0UL);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        out.address[i] = fixAddressByte((uint8_t)(h1 >> (8 * i)));
+    }
+    out.address[4] = fixAddressByte((uint8_t)h2);
+    out.hopSeed = (uint8_t)(h2 >> 8);
+}
+
+void readUid(uint32_t uid[3]) {
+    uid[0] = HAL_GetUIDw0();
+    uid[1] = HAL_GetUIDw1();
+    uid[2] = HAL_GetUIDw2();
+}
+
+static void tuneBindLink() {
+    radio.openWritingPipe(BIND_ADDRESS);
+    radio.setChannel(BIND_CHANNEL);
+}
+
+static void tuneNewLink() {
+    radio.openWritingPipe(pipeAddress(binding.address));
+    radio.setChannel(channelOf(binding.hopSeed));
+}
+
+void start(uint32_t nowMs, uint8_t channel) {
+    uint32_t uid[3];
+    readUid(uid);
+    derive(uid, binding);
+    if (channel >= HOP_FIRST && channel < HOP_FIRST + HOP_CHANNELS) {
+        binding.hopSeed = channel - HOP_FIRST;     // channelOf() gives it back
+    }
+
+    // ACKs tell us a receiver took it, low power so it's only the one on the bench
+    RadioDma::finish();
+    radio.setAutoAck(true);
+    radio.setRetries(2, 5);         // 750 us apart, 5 times: ~4 ms worst case per packet
+    radio.setPALevel(RF24_PA_LOW);
+    tuneBindLink();
+
+    phase = PHASE_ANNOUNCE;
+    announced = 0;
+    startMs = nowMs;
+    lastPacketMs = nowMs - PACKET_MS;
+}
+
+void cancel() {
+    phase = PHASE_IDLE;
+}
+
+bool active() {
+    return phase != PHASE_IDLE;
+}
+
+Event poll(uint32_t nowMs) {
+    if (phase == PHASE_IDLE) return BIND_NONE;
+
+    if (nowMs - startMs >= TIMEOUT_MS) {
+        phase = PHASE_IDLE;
+        return BIND_TIMEOUT;
+    }
+    if (nowMs - lastPacketMs < PACKET_MS) return BIND_NONE;
+    lastPacketMs = nowMs;
+
+    // The ACK of an ANNOUNCE can get lost after the receiver took it, so every
+    // few packets look for it on the new link instead
+    bool onNewLink = (phase == PHASE_CONFIRM);
+    if (phase == PHASE_ANNOUNCE && ++announced % PROBE_EVERY == 0) {
+        onNewLink = true;
+        tuneNewLink();
+    }
+
+    uint8_t packet[PACKET_SIZE];
+    makePacket(onNewLink ? PACKET_CONFIRM : PACKET_ANNOUNCE, binding, packet);
+    bool acked = radio.write(packet, PACKET_SIZE);
+
+    if (acked && onNewLink) {
+        phase = PHASE_IDLE;
+        return BIND_DONE;
+    }
+
+    if (phase == PHASE_ANNOUNCE) {
+        if (acked) {
+            // a receiver has it and is moving over, follow it
+            phase = PHASE_CONFIRM;
+            confirmMs = nowMs;
+            tuneNewLink();
+        } else if (onNewLink) {
+            tuneBindLink();
+        }
+    } else if (nowMs - confirmMs >= CONFIRM_MS) {
+        // it didn't make it after all (or it was someone else's receiver), start over
+        phase = PHASE_ANNOUNCE;
+        tuneBindLink();
+    }
+    return BIND_NONE;
+}
+
+const Binding& result() {
+    return binding;
+}
+
+} // namespace Bind
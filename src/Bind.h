@@ -0,0 +1,78 @@
+/**
+ * @file Bind.h
+ * @author Ebrahim Siami
+ * @brief Bind procedure: per-transmitter NRF24 address from the MCU unique ID
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Without binding every transmitter sends on the same fixed address, so two
+ * of them on one field drive each other's receivers. Binding gives the model
+ * an address and a hop seed derived from the 96-bit STM32 UID of this
+ * transmitter, hands them to the receiver over the bind link and stores them
+ * in the model settings (RadioSettings::rfAddress / hopSeed).
+ *
+ * The handshake and the packet are described in bind_format.h. While the
+ * procedure runs the normal NRF24 output is off (main.cpp, applyRfOutput()),
+ * afterwards radioSetLink() tunes the radio to whatever the model has.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "bind_format.h"
+
+namespace Bind {
+
+// Gap between two bind packets, each one waits for its ACK (auto-ack retries)
+const uint32_t PACKET_MS = 20;
+
+// ANNOUNCE acknowledged but nothing on the new link for this long -> announce again
+const uint32_t CONFIRM_MS = 500;
+
+// Give up after this long without a receiver
+const uint32_t TIMEOUT_MS = 30000;
+
+enum Event : uint8_t {
+    BIND_NONE,
+    BIND_DONE,       // the receiver switched to the new link, result() holds it
+    BIND_TIMEOUT     // nobody answered, nothing changed
+};
+
+/**
+ * @brief Address and hop seed of this transmitter, from the 96-bit UID.
+ * Same UID, same result. No address byte is 0x00, 0xFF, 0x55 or 0xAA
+ * (no long runs or preamble look-alikes for the NRF24 address match).
+ */
+void derive(const uint32_t uid[3], Binding& out);
+
+/**
+ * @brief Reads the 96-bit unique ID of the MCU.
+ */
+void readUid(uint32_t uid[3]);
+
+/**
+ * @brief Starts announcing. The NRF24 output must be off (and the radio powered).
+ * @param channel Link channel in the hop range, e.g. the quietest of a channel
+ * survey (Spectrum.h). 0 = the one of the UID.
+ */
+void start(uint32_t nowMs, uint8_t channel = 0);
+
+/**
+ * @brief Stops the procedure, nothing is changed. Call radioSetLink() afterwards.
+ */
+void cancel();
+
+bool active();
+
+/**
+ * @brief Sends the next bind packet when it's time, call from loop() while active().
+ * After BIND_DONE or BIND_TIMEOUT the procedure is over, call radioSetLink().
+ */
+Event poll(uint32_t nowMs);
+
+/**
+ * @brief What start() derived, the one to store after BIND_DONE.
+ */
+const Binding& result();
+
+} // namespace Bind
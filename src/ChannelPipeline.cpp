@@ -0,0 +1,188 @@
+/**
+ * @file ChannelPipeline.cpp
+ * @author Ebrahim Siami
+ * @brief Stick processing: calibration, expo, curves, dual rate, EPA, throttle and mixing
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Moved out of main.cpp unchanged. Any change to the output of these functions
+ * shows up in tools/golden, run it before and after touching anything here.
+ */
+
+#include "ChannelPipeline.h"
+
+int processChannel(int rawValue,
+                   int calibMin, int calibCenter, int calibMax, int deadband,
+                   int expoPercent,
+                   int dualRatePercent,
+                   int subTrimValue,
+                   bool invert,
+                   int epaMin, int epaMax,
+                   const CustomCurve* curve)
+{
+
+    rawValue = constrain(rawValue, calibMin, calibMax);
+    // its really hard to code without you:(
+
+    // --- Step 2: Calibration & Deadband ---
+    int val;
+    if ((calibCenter - calibMin) < 100 || (calibMax - calibCenter) < 100) {
+        return subTrimValue;
+    }
+
+    if (abs(rawValue - calibCenter) <= deadband) {
+        val = 2048;
+    } else if (rawValue < calibCenter) {
+        val = map(rawValue, calibMin, calibCenter - deadband, 0, 2048);
+    } else {
+        val = map(rawValue, calibCenter + deadband, calibMax, 2048, 4095);
+    }
+    val = constrain(val, 0, 4095);
+
+    // --- Step 3: EXPO ---
+    if (expoPercent != 0) {
+        // Normalize to -1.0 to +1.0
+        float normalized = (val - 2048) / 2048.0f;
+
+        // Apply EXPO formula
+        float cube = normalized * normalized * normalized; // i think that its much faster than pow
+        float expo = expoPercent / 100.0f;
+        float output = (1.0f - expo) * normalized + expo * cube;
+
+        // Convert back to 12-bit
+        val = 2048 + (int)(output * 2048.0f);
+    }
+
+    // --- Step 3b: Custom Curve ---
+    // (expo can overshoot the 12-bit range a bit, the curve table can't)
+    if (curve && curve->points) {
+        val = curveEval(*curve, constrain(val, 0, 4095));
+    }
+
+    // --- Step 4: Dual Rate (DR) ---
+    if (dualRatePercent < 100) {
+        long offset = val - 2048;
+        offset = (offset * dualRatePercent) / 100;
+        val = 2048 + offset;
+    }
+
+    // --- Step 5: Reverse ---
+    if (invert) {
+        val = 4095 - val;
+    }
+
+    // --- Step 6: Sub-Trim and EPA (End Point Adjustment) ---
+    int result;
+    if (val <= 2048) {
+        result = map(val, 0, 2048, epaMin, subTrimValue);
+    } else {
+        result = map(val, 2048, 4095, subTrimValue, epaMax);
+    }
+
+    return constrain(result, epaMin, epaMax);
+}
+
+int processThrottle(int rawThrottle, const RadioSettings& settings, int deadband) {
+    int throttle_calibrated;
+    if (abs(rawThrottle - settings.calibCenter[2]) <= deadband) {
+        throttle_calibrated = 2048;
+    } else {
+        throttle_calibrated = map(rawThrottle, settings.calibMin[2], settings.calibMax[2], 0, 4095);
+    }
+
+    int throttle_pre_map = throttle_calibrated;
+    if (settings.airplaneMode) {
+        if (throttle_pre_map < 2048) {
+            throttle_pre_map = 0;
+        } else {
+            throttle_pre_map = map(throttle_pre_map, 2048, 4095, 0, 4095);
+        }
+    }
+
+    // Throttle curve
+    if (settings.stickCurves[2].points) {
+        throttle_pre_map = curveEval(settings.stickCurves[2], constrain(throttle_pre_map, 0, 4095));
+    }
+
+    // Apply final mapping (Reverse, Subtrim, EPA) for throttle
+    if (settings.channelInverted[2]) {
+        throttle_pre_map = 4095 - throttle_pre_map;
+    }
+    int throttle_12b;
+    if (throttle_pre_map <= 2048) {
+        throttle_12b = map(throttle_pre_map, 0, 2048, settings.epaMin[2], settings.subTrim[2]);
+    } else {
+        throttle_12b = map(throttle_pre_map, 2048, 4095, settings.subTrim[2], settings.epaMax[2]);
+    }
+    return constrain(throttle_12b, settings.epaMin[2], settings.epaMax[2]);
+}
+
+int throttleIdleValue(const RadioSettings& settings) {
+    return settings.channelInverted[2] ? settings.epaMax[2] : settings.epaMin[2];
+}
+
+int throttleStickTravel(int rawThrottle, const RadioSettings& settings) {
+    return constrain(map(rawThrottle, settings.calibMin[2], settings.calibMax[2], 0, 4095), 0, 4095);
+}
+
+void applyMix(const RadioSettings& settings, const MixLine lines[MIX_LINES], int ch[MIX_CHANNELS]) {
+    mixerRun(lines, ch);
+
+    ch[MIX_CH_ROLL]     = constrain(ch[MIX_CH_ROLL],     settings.epaMin[0], settings.epaMax[0]);
+    ch[MIX_CH_PITCH]    = constrain(ch[MIX_CH_PITCH],    settings.epaMin[1], settings.epaMax[1]);
+    ch[MIX_CH_THROTTLE] = constrain(ch[MIX_CH_THROTTLE], settings.epaMin[2], settings.epaMax[2]);
+    ch[MIX_CH_YAW]      = constrain(ch[MIX_CH_YAW],      settings.epaMin[3], settings.epaMax[3]);
+    for (uint8_t i = MIX_CH_AUX1; i < MIX_CHANNELS; i++) {
+        ch[i] = constrain(ch[i], 0, 4095);
+    }
+}
+
+void applyMix(const RadioSettings& settings, int ch[MIX_CHANNELS]) {
+    applyMix(settings, settings.mixLines, ch);
+}
+
+void processSticks(const RadioSettings& settings, const StickParams& params, int deadband,
+                   const int raw[STICK_COUNT], int out[STICK_COUNT]) {
+    // --- Process main channels ---
+    out[STICK_ROLL] = processChannel(
+        raw[STICK_ROLL],
+        settings.calibMin[0], settings.calibCenter[0], settings.calibMax[0], deadband,
+        params.expo[0],
+        params.rate[0],
+        params.trim[0],
+        settings.channelInverted[0],
+        settings.epaMin[0], settings.epaMax[0],
+        &settings.stickCurves[0]
+    );
+
+    out[STICK_PITCH] = processChannel(
+        raw[STICK_PITCH],
+        settings.calibMin[1], settings.calibCenter[1], settings.calibMax[1], deadband,
+        params.expo[1],
+        params.rate[1],
+        params.trim[1],
+        settings.channelInverted[1],
+        settings.epaMin[1], settings.epaMax[1],
+        &settings.stickCurves[1]
+    );
+
+    out[STICK_YAW] = processChannel(
+        raw[STICK_YAW],
+        settings.calibMin[3], settings.calibCenter[3], settings.calibMax[3], deadband,
+        params.expo[2],
+        params.rate[2],
+        params.trim[2],
+        settings.channelInverted[3],
+        settings.epaMin[3], settings.epaMax[3],
+        &settings.stickCurves[3]
+    );
+
+    // --- Throttle Logic ---
+    out[STICK_THROTTLE] = processThrottle(raw[STICK_THROTTLE], settings, deadband);
+}
+
+void processSticks(const RadioSettings& settings, int deadband, const int raw[STICK_COUNT], int out[STICK_COUNT]) {
+    StickParams params;
+    flightModeSticks(settings, 0, params);
+    processSticks(settings, params, deadband, raw, out);
+}
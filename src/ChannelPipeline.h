@@ -0,0 +1,87 @@
+/**
+ * @file ChannelPipeline.h
+ * @author Ebrahim Siami
+ * @brief Stick processing: calibration, expo, curves, dual rate, EPA, throttle and mixing
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Everything between the filtered ADC values and the 12-bit channel values
+ * that go to the radio / simulator. No hardware access, so the exact same code
+ * runs in the firmware, the native build and the golden-output tool
+ * (tools/golden), which pins the output of every stage down bit for bit.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "Settings.h"
+
+// Stick channel order inside the pipeline (same as calibMin[] etc. in RadioSettings)
+enum StickChannel : uint8_t { STICK_ROLL, STICK_PITCH, STICK_THROTTLE, STICK_YAW, STICK_COUNT };
+
+/**
+ * @brief The values that change with the flight mode, per axis (Roll, Pitch, Yaw).
+ */
+struct StickParams {
+    int expo[3];          // -100..100
+    int rate[3];          // dual rate %, 100 = off
+    int trim[3];          // sub-trim + digital trim, 12-bit center
+};
+
+/**
+ * @brief Calibration + deadband, expo, curve, dual rate, reverse, sub-trim and EPA of one stick.
+ * @param curve Custom curve applied after expo, nullptr for none.
+ * @return 12-bit channel value, limited to [epaMin, epaMax].
+ */
+int processChannel(int rawValue,
+                   int calibMin, int calibCenter, int calibMax, int deadband,
+                   int expoPercent,
+                   int dualRatePercent,
+                   int subTrimValue,
+                   bool invert,
+                   int epaMin, int epaMax,
+                   const CustomCurve* curve = nullptr);
+
+/**
+ * @brief Throttle path: calibration + deadband, airplane mode, curve, reverse, sub-trim and EPA.
+ */
+int processThrottle(int rawValue, const RadioSettings& settings, int deadband);
+
+/**
+ * @brief Throttle output with the stick at idle (EPA end, the other end if the channel is inverted).
+ */
+int throttleIdleValue(const RadioSettings& settings);
+
+/**
+ * @brief How far the throttle stick is from its idle end, 0..4095: calibration
+ * only, before airplane mode, curve, reverse, EPA and the mixer. A throttle curve
+ * or a mix line can keep the output away from throttleIdleValue() at the bottom
+ * of the stick, this can't.
+ */
+int throttleStickTravel(int rawThrottle, const RadioSettings& settings);
+
+/**
+ * @brief Programmable mixer and the final limits.
+ * @param lines Mixer lines to run (settings.mixLines, or a flight mode's table).
+ * @param ch All 8 channels in MixChannel order, mixed in place. Sticks are
+ *           limited to their EPA, aux channels to 0..4095.
+ */
+void applyMix(const RadioSettings& settings, const MixLine lines[MIX_LINES], int ch[MIX_CHANNELS]);
+
+/**
+ * @brief applyMix() with the model's own mixer lines.
+ */
+void applyMix(const RadioSettings& settings, int ch[MIX_CHANNELS]);
+
+/**
+ * @brief Per-stick part of the pipeline for one control tick (before applyMix()).
+ * @param raw Filtered ADC values in StickChannel order.
+ * @param out 12-bit channel values in StickChannel order.
+ */
+void processSticks(const RadioSettings& settings, const StickParams& params, int deadband,
+                   const int raw[STICK_COUNT], int out[STICK_COUNT]);
+
+/**
+ * @brief processSticks() with the expo, dual rate and trims of flight mode 0.
+ */
+void processSticks(const RadioSettings& settings, int deadband, const int raw[STICK_COUNT], int out[STICK_COUNT]);
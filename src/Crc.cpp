@@ -0,0 +1,120 @@
+/**
+ * @file Crc.cpp
+ * @author Ebrahim Siami
+ * @brief Table-driven CRC routines
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * The lookup tables are generated by the compiler (constexpr) so they end up
+ * in flash as plain const data, no startup cost and no hand-typed magic numbers.
+ */
+
+#include "Crc.h"
+
+namespace Crc {
+
+namespace {
+
+// T[0] is the classic byte table, T[k][b] is the CRC of byte b followed by k zero bytes
+struct Crc8Tables {
+#if defined(CRC8_SLICE_BY_4)
+    static const int SLICES = 4;
+#else
+    static const int SLICES = 1;
+#endif
+    uint8_t t[SLICES][256];
+    constexpr Crc8Tables() : t() {
+        for (int i = 0; i < 256; i++) {
+            uint8_t c = (uint8_t)i;
+            for (int b = 0; b < 8; b++)
+                c = (c & 0x80) ? (uint8_t)((c << 1) ^ 0x07) : (uint8_t)(c << 1);
+            t[0][i] = c;
+        }
+        for (int k = 1; k < SLICES; k++)
+            for (int i = 0; i < 256; i++)
+                t[k][i] = t[0][t[k - 1][i]];
+    }
+};
+
+struct Crc8DvbS2Table {
+    uint8_t v[256];
+    constexpr Crc8DvbS2Table() : v() {
+        for (int i = 0; i < 256; i++) {
+            uint8_t c = (uint8_t)i;
+            for (int b = 0; b < 8; b++)
+                c = (c & 0x80) ? (uint8_t)((c << 1) ^ 0xD5) : (uint8_t)(c << 1);
+            v[i] = c;
+        }
+    }
+};
+
+struct Crc16Table {
+    uint16_t v[256];
+    constexpr Crc16Table() : v() {
+        for (int i = 0; i < 256; i++) {
+            uint16_t c = (uint16_t)(i << 8);
+            for (int b = 0; b < 8; b++)
+                c = (c & 0x8000) ? (uint16_t)((c << 1) ^ 0x1021) : (uint16_t)(c << 1);
+            v[i] = c;
+        }
+    }
+};
+
+struct Crc32Table {
+    uint32_t v[256];
+    constexpr Crc32Table() : v() {
+        for (int i = 0; i < 256; i++) {
+            uint32_t c = (uint32_t)i;
+            for (int b = 0; b < 8; b++)
+                c = (c & 1) ? (c >> 1) ^ 0xEDB88320UL : (c >> 1);
+            v[i] = c;
+        }
+    }
+};
+
+constexpr Crc8Tables CRC8_TABLES;
+constexpr Crc8DvbS2Table CRC8_DVB_S2_TABLE;
+constexpr Crc16Table CRC16_TABLE;
+constexpr Crc32Table CRC32_TABLE;
+
+} // namespace
+
+uint8_t crc8(const uint8_t* data, size_t len, uint8_t crc) {
+#if defined(CRC8_SLICE_BY_4)
+    // CRC-8 is linear, so 4 bytes can be folded in with 4 independent lookups
+    const uint8_t (*t)[256] = CRC8_TABLES.t;
+    while (len >= 4) {
+        crc = t[3][crc ^ data[0]] ^ t[2][data[1]] ^ t[1][data[2]] ^ t[0][data[3]];
+        data += 4;
+        len -= 4;
+    }
+#endif
+    while (len--) {
+        crc = CRC8_TABLES.t[0][crc ^ *data++];
+    }
+    return crc;
+}
+
+uint8_t crc8DvbS2(const uint8_t* data, size_t len, uint8_t crc) {
+    while (len--) {
+        crc = CRC8_DVB_S2_TABLE.v[crc ^ *data++];
+    }
+    return crc;
+}
+
+uint16_t crc16(const uint8_t* data, size_t len, uint16_t crc) {
+    while (len--) {
+        crc = (uint16_t)((crc << 8) ^ CRC16_TABLE.v[((crc >> 8) ^ *data++) & 0xFF]);
+    }
+    return crc;
+}
+
+uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc) {
+    crc = ~crc;
+    while (len--) {
+        crc = (crc >> 8) ^ CRC32_TABLE.v[(crc ^ *data++) & 0xFF];
+    }
+    return ~crc;
+}
+
+} // namespace Crc
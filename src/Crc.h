@@ -0,0 +1,56 @@
+/**
+ * @file Crc.h
+ * @author Ebrahim Siami
+ * @brief Table-driven CRC routines
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Small CRC toolbox shared by the settings storage and the data protocols.
+ * All routines are incremental: pass the previous result back in as 'crc'
+ * to continue a running checksum over several buffers.
+ *
+ * - CRC-8/SMBUS        (poly 0x07, init 0x00), used by the simulator protocol
+ * - CRC-8/DVB-S2       (poly 0xD5, init 0x00), used by the CRSF output
+ * - CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ * - CRC-32/ISO-HDLC    (poly 0x04C11DB7 reflected, init/xorout 0xFFFFFFFF)
+ *
+ * CRC-8 runs from a 256-entry table by default. Build with -D CRC8_SLICE_BY_4
+ * to process 4 bytes per step (1 KB of tables instead of 256 bytes).
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Crc {
+
+const uint8_t  CRC8_INIT  = 0x00;
+const uint16_t CRC16_INIT = 0xFFFF;
+const uint32_t CRC32_INIT = 0x00000000;
+
+/**
+ * @brief Continues a CRC-8 (poly 0x07) over 'len' bytes.
+ * @param crc Previous result, or CRC8_INIT for a new checksum.
+ */
+uint8_t crc8(const uint8_t* data, size_t len, uint8_t crc = CRC8_INIT);
+
+/**
+ * @brief Continues a CRC-8/DVB-S2 (poly 0xD5) over 'len' bytes, the CRSF frame check.
+ * @param crc Previous result, or CRC8_INIT for a new checksum.
+ */
+uint8_t crc8DvbS2(const uint8_t* data, size_t len, uint8_t crc = CRC8_INIT);
+
+/**
+ * @brief Continues a CRC-16/CCITT-FALSE over 'len' bytes.
+ * @param crc Previous result, or CRC16_INIT for a new checksum.
+ */
+uint16_t crc16(const uint8_t* data, size_t len, uint16_t crc = CRC16_INIT);
+
+/**
+ * @brief Continues a CRC-32 (zlib/PNG compatible) over 'len' bytes.
+ * @param crc Previous result, or CRC32_INIT for a new checksum.
+ */
+uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = CRC32_INIT);
+
+} // namespace Crc
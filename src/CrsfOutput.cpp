@@ -0,0 +1,145 @@
+/**
+ * @file CrsfOutput.cpp
+ * @author Ebrahim Siami
+ * @brief CRSF output to an external module (ExpressLRS, TBS Crossfire) over UART + DMA
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "CrsfOutput.h"
+#include "Crc.h"
+#include "LatencyTrace.h"
+
+namespace Crsf {
+
+static_assert(OUTPUT_CHANNELS == CHANNELS, "A channel frame has to fill the CRSF frame exactly");
+
+// One constructor argument = half-duplex on that pin (STM32duino)
+static HardwareSerial uart(CRSF_UART_PIN);
+
+// The DMA reads from here while the frame goes out, only touched when it's idle
+static uint8_t frame[FRAME_SIZE];
+
+static bool running = false;
+static uint32_t sent = 0;
+static uint32_t dropped = 0;
+
+// =============================================================================
+// --- TX DMA ---
+// =============================================================================
+
+#if defined(STM32F1xx)
+
+// Set from dmaStart() until the last stop bit of the frame is out, the line is ours meanwhile
+static volatile bool transmitting = false;
+
+// USART3_TX is wired to DMA1 channel 2 on the F103
+static void dmaBegin() {
+    RCC->AHBENR |= RCC_AHBENR_DMA1EN;
+    DMA1_Channel2->CCR = 0;
+    DMA1_Channel2->CPAR = (uint32_t)&USART3->DR;
+    USART3->CR3 |= USART_CR3_DMAT;
+    NVIC_SetPriority(DMA1_Channel2_IRQn, 15);   // lowest, it only hands the line back
+    NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+}
+
+static void dmaEnd() {
+    NVIC_DisableIRQ(DMA1_Channel2_IRQn);
+    DMA1_Channel2->CCR = 0;
+    USART3->CR3 &= ~USART_CR3_DMAT;
+}
+
+static bool dmaBusy() {
+    return transmitting;
+}
+
+// In half-duplex the core only turns the transmitter on inside write(), so take
+// the line here: HAL_HalfDuplex_EnableTransmitter() in register form
+static void dmaStart(const uint8_t* data, size_t len) {
+    USART3->CR1 = (USART3->CR1 & ~USART_CR1_RE) | USART_CR1_TE;
+    USART3->SR = ~USART_SR_TC;               // rc_w0: TC now means "this frame is out"
+    transmitting = true;
+
+    DMA1_Channel2->CCR = 0;                  // has to be off to load a new count
+    DMA1->IFCR = DMA_IFCR_CGIF2;
+    DMA1_Channel2->CMAR = (uint32_t)data;
+    DMA1_Channel2->CNDTR = len;
+    DMA1_Channel2->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE | DMA_CCR_EN;   // memory -> USART, bytes
+}
+
+// The DMA is done once the last byte is in DR, that one and the one in the
+// shift register still go out (2 x 25 us at 400 kbaud). The USART3 interrupt
+// belongs to the core, so wait for TC here, then listen again like the core
+// does after write().
+extern "C" void DMA1_Channel2_IRQHandler() {
+    DMA1->IFCR = DMA_IFCR_CGIF2;
+    DMA1_Channel2->CCR = 0;
+    while (!(USART3->SR & USART_SR_TC)) {}
+    USART3->CR1 = (USART3->CR1 & ~USART_CR1_TE) | USART_CR1_RE;
+    transmitting = false;
+}
+
+#else
+
+// No DMA on the host, the native UART takes the whole frame at once
+static void dmaBegin() {}
+static void dmaEnd() {}
+static bool dmaBusy() { return false; }
+static void dmaStart(const uint8_t* data, size_t len) { uart.write(data, len); }
+
+#endif
+
+// =============================================================================
+// --- Functions ---
+// =============================================================================
+
+void begin() {
+    if (running) return;
+    uart.begin(BAUD);
+    dmaBegin();
+    running = true;
+}
+
+void end() {
+    if (!running) return;
+    while (dmaBusy()) {}                     // never cut a frame in half, waits for TC
+    dmaEnd();
+    uart.end();
+    running = false;
+}
+
+void buildRcFrame(const uint16_t ch[CHANNELS], uint8_t out[FRAME_SIZE]) {
+    out[0] = ADDR_MODULE;
+    out[1] = FRAME_LEN;
+    out[2] = TYPE_RC_CHANNELS;
+    packChannels(ch, &out[3]);
+    out[FRAME_SIZE - 1] = Crc::crc8DvbS2(&out[2], FRAME_SIZE - 3);
+}
+
+bool send(const uint16_t ch[CHANNELS]) {
+    if (!running) return false;
+    if (dmaBusy()) {
+        dropped++;
+        return false;
+    }
+
+    uint16_t values[CHANNELS];
+    for (uint8_t i = 0; i < CHANNELS; i++) {
+        values[i] = from12bit(ch[i]);
+    }
+    buildRcFrame(values, frame);
+    dmaStart(frame, FRAME_SIZE);
+    sent++;
+    return true;
+}
+
+uint32_t framesSent() { return sent; }
+uint32_t framesDropped() { return dropped; }
+
+static void writeFrame(const ChannelFrame& frame) {
+    if (send(frame.ch)) LatencyTrace::mark(SimProto::LAT_RADIO);
+}
+
+OutputSink sink("CRSF", 1000000UL / RATE_DEFAULT_HZ, writeFrame);
+
+} // namespace Crsf
@@ -0,0 +1,69 @@
+/**
+ * @file CrsfOutput.h
+ * @author Ebrahim Siami
+ * @brief CRSF output to an external module (ExpressLRS, TBS Crossfire) over UART + DMA
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Alternative to the NRF24: the processed channels go out as CRSF
+ * RC_CHANNELS_PACKED frames (see crsf_format.h) on USART3, the module plugs
+ * into PB10 like into the S.Port pin of a JR bay.
+ *
+ * send() only packs the frame and hands it to DMA1 channel 2, the bytes go
+ * out on their own while the loop carries on. A frame takes 650 us at
+ * 400 kbaud, so even at 500 Hz the DMA is idle again long before the next one.
+ *
+ * The line is half-duplex like on the module bay: the transmitter is on from
+ * the start of a frame until its last stop bit is out (DMA transfer complete,
+ * then USART TC), the rest of the time the pin is released and listens.
+ * Telemetry coming back from the module is not read (yet).
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "crsf_format.h"
+#include "Outputs.h"
+
+// Single-wire half-duplex UART to the module (USART3 TX)
+#define CRSF_UART_PIN PB10
+
+namespace Crsf {
+
+// Frame rates offered in the menu, the module has to be set to a packet rate that keeps up
+const uint16_t RATE_MIN_HZ = 150;
+const uint16_t RATE_MAX_HZ = 500;
+const uint16_t RATE_DEFAULT_HZ = 250;
+
+/**
+ * @brief Starts the UART and the TX DMA channel.
+ */
+void begin();
+
+/**
+ * @brief Stops the DMA and releases the pin, after the frame on the wire is out completely.
+ */
+void end();
+
+/**
+ * @brief Sends one RC channels frame.
+ * @param ch 12-bit channels (0..4095).
+ * @return false if the previous frame was still going out (frame dropped).
+ */
+bool send(const uint16_t ch[CHANNELS]);
+
+/**
+ * @brief Builds the 26-byte RC channels frame from CRSF channel values.
+ */
+void buildRcFrame(const uint16_t ch[CHANNELS], uint8_t frame[FRAME_SIZE]);
+
+/**
+ * @brief Frames handed to the DMA / dropped because it was still busy.
+ */
+uint32_t framesSent();
+uint32_t framesDropped();
+
+// Output sink, rate set with outputSetRate() from RadioSettings::crsfRateHz
+extern OutputSink sink;
+
+} // namespace Crsf
@@ -0,0 +1,46 @@
+/**
+ * @file Curves.cpp
+ * @author Ebrahim Siami
+ * @brief User editable 5/9/17-point curves for the stick channels
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "Curves.h"
+
+bool curveValidPoints(uint8_t points) {
+    return points == 0 || points == 5 || points == 9 || points == 17;
+}
+
+void curveBuild(CustomCurve& c) {
+    switch (c.points) {
+        case 5:  c.shift = 10; break;   // 4 segments of 1024
+        case 9:  c.shift = 9;  break;   // 8 segments of 512
+        case 17: c.shift = 8;  break;   // 16 segments of 256
+        default: c.points = 0; c.shift = 0; return;
+    }
+
+    for (uint8_t i = 0; i < c.points; i++) {
+        int percent = constrain((int)c.y[i], -100, 100);
+        c.value[i] = constrain(2048 + percent * 2048 / 100, 0, 4095);
+    }
+    for (uint8_t i = 0; i + 1 < c.points; i++) {
+        c.slope[i] = c.value[i + 1] - c.value[i];
+    }
+}
+
+void curveSetPoints(CustomCurve& c, uint8_t points) {
+    if (!curveValidPoints(points)) return;
+
+    // Sample the old shape at the new point positions
+    int8_t y[CURVE_MAX_POINTS] = { 0 };
+    for (uint8_t i = 0; points && i < points; i++) {
+        int x = constrain(i * 4096 / (points - 1), 0, 4095);
+        int v = curveEval(c, x) - 2048;
+        y[i] = (int8_t)constrain((v * 100 + (v < 0 ? -1024 : 1024)) / 2048, -100, 100);
+    }
+
+    c.points = points;
+    memcpy(c.y, y, sizeof(y));
+    curveBuild(c);
+}
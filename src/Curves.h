@@ -0,0 +1,59 @@
+/**
+ * @file Curves.h
+ * @author Ebrahim Siami
+ * @brief User editable 5/9/17-point curves for the stick channels
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * A curve is a list of evenly spaced points over the whole 12-bit stick
+ * travel, each point stored as -100..100 %. Because 5, 9 and 17 points give
+ * 4, 8 and 16 segments, every segment is a power of two wide (1024, 512, 256
+ * steps) and finding the segment is a shift. curveBuild() converts the points
+ * to 12-bit values and per-segment slopes once, after that curveEval() is one
+ * multiply and two shifts (piecewise linear, no float, no division).
+ */
+
+#pragma once
+#include <Arduino.h>
+
+const uint8_t CURVE_MAX_POINTS = 17;
+const uint8_t CURVE_CHANNELS = 4;       // Roll, Pitch, Throttle, Yaw (same order as calibMin[])
+
+struct CustomCurve {
+    uint8_t points;                        // 0 = off (linear), 5, 9 or 17
+    int8_t  y[CURVE_MAX_POINTS];           // -100..100 %, the part that is edited and stored
+
+    // --- Derived by curveBuild(), not stored ---
+    uint8_t shift;                         // log2 of the segment width
+    int16_t value[CURVE_MAX_POINTS];       // points as 12-bit values
+    int16_t slope[CURVE_MAX_POINTS - 1];   // value[i + 1] - value[i]
+};
+
+/**
+ * @brief True for 0 (off), 5, 9 and 17.
+ */
+bool curveValidPoints(uint8_t points);
+
+/**
+ * @brief Recomputes the 12-bit points and slopes after 'points' or 'y' changed.
+ * An invalid point count turns the curve off.
+ */
+void curveBuild(CustomCurve& c);
+
+/**
+ * @brief Changes the number of points, resampling the current shape
+ * (a curve that was off becomes a straight line).
+ */
+void curveSetPoints(CustomCurve& c, uint8_t points);
+
+/**
+ * @brief Maps a 12-bit value (0..4095) through the curve.
+ */
+static inline int curveEval(const CustomCurve& c, int x) {
+    if (c.points == 0) return x;
+
+    int i = x >> c.shift;
+    int frac = x & ((1 << c.shift) - 1);
+    return c.value[i] + ((c.slope[i] * frac) >> c.shift);
+}
@@ -16,8 +16,13 @@
 
 #include "DisplayManager.h"
 #include <Wire.h>
-#include "Buzzer.h"
+#include "buzzer.h"
 #include "Radio.h"
+#include "Arming.h"
+#include "Trainer.h"
+#include "Bind.h"
+#include "PowerControl.h"
+#include "Spectrum.h"
 
 // =============================================================================
 // --- Graphics Assets ---
@@ -49,8 +54,18 @@ Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 // --- very strange externs! ---
 // =============================================================================
 extern bool simulatorMode;
+extern bool trainerMode;
 extern bool isDREditMode;
 extern uint8_t calibStep;
+extern int curveMenuIndex, curveChannel, curvePoint;
+extern bool isCurveEditMode;
+extern FlightModeState flightModeState;
+extern int filteredChannels[6];
+extern int lsMenuIndex, lsIndex;
+extern bool isLsEditMode;
+extern uint32_t lsState;
+extern ArmingState armingState;
+extern int spectrumMenuIndex;
 
 // =============================================================================
 // --- Initialization & Helper Functions ---
@@ -210,6 +225,23 @@ static void drawTrimIndicator(int x, int y, int trimValue) {
     }
 }
 
+// ==========================================
+// -- Helper: Print Logical Switch Reference --
+// ==========================================
+static void printLsRef(uint8_t ref) {
+    uint8_t bit = ref & ~LS_REF_NOT;
+    bool inverted = ref & LS_REF_NOT;
+
+    if (bit == LS_REF_NONE || bit >= LS_REF_COUNT) {
+        display.print(inverted ? "ON" : "-");
+        return;
+    }
+    if (inverted) display.print("!");
+    if (bit == LS_REF_AUX3)      display.print("Aux3");
+    else if (bit == LS_REF_AUX4) display.print("Aux4");
+    else { display.print("L"); display.print(bit - LS_REF_L1 + 1); }
+}
+
 // =============================================================================
 // --- Main Rendering Engine ---
 // =============================================================================
@@ -266,6 +298,7 @@ void drawCurrentPage(
     int16_t boundX, boundY;
     uint16_t boundW, boundH;
     int navOptionsY = SCREEN_HEIGHT - 9;
+    uint8_t fm = flightModeState.active;   // trims, rates, expo and mix shown are the ones of this mode
 
     switch (currentPage) {
 
@@ -305,7 +338,17 @@ void drawCurrentPage(
             // -- Radio Status Indicator --
             // ==========================================
             display.setCursor(80, topY + 2);
-            if (getRadioStatus()) {
+            if (settings.rfOutput == RF_OUTPUT_CRSF) {
+                display.print("TX:CRSF");   // external module, the NRF24 is off
+            } else if (Bind::active()) {
+                display.print("TX:BIND");   // no channels on the air meanwhile
+            } else if (getRadioStatus() && settings.rfAdaptivePower) {
+                // PA level of the adaptive power control, '?' = the receiver doesn't ACK, stays at MAX
+                static const char* const PA_NAMES[] = { "MIN", "LOW", "HI", "MAX" };
+                display.print("PA:");
+                display.print(PA_NAMES[PowerControl::level()]);
+                if (!PowerControl::receiverAcks()) display.print("?");
+            } else if (getRadioStatus()) {
                 display.print("TX:OK");
             } else {
                 // Blink the error so the user notices!
@@ -394,8 +437,10 @@ void drawCurrentPage(
                 display.setTextColor(SSD1306_WHITE);
             }
 
-            // Print ON or OFF
-            if (settings.dualRateEnabled) {
+            // Print ON or OFF (modes 1-3 have their own rates, show the mode instead)
+            if (settings.flightModesEnabled && fm != 0) {
+                display.print("MODE:"); display.print(fm);
+            } else if (settings.dualRateEnabled) {
                 display.print("D/R:ON "); // Extra space for clearing pixels
             } else {
                 display.print("D/R:OFF");
@@ -410,16 +455,35 @@ void drawCurrentPage(
             display.print("T:");
             
             // Draw trim indicators (T1, T2, T3)
-            drawTrimIndicator(35, row3Y + 3, settings.trim1);
-            drawTrimIndicator(45, row3Y + 3, settings.trim2);
-            drawTrimIndicator(55, row3Y + 3, settings.trim3);
+            drawTrimIndicator(35, row3Y + 3, flightModeTrim(settings, fm, 0));
+            drawTrimIndicator(45, row3Y + 3, flightModeTrim(settings, fm, 1));
+            drawTrimIndicator(55, row3Y + 3, flightModeTrim(settings, fm, 2));
             
             // Draw mix mode on the right side
             display.setCursor(75, row3Y);
             display.print("MIX:");
             const char* mixNames[] = {"NRM", "VT A", "VT B", "DL A", "DL B"};
-            if (settings.mixMode >= 0 && settings.mixMode <= 4) {
-                display.print(mixNames[settings.mixMode]);
+            uint8_t mix = flightModeMix(settings, fm);
+            if (mix == FLIGHT_MODE_MIX_BASE) mix = settings.mixMode;
+            if (mix < sizeof(mixNames) / sizeof(mixNames[0])) {
+                display.print(mixNames[mix]);
+            }
+
+            // ==========================================
+            // -- Throttle Interlock (bottom left) --
+            // ==========================================
+            if (armingState.state == ARM_CUT) {
+                display.setCursor(2, 54);
+                display.print("CUT");
+            } else if (armingState.state == ARM_WAIT_THROTTLE && millis() % 1000 < 500) {
+                display.setCursor(2, 54);
+                display.print("THR!");   // throttle is held at idle until the stick is down
+            }
+
+            // Trainer: host in control, blinking while it's quiet and the sticks are
+            if (trainerMode && (Trainer::linkUp() || millis() % 1000 < 500)) {
+                display.setCursor(30, 54);
+                display.print(Trainer::linkUp() ? "USB" : "USB?");
             }
 
             // ==========================================
@@ -470,10 +534,10 @@ void drawCurrentPage(
             
             display.drawLine(lineX1, lineY1, lineX1 + lineWidth, lineY1, SSD1306_WHITE); // Axis line
             display.drawFastVLine(map(2048, 0, 4095, lineX1, lineX1 + lineWidth), lineY1 - 2, 5, SSD1306_WHITE); // Center tick
-            display.fillRect(map(settings.trim1, 0, 4095, lineX1, lineX1 + lineWidth) - 1, lineY1 - 3, 3, 7, SSD1306_WHITE); // Cursor
+            display.fillRect(map(flightModeTrim(settings, fm, 0), 0, 4095, lineX1, lineX1 + lineWidth) - 1, lineY1 - 3, 3, 7, SSD1306_WHITE); // Cursor
             
             display.setCursor(lineX1 + lineWidth + 5, trimY1);
-            display.print(map(settings.trim1, 0, 4095, 0, 100)); display.print("%");
+            display.print(map(flightModeTrim(settings, fm, 0), 0, 4095, 0, 100)); display.print("%");
 
             // -- Trim 2 Visualization --
             int trimY2 = 16;
@@ -482,10 +546,10 @@ void drawCurrentPage(
             
             display.drawLine(lineX2, lineY2, lineX2 + lineWidth, lineY2, SSD1306_WHITE);
             display.drawFastVLine(map(2048, 0, 4095, lineX2, lineX2 + lineWidth), lineY2 - 2, 5, SSD1306_WHITE);
-            display.fillRect(map(settings.trim2, 0, 4095, lineX2, lineX2 + lineWidth) - 1, lineY2 - 3, 3, 7, SSD1306_WHITE);
+            display.fillRect(map(flightModeTrim(settings, fm, 1), 0, 4095, lineX2, lineX2 + lineWidth) - 1, lineY2 - 3, 3, 7, SSD1306_WHITE);
             
             display.setCursor(lineX2 + lineWidth + 5, trimY2);
-            display.print(map(settings.trim2, 0, 4095, 0, 100)); display.print("%");
+            display.print(map(flightModeTrim(settings, fm, 1), 0, 4095, 0, 100)); display.print("%");
 
             // -- Trim 3 Visualization --
             int trimY3 = 29;
@@ -494,10 +558,10 @@ void drawCurrentPage(
             
             display.drawLine(lineX3, lineY3, lineX3 + lineWidth, lineY3, SSD1306_WHITE);
             display.drawFastVLine(map(2048, 0, 4095, lineX3, lineX3 + lineWidth), lineY3 - 2, 5, SSD1306_WHITE);
-            display.fillRect(map(settings.trim3, 0, 4095, lineX3, lineX3 + lineWidth) - 1, lineY3 - 3, 3, 7, SSD1306_WHITE);
+            display.fillRect(map(flightModeTrim(settings, fm, 2), 0, 4095, lineX3, lineX3 + lineWidth) - 1, lineY3 - 3, 3, 7, SSD1306_WHITE);
             
             display.setCursor(lineX3 + lineWidth + 5, trimY3);
-            display.print(map(settings.trim3, 0, 4095, 0, 100)); display.print("%");
+            display.print(map(flightModeTrim(settings, fm, 2), 0, 4095, 0, 100)); display.print("%");
 
             // -- "Save Trims" Button --
             int resetTrimsY = 42;
@@ -530,9 +594,9 @@ void drawCurrentPage(
             display.setTextSize(1);
 
             for (int i = 0; i < SETTING_TOTAL - 2; i++) {
-                int y = 8 * i + 4;
+                int y = 7 * i + 3;   // 7 rows have to fit above the footer
                 if (i == settingsMenuIndex) {
-                    display.fillRect(0, y - 1, SCREEN_WIDTH, 9, SSD1306_WHITE);
+                    display.fillRect(0, y - 1, SCREEN_WIDTH, 8, SSD1306_WHITE);
                     display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
                 } else {
                     display.setTextColor(SSD1306_WHITE);
@@ -552,6 +616,14 @@ void drawCurrentPage(
                         display.print("Thr Mode: ");
                         display.print(settings.airplaneMode ? "AIR" : "NRM");
                         break;
+                    case SETTING_FLIGHT_MODES:
+                        display.print("Flt Modes: ");
+                        if (settings.flightModesEnabled) {
+                            display.print(settings.flightModeFadeMs / 1000.0f, 1); display.print("s");
+                        } else {
+                            display.print("Off");
+                        }
+                        break;
                     case SETTING_INFO:
                         display.print("About / Info >"); break;
                 }
@@ -570,10 +642,17 @@ void drawCurrentPage(
             pageDisplayName = "Features";
             display.setTextSize(1);
 
-            for (int i = 0; i < FEATURE_BACK; i++) {
-                int y = 8 * i + 4;
+            // 7 rows fit above the footer, scroll when the cursor goes past them
+            const int VISIBLE_ROWS = 7;
+            int firstRow = 0;
+            if (featuresMenuIndex >= VISIBLE_ROWS && featuresMenuIndex < FEATURE_BACK) {
+                firstRow = featuresMenuIndex - VISIBLE_ROWS + 1;
+            }
+
+            for (int i = firstRow; i < FEATURE_BACK && i < firstRow + VISIBLE_ROWS; i++) {
+                int y = 7 * (i - firstRow) + 3;
                 if (i == featuresMenuIndex) {
-                    display.fillRect(0, y - 1, SCREEN_WIDTH, 9, SSD1306_WHITE);
+                    display.fillRect(0, y - 1, SCREEN_WIDTH, 8, SSD1306_WHITE);
                     display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
                 } else {
                     display.setTextColor(SSD1306_WHITE);
@@ -582,19 +661,57 @@ void drawCurrentPage(
                 display.setCursor(5, y);
                 switch(i) {
                     case FEATURE_EXPO:              display.print("Expo >"); break;
+                    case FEATURE_CURVES:            display.print("Curves >"); break;
+                    case FEATURE_LOGIC_SWITCHES:    display.print("Logical Switches >"); break;
                     case FEATURE_DUAL_RATE:         display.print("Dual Rate >"); break;
                     case FEATURE_CHANNEL_ADVANCED:  display.print("Channel Advanced >"); break;
                     case FEATURE_CALIBRATION:       display.print("Calibration >"); break;
                     case FEATURE_CHANNELS_MIX: {
                         display.print("Channels Mix: ");
                         const char* mixNames[] = {"Normal", "VTL A", "VTL B", "DLT A", "DLT B"};
-                        if (settings.mixMode >= 0 && settings.mixMode <= 4) {
-                            display.print(mixNames[settings.mixMode]);
+                        uint8_t mix = flightModeMix(settings, fm);
+                        if (mix == FLIGHT_MODE_MIX_BASE) {
+                            display.print("Base");
+                        } else if (mix < sizeof(mixNames) / sizeof(mixNames[0])) {
+                            display.print(mixNames[mix]);
                         } else {     
                             display.print("Unknown");
                         }
                         break; // damnit i forgot to add a {} here haha, jews fault!
                 }
+                    case FEATURE_RF_OUTPUT:
+                        display.print("RF Out: ");
+                        if (settings.rfOutput == RF_OUTPUT_CRSF) {
+                            display.print("CRSF "); display.print(settings.crsfRateHz); display.print("Hz");
+                        } else {
+                            display.print("NRF24");
+                            if (settings.rfRedundancy) { display.print(" x"); display.print(settings.rfRedundancy + 1); }
+                        }
+                        break;
+                    case FEATURE_TX_POWER:
+                        display.print("TX Power: ");
+                        if (!settings.rfAdaptivePower) {
+                            display.print("Max");
+                        } else {
+                            display.print("Auto");
+                            if (PowerControl::receiverAcks()) {   // estimated battery runtime against a fixed MAX
+                                display.print(" +");
+                                display.print(PowerControl::runtimeGainPercent());
+                                display.print("%");
+                            }
+                        }
+                        break;
+                    case FEATURE_BIND:
+                        display.print("Bind: ");
+                        if (Bind::active()) display.print(millis() % 1000 < 500 ? "Binding..." : "");
+                        else display.print(Bind::isBound(settings.rfAddress) ? "Own ID" : "Legacy");
+                        break;
+                    case FEATURE_SPECTRUM:          display.print("Spectrum >"); break;
+                    case FEATURE_TRAINER:
+                        display.print("Trainer USB: ");
+                        if (!trainerMode) display.print("Off");
+                        else display.print(Trainer::linkUp() ? "Link" : "Wait");
+                        break;
                     case FEATURE_SIMULATOR:
                         display.print("Simulator Mode: ");
                         display.print(simulatorMode ? "On" : "Off");
@@ -628,10 +745,10 @@ void drawCurrentPage(
             display.print("Roll: ");
             if (!(drMenuIndex == 2 && isDREditMode && (millis() % 1000 < 500))) {
                 display.setCursor(45, 6);
-                if(settings.dualRateRoll < 100) display.print(" ");
-                display.print(settings.dualRateRoll); display.print("%");
+                if(flightModeRate(settings, fm, 0) < 100) display.print(" ");
+                display.print(flightModeRate(settings, fm, 0)); display.print("%");
             }
-            drawDRBar(6, settings.dualRateRoll);
+            drawDRBar(6, flightModeRate(settings, fm, 0));
 
             // --- PITCH (Index 3) ---
             if (drMenuIndex == 3) {
@@ -643,10 +760,10 @@ void drawCurrentPage(
             display.print("Pitch:");
             if (!(drMenuIndex == 3 && isDREditMode && (millis() % 1000 < 500))) {
                 display.setCursor(45, 18);
-                if(settings.dualRatePitch < 100) display.print(" ");
-                display.print(settings.dualRatePitch); display.print("%");
+                if(flightModeRate(settings, fm, 1) < 100) display.print(" ");
+                display.print(flightModeRate(settings, fm, 1)); display.print("%");
             }
-            drawDRBar(18, settings.dualRatePitch);
+            drawDRBar(18, flightModeRate(settings, fm, 1));
 
             // --- YAW (Index 4) ---
             if (drMenuIndex == 4) {
@@ -658,10 +775,10 @@ void drawCurrentPage(
             display.print("Yaw:  ");
             if (!(drMenuIndex == 4 && isDREditMode && (millis() % 1000 < 500))) {
                 display.setCursor(45, 30);
-                if(settings.dualRateYaw < 100) display.print(" ");
-                display.print(settings.dualRateYaw); display.print("%");
+                if(flightModeRate(settings, fm, 2) < 100) display.print(" ");
+                display.print(flightModeRate(settings, fm, 2)); display.print("%");
             }
-            drawDRBar(30, settings.dualRateYaw);
+            drawDRBar(30, flightModeRate(settings, fm, 2));
 
             display.drawFastHLine(0, 43, SCREEN_WIDTH, SSD1306_WHITE);
 
@@ -963,7 +1080,7 @@ void drawCurrentPage(
             display.print("Roll:");
 
             if (!(expoMenuIndex == 1 && isExpoEditMode && (millis() % 1000 < 500))) {
-                String valStr = String(settings.expoRoll) + "%";
+                String valStr = String(flightModeExpo(settings, fm, 0)) + "%";
                 int strWidth = valStr.length() * 6;
                 display.setCursor(68 - strWidth, 6); 
                 display.print(valStr);
@@ -980,7 +1097,7 @@ void drawCurrentPage(
             display.print("Pitch:");
 
             if (!(expoMenuIndex == 2 && isExpoEditMode && (millis() % 1000 < 500))) {
-                String valStr = String(settings.expoPitch) + "%";
+                String valStr = String(flightModeExpo(settings, fm, 1)) + "%";
                 int strWidth = valStr.length() * 6;
                 display.setCursor(68 - strWidth, 18); 
                 display.print(valStr);
@@ -997,7 +1114,7 @@ void drawCurrentPage(
             display.print("Yaw:");
 
             if (!(expoMenuIndex == 3 && isExpoEditMode && (millis() % 1000 < 500))) {
-                String valStr = String(settings.expoYaw) + "%";
+                String valStr = String(flightModeExpo(settings, fm, 2)) + "%";
                 int strWidth = valStr.length() * 6;
                 display.setCursor(68 - strWidth, 30); 
                 display.print(valStr);
@@ -1027,6 +1144,226 @@ void drawCurrentPage(
 
             break;
         }
+
+        // ---------------------------------------------------------------------
+        // --- PAGE: CURVE EDITOR ---
+        // ---------------------------------------------------------------------
+        case PAGE_CURVES: {
+            display.setTextSize(1);
+            const CustomCurve& curve = settings.stickCurves[curveChannel];
+            const char* channelNames[] = {"Roll", "Pitch", "Thr", "Yaw"};
+
+            // --- Graph: 52x52 box, 12-bit in and out ---
+            const int GX = 1, GY = 1, GS = 51;
+            auto toX = [&](int v) { return GX + constrain(v, 0, 4095) * GS / 4095; };
+            auto toY = [&](int v) { return GY + GS - constrain(v, 0, 4095) * GS / 4095; };
+
+            display.drawRect(GX - 1, GY - 1, GS + 3, GS + 3, SSD1306_WHITE);
+            for (int i = 0; i <= GS; i += 4) {
+                display.drawPixel(GX + i, GY + GS / 2, SSD1306_WHITE);
+                display.drawPixel(GX + GS / 2, GY + i, SSD1306_WHITE);
+            }
+
+            int lastX = toX(0), lastY = toY(curveEval(curve, 0));
+            for (int px = 1; px <= GS; px++) {
+                int v = px * 4095 / GS;
+                int x = toX(v), y = toY(curveEval(curve, v));
+                display.drawLine(lastX, lastY, x, y, SSD1306_WHITE);
+                lastX = x; lastY = y;
+            }
+
+            for (int i = 0; i < curve.points; i++) {
+                int x = toX(i * 4096 / (curve.points - 1));
+                int y = toY(curve.value[i]);
+                if (i == curvePoint && curveMenuIndex >= 3 && curveMenuIndex <= 4) {
+                    display.drawRect(x - 2, y - 2, 5, 5, SSD1306_WHITE);
+                } else {
+                    display.drawPixel(x, y - 1, SSD1306_WHITE);
+                    display.drawPixel(x, y + 1, SSD1306_WHITE);
+                }
+            }
+
+            // Live stick dot (calibrated stick position, before EPA)
+            int live = map(filteredChannels[curveChannel], settings.calibMin[curveChannel], settings.calibMax[curveChannel], 0, 4095);
+            live = constrain(live, 0, 4095);
+            display.fillCircle(toX(live), toY(curveEval(curve, live)), 2, SSD1306_WHITE);
+
+            // --- Parameters (Index 1-4) ---
+            bool blink = isCurveEditMode && (millis() % 1000 < 500);
+            for (int i = 1; i <= 4; i++) {
+                int y = 12 * (i - 1) + 2;
+                if (curveMenuIndex == i) {
+                    display.fillRoundRect(57, y - 2, 70, 11, 2, SSD1306_WHITE);
+                    display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
+                } else { display.setTextColor(SSD1306_WHITE); }
+
+                display.setCursor(60, y);
+                switch (i) {
+                    case 1: display.print("CH: "); display.print(channelNames[curveChannel]); break;
+                    case 2:
+                        display.print("Pts: ");
+                        if (curve.points) display.print(curve.points); else display.print("Off");
+                        break;
+                    case 3:
+                        display.print("Pt: ");
+                        if (!curve.points) { display.print("-"); break; }
+                        if (!(curveMenuIndex == 3 && blink)) {
+                            display.print(curvePoint + 1); display.print("/"); display.print(curve.points);
+                        }
+                        break;
+                    case 4:
+                        display.print("Val: ");
+                        if (!curve.points) { display.print("-"); break; }
+                        if (!(curveMenuIndex == 4 && blink)) {
+                            display.print(curve.y[curvePoint]); display.print("%");
+                        }
+                        break;
+                }
+            }
+
+            // --- BACK (Index 0) & SAVE (Index 5) ---
+            display.setTextColor(SSD1306_WHITE);
+            if (curveMenuIndex == 0) {
+                display.fillRoundRect(57, 49, 32, 13, 3, SSD1306_WHITE);
+                display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
+            } else { display.drawRoundRect(57, 49, 32, 13, 3, SSD1306_WHITE); }
+            display.setCursor(61, 52); display.print("BACK");
+
+            display.setTextColor(SSD1306_WHITE);
+            if (curveMenuIndex == 5) {
+                display.fillRoundRect(94, 49, 33, 13, 3, SSD1306_WHITE);
+                display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
+            } else { display.drawRoundRect(94, 49, 33, 13, 3, SSD1306_WHITE); }
+            display.setCursor(99, 52); display.print("SAVE");
+
+            break;
+        }
+
+        // ---------------------------------------------------------------------
+        // --- PAGE: LOGICAL SWITCHES ---
+        // ---------------------------------------------------------------------
+        case PAGE_LOGIC_SWITCHES: {
+            display.setTextSize(1);
+            const LogicalSwitch& sw = settings.logicalSwitches[lsIndex];
+            const char* funcNames[] = {"Off", "a>x", "a<x", "|a|>x", "|a|<x", "AND", "OR", "XOR", "Tmr>x"};
+            const char* sourceNames[] = {"-", "Roll", "Pitch", "Thr", "Yaw", "Aux1", "Aux2", "Aux3", "Aux4", "Max"};
+            bool logic = lsIsLogic(sw.func);
+            bool compare = sw.func >= LS_FUNC_GT && sw.func <= LS_FUNC_ABS_LT;
+            bool blink = isLsEditMode && (millis() % 1000 < 500);
+
+            // Left column (1-4): the selected switch, right column (5-8): what the switches drive
+            for (int i = 1; i <= 8; i++) {
+                int x = (i <= 4) ? 0 : 65;
+                int y = 12 * ((i - 1) % 4) + 2;
+                if (lsMenuIndex == i) {
+                    display.fillRoundRect(x, y - 2, 63, 11, 2, SSD1306_WHITE);
+                    display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
+                } else { display.setTextColor(SSD1306_WHITE); }
+
+                display.setCursor(x + 3, y);
+                bool hide = (lsMenuIndex == i) && blink;
+                switch (i) {
+                    case 1:
+                        display.print("L");
+                        if (!hide) display.print(lsIndex + 1);
+                        display.print(lsIsOn(lsState, LS_REF_L1 + lsIndex) ? " ON" : " off");
+                        break;
+                    case 2:
+                        display.print("Fn: ");
+                        if (!hide) display.print(sw.func < LS_FUNC_COUNT ? funcNames[sw.func] : "?");
+                        break;
+                    case 3:
+                        display.print("a: ");
+                        if (hide) break;
+                        if (logic) printLsRef(sw.a);
+                        else if (compare && sw.a < LS_INPUTS) display.print(sourceNames[sw.a]);
+                        else display.print("-");
+                        break;
+                    case 4:
+                        display.print(logic ? "b: " : "x: ");
+                        if (hide) break;
+                        if (logic) printLsRef(sw.b);
+                        else if (compare) { display.print(sw.value); display.print("%"); }
+                        else if (sw.func == LS_FUNC_TIMER) { display.print(sw.value); display.print("s"); }
+                        else display.print("-");
+                        break;
+                    case 5: display.print("Cut: "); if (!hide) printLsRef(settings.throttleCutSwitch); break;
+                    case 6: display.print("Tmr: "); if (!hide) printLsRef(settings.timerSwitch); break;
+                    case 7: display.print("FM1: "); if (!hide) printLsRef(settings.flightModeSwitch[0]); break;
+                    case 8: display.print("FM2: "); if (!hide) printLsRef(settings.flightModeSwitch[1]); break;
+                }
+            }
+
+            // --- BACK (Index 0) & SAVE (Index 9) ---
+            display.setTextColor(SSD1306_WHITE);
+            if (lsMenuIndex == 0) {
+                display.fillRoundRect(0, 49, 32, 13, 3, SSD1306_WHITE);
+                display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
+            } else { display.drawRoundRect(0, 49, 32, 13, 3, SSD1306_WHITE); }
+            display.setCursor(4, 52); display.print("BACK");
+
+            display.setTextColor(SSD1306_WHITE);
+            if (lsMenuIndex == 9) {
+                display.fillRoundRect(94, 49, 33, 13, 3, SSD1306_WHITE);
+                display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
+            } else { display.drawRoundRect(94, 49, 33, 13, 3, SSD1306_WHITE); }
+            display.setCursor(99, 52); display.print("SAVE");
+
+            break;
+        }
+
+        // ---------------------------------------------------------------------
+        // --- PAGE: CHANNEL SURVEY ---
+        // ---------------------------------------------------------------------
+        case PAGE_SPECTRUM: {
+            display.setTextSize(1);
+            const uint8_t* hits = Spectrum::hits();
+            uint8_t peak = Spectrum::peak();
+
+            // --- Graph: one column per channel, 2400 MHz on the left, scaled to the busiest ---
+            const int GX = 1, GBASE = 44, GH = 40;
+            for (uint8_t ch = 0; ch < Spectrum::CHANNELS; ch++) {
+                int h = peak ? (hits[ch] * GH + peak - 1) / peak : 0;
+                if (h) display.drawFastVLine(GX + ch, GBASE - h, h, SSD1306_WHITE);
+            }
+            display.drawFastHLine(0, GBASE, SCREEN_WIDTH, SSD1306_WHITE);
+
+            // Hop range underneath, a tick on the channel the model uses now
+            display.drawFastHLine(GX + Bind::HOP_FIRST, GBASE + 2, Bind::HOP_CHANNELS, SSD1306_WHITE);
+            uint8_t link = Bind::isBound(settings.rfAddress) ? Bind::channelOf(settings.hopSeed) : Bind::LEGACY_CHANNEL;
+            display.drawFastVLine(GX + link, GBASE + 1, 3, SSD1306_WHITE);
+
+            // Where the sweep is, so it's seen to be running
+            display.drawPixel(GX + Spectrum::position(), 0, SSD1306_WHITE);
+
+            // --- Result between the buttons ---
+            display.setCursor(36, 52);
+            if (Spectrum::sweeps() < Spectrum::MIN_SWEEPS) {
+                display.print("Scan ");
+                display.print(Spectrum::sweeps()); display.print("/"); display.print(Spectrum::MIN_SWEEPS);
+            } else {
+                uint8_t quiet = Spectrum::quietest(Bind::HOP_FIRST, Bind::HOP_CHANNELS);
+                display.print("Quiet "); display.print(quiet);
+                display.drawFastVLine(GX + quiet, 0, 3, SSD1306_WHITE);   // marked on top
+            }
+
+            // --- BACK (Index 0) & BIND (Index 1) ---
+            display.setTextColor(SSD1306_WHITE);
+            if (spectrumMenuIndex == 0) {
+                display.fillRoundRect(0, 49, 32, 13, 3, SSD1306_WHITE);
+                display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
+            } else { display.drawRoundRect(0, 49, 32, 13, 3, SSD1306_WHITE); }
+            display.setCursor(4, 52); display.print("BACK");
+
+            display.setTextColor(SSD1306_WHITE);
+            if (spectrumMenuIndex == 1) {
+                display.fillRoundRect(94, 49, 33, 13, 3, SSD1306_WHITE);
+                display.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
+            } else { display.drawRoundRect(94, 49, 33, 13, 3, SSD1306_WHITE); }
+            display.setCursor(99, 52); display.print("BIND");
+
+            break;
+        }
     }
 
     // --- Footer: Draw Page Name Centered ---
@@ -45,7 +45,10 @@ enum DisplayState {
     PAGE_DUAL_RATE,
     PAGE_CHANNELS_ADVANCED,
     PAGE_CHANNEL_CONFIG,
-    PAGE_EXPO
+    PAGE_EXPO,
+    PAGE_CURVES,      // Custom Curve Editor (live stick dot)
+    PAGE_LOGIC_SWITCHES, // Logical switches & what they drive
+    PAGE_SPECTRUM     // 2.4 GHz channel survey (Spectrum.h)
 };
 
 /**
@@ -58,6 +61,7 @@ enum SettingsMenu {
     SETTING_CH_INVERT,
     SETTING_RESET_TRIMS,
     SETTING_THROTTLE_MODE, // Switches between Airplane (0-100) and Quad (Center-based)
+    SETTING_FLIGHT_MODES,  // Off / On with the cross-fade time
     SETTING_INFO,
     SETTING_BACK,          // Navigation Back Button
     SETTING_NEXT,
@@ -66,10 +70,17 @@ enum SettingsMenu {
 
 enum FeaturesMenu {
     FEATURE_EXPO,
+    FEATURE_CURVES,
+    FEATURE_LOGIC_SWITCHES,
     FEATURE_DUAL_RATE,
     FEATURE_CHANNEL_ADVANCED,
     FEATURE_CALIBRATION,
     FEATURE_CHANNELS_MIX,
+    FEATURE_RF_OUTPUT,    // NRF24 or CRSF module with its frame rate
+    FEATURE_TX_POWER,     // NRF24 PA at MAX or adaptive (PowerControl.h)
+    FEATURE_BIND,         // NRF24 bind procedure (Bind.h)
+    FEATURE_SPECTRUM,     // channel survey page, bind on the quietest channel
+    FEATURE_TRAINER,      // host channel frames over USB (Trainer.h)
     FEATURE_SIMULATOR,
     FEATURE_BACK,
     FEATURE_TOTAL
@@ -0,0 +1,145 @@
+/**
+ * @file FlightModes.cpp
+ * @author Ebrahim Siami
+ * @brief Flight modes on the aux3/aux4 switches with a fixed-point cross-fade
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "FlightModes.h"
+#include "ChannelPipeline.h"
+
+// =============================================================================
+// --- Per-mode values ---
+// =============================================================================
+
+int& flightModeTrim(RadioSettings& s, uint8_t mode, uint8_t axis) {
+    if (mode == 0 || mode >= FLIGHT_MODES) {
+        return axis == 0 ? s.trim1 : axis == 1 ? s.trim2 : s.trim3;
+    }
+    return s.flightModes[mode - 1].trim[axis];
+}
+
+int& flightModeExpo(RadioSettings& s, uint8_t mode, uint8_t axis) {
+    if (mode == 0 || mode >= FLIGHT_MODES) {
+        return axis == 0 ? s.expoRoll : axis == 1 ? s.expoPitch : s.expoYaw;
+    }
+    return s.flightModes[mode - 1].expo[axis];
+}
+
+uint8_t& flightModeRate(RadioSettings& s, uint8_t mode, uint8_t axis) {
+    if (mode == 0 || mode >= FLIGHT_MODES) {
+        return axis == 0 ? s.dualRateRoll : axis == 1 ? s.dualRatePitch : s.dualRateYaw;
+    }
+    return s.flightModes[mode - 1].rate[axis];
+}
+
+uint8_t& flightModeMix(RadioSettings& s, uint8_t mode) {
+    if (mode == 0 || mode >= FLIGHT_MODES) return s.mixMode;
+    return s.flightModes[mode - 1].mixMode;
+}
+
+// Read-only versions for the display, same lookup
+int flightModeTrim(const RadioSettings& s, uint8_t mode, uint8_t axis) {
+    return flightModeTrim(const_cast<RadioSettings&>(s), mode, axis);
+}
+
+int flightModeExpo(const RadioSettings& s, uint8_t mode, uint8_t axis) {
+    return flightModeExpo(const_cast<RadioSettings&>(s), mode, axis);
+}
+
+uint8_t flightModeRate(const RadioSettings& s, uint8_t mode, uint8_t axis) {
+    return flightModeRate(const_cast<RadioSettings&>(s), mode, axis);
+}
+
+uint8_t flightModeMix(const RadioSettings& s, uint8_t mode) {
+    return flightModeMix(const_cast<RadioSettings&>(s), mode);
+}
+
+void flightModesSetDefaults(RadioSettings& s) {
+    for (uint8_t m = 0; m < FLIGHT_MODES - 1; m++) {
+        FlightMode& fm = s.flightModes[m];
+        for (uint8_t a = 0; a < 3; a++) {
+            fm.trim[a] = 2048;
+            fm.expo[a] = 0;
+            fm.rate[a] = 100;
+        }
+        fm.mixMode = FLIGHT_MODE_MIX_BASE;
+    }
+}
+
+// =============================================================================
+// --- Precomputed tables ---
+// =============================================================================
+
+void flightModesBuild(const RadioSettings& s, MixLine tables[FLIGHT_MODES][MIX_LINES]) {
+    for (uint8_t m = 0; m < FLIGHT_MODES; m++) {
+        uint8_t mix = flightModeMix(s, m);
+        if (m == 0 || mix == FLIGHT_MODE_MIX_BASE) {
+            memcpy(tables[m], s.mixLines, sizeof(MixLine) * MIX_LINES);
+        } else {
+            mixerApplyPreset(tables[m], mix);
+        }
+    }
+}
+
+void flightModeSticks(const RadioSettings& s, uint8_t mode, StickParams& out) {
+    static const uint8_t CHANNEL[3] = { 0, 1, 3 };   // axis -> calibMin[] etc. index
+
+    for (uint8_t a = 0; a < 3; a++) {
+        out.expo[a] = flightModeExpo(s, mode, a);
+        out.trim[a] = s.subTrim[CHANNEL[a]] + (flightModeTrim(s, mode, a) - 2048);
+
+        // Mode 0 keeps the dashboard D/R switch, the other modes are their own rate
+        if (mode == 0 || mode >= FLIGHT_MODES) {
+            out.rate[a] = s.dualRateEnabled ? flightModeRate(s, 0, a) : 100;
+        } else {
+            out.rate[a] = flightModeRate(s, mode, a);
+        }
+    }
+}
+
+// =============================================================================
+// --- Switching & Cross-fade ---
+// =============================================================================
+
+uint8_t flightModeFromSwitches(const RadioSettings& s, bool aux3, bool aux4) {
+    if (!s.flightModesEnabled) return 0;
+    return (aux3 ? 1 : 0) | (aux4 ? 2 : 0);
+}
+
+void flightModeUpdate(FlightModeState& state, uint8_t mode, uint16_t fadeMs, uint32_t nowMs) {
+    if (fadeMs != state.fadeMs || state.fadeRecip == 0) {
+        state.fadeMs = fadeMs;
+        state.fadeRecip = fadeMs ? (256UL << 16) / fadeMs : 0;
+    }
+
+    if (mode != state.active) {
+        if (state.weight < 256 && mode == state.previous) {
+            // Switched back in the middle of a fade: run the same fade in reverse
+            state.previous = state.active;
+            state.active = mode;
+            state.weight = 256 - state.weight;
+            state.fadeStartMs = nowMs - (((uint32_t)state.weight * state.fadeMs) >> 8);
+        } else {
+            // A third mode in the middle of a fade: fade out whichever mode
+            // was dominant, that keeps the jump small
+            if (state.weight >= 128) state.previous = state.active;
+            state.active = mode;
+            state.fadeStartMs = nowMs;
+            state.weight = fadeMs ? 0 : 256;
+        }
+    }
+
+    if (state.weight < 256) {
+        uint32_t elapsed = nowMs - state.fadeStartMs;
+        // elapsed < fadeMs here, so elapsed * fadeRecip stays below 2^24
+        state.weight = elapsed >= state.fadeMs ? 256 : (uint16_t)((elapsed * state.fadeRecip) >> 16);
+    }
+}
+
+void flightModeBlend(const int from[], const int to[], uint16_t weight, int out[], uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        out[i] = from[i] + (((to[i] - from[i]) * (int)weight) >> 8);
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file FlightModes.h
+ * @author Ebrahim Siami
+ * @brief Flight modes on the aux3/aux4 switches with a fixed-point cross-fade
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Up to 4 flight modes, selected by the two aux switches
+ * (mode = aux3 + 2 * aux4). Mode 0 is the normal model setup (trims, expo,
+ * dual rate and mixer lines in RadioSettings), modes 1-3 bring their own
+ * trims, expo, rates and mix preset. With flight modes off, mode 0 is always
+ * active and nothing changes compared to the old behaviour.
+ *
+ * The mixer lines of every mode are expanded once (flightModesBuild()), so a
+ * tick only picks a table. When the mode changes, the old and the new mode are
+ * both processed for 'flightModeFadeMs' and blended with a Q8 weight that is
+ * computed with a precomputed reciprocal (no division per tick).
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "Mixer.h"
+
+const uint8_t FLIGHT_MODES = 4;
+
+// FlightMode::mixMode value: use the mixer lines of mode 0
+const uint8_t FLIGHT_MODE_MIX_BASE = 0xFF;
+
+// Limit of the cross-fade setting
+const uint16_t FLIGHT_MODE_FADE_MAX_MS = 2000;
+
+/**
+ * @brief Settings of flight mode 1-3 (mode 0 uses the plain RadioSettings members).
+ */
+struct FlightMode {
+    int trim[3];          // Roll, Pitch, Yaw, 0-4095 (center 2048), replaces trim1-3
+    int expo[3];          // Roll, Pitch, Yaw, -100..100
+    uint8_t rate[3];      // Roll, Pitch, Yaw, 10..100 %, always active
+    uint8_t mixMode;      // MixPreset, or FLIGHT_MODE_MIX_BASE
+};
+
+struct RadioSettings;
+struct StickParams;
+
+/**
+ * @brief Per-mode values for the UI (axis 0 = roll, 1 = pitch, 2 = yaw).
+ * For mode 0 these are the normal settings members, so editing pages
+ * and trim buttons always change the mode that is flown.
+ */
+int&     flightModeTrim(RadioSettings& s, uint8_t mode, uint8_t axis);
+int&     flightModeExpo(RadioSettings& s, uint8_t mode, uint8_t axis);
+uint8_t& flightModeRate(RadioSettings& s, uint8_t mode, uint8_t axis);
+uint8_t& flightModeMix(RadioSettings& s, uint8_t mode);
+
+int     flightModeTrim(const RadioSettings& s, uint8_t mode, uint8_t axis);
+int     flightModeExpo(const RadioSettings& s, uint8_t mode, uint8_t axis);
+uint8_t flightModeRate(const RadioSettings& s, uint8_t mode, uint8_t axis);
+uint8_t flightModeMix(const RadioSettings& s, uint8_t mode);
+
+/**
+ * @brief Factory defaults of modes 1-3 (center trims, no expo, 100 %, base mix).
+ */
+void flightModesSetDefaults(RadioSettings& s);
+
+/**
+ * @brief Expands the mixer lines of every mode. Call after loading settings
+ * and whenever mixLines or a mode's mixMode changed.
+ */
+void flightModesBuild(const RadioSettings& s, MixLine tables[FLIGHT_MODES][MIX_LINES]);
+
+/**
+ * @brief Stick parameters (expo, rate, trim incl. sub-trim) of one mode.
+ */
+void flightModeSticks(const RadioSettings& s, uint8_t mode, StickParams& out);
+
+/**
+ * @brief Active mode and cross-fade progress.
+ */
+struct FlightModeState {
+    uint8_t  active;          // mode that is faded in
+    uint8_t  previous;        // mode that is faded out
+    uint16_t weight;          // Q8 weight of 'active' (256 = fade done)
+    uint16_t fadeMs;          // fade time the reciprocal was made for
+    uint32_t fadeRecip;       // (256 << 16) / fadeMs
+    uint32_t fadeStartMs;
+};
+
+/**
+ * @brief Selects the mode from the switches, or 0 if flight modes are off.
+ */
+uint8_t flightModeFromSwitches(const RadioSettings& s, bool aux3, bool aux4);
+
+/**
+ * @brief Starts a cross-fade if 'mode' differs from the active one and
+ * updates the fade weight. Call once per tick.
+ */
+void flightModeUpdate(FlightModeState& state, uint8_t mode, uint16_t fadeMs, uint32_t nowMs);
+
+/**
+ * @brief out[i] = from[i] + (to[i] - from[i]) * weight / 256
+ */
+void flightModeBlend(const int from[], const int to[], uint16_t weight, int out[], uint8_t count);
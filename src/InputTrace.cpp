@@ -0,0 +1,35 @@
+/**
+ * @file InputTrace.cpp
+ * @author Ebrahim Siami
+ * @brief Raw input recorder (stick ADC, buttons, switches)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "InputTrace.h"
+
+namespace InputTrace {
+
+uint16_t readInputs() {
+    uint16_t inputs = 0;
+    for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+        if (digitalRead(INPUT_PINS[i]) == HIGH) inputs |= (uint16_t)(1u << i);
+    }
+    return inputs;
+}
+
+void record(const uint16_t adc[ADC_CHANNELS], uint16_t inputs) {
+    static uint8_t seq = 0;
+
+    Record r;
+    r.seq = seq++;
+    r.timeUs = micros();
+    for (uint8_t i = 0; i < ADC_CHANNELS; i++) r.adc[i] = adc[i];
+    r.inputs = inputs;
+
+    uint8_t buf[RECORD_SIZE];
+    encode(r, buf);
+    Serial.write(buf, RECORD_SIZE);
+}
+
+} // namespace InputTrace
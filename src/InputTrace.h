@@ -0,0 +1,38 @@
+/**
+ * @file InputTrace.h
+ * @author Ebrahim Siami
+ * @brief Raw input recorder (stick ADC, buttons, switches)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Build with -D INPUT_TRACE_RECORD and the transmitter writes one record per
+ * ADC tick to the USB port (see input_trace_format.h). Capture it with e.g.
+ *   cat /dev/ttyACM0 > flight.trace
+ * and replay it on the host: .pio/build/native/program --replay flight.trace
+ *
+ * The recorder shares the USB port with the simulator output, so it pauses
+ * while simulator mode is on.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "input_trace_format.h"
+
+namespace InputTrace {
+
+// Pins behind Record::adc[] and the bits of Record::inputs (defined in main.cpp)
+extern const uint8_t ADC_PINS[ADC_CHANNELS];
+extern const uint8_t INPUT_PINS[INPUT_COUNT];
+
+/**
+ * @brief Reads the digital inputs into the Record::inputs bit layout.
+ */
+uint16_t readInputs();
+
+/**
+ * @brief Writes one record to the USB port.
+ * @param adc Raw ADC values in AdcChannel order.
+ */
+void record(const uint16_t adc[ADC_CHANNELS], uint16_t inputs);
+
+} // namespace InputTrace
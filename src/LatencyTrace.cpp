@@ -0,0 +1,95 @@
+/**
+ * @file LatencyTrace.cpp
+ * @author Ebrahim Siami
+ * @brief Latency measurement mode: cycle counter stamps of every control slot
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "LatencyTrace.h"
+
+#if defined(LATENCY_TRACE)
+
+namespace LatencyTrace {
+
+using namespace SimProto;
+
+static uint32_t stamps[LAT_STAGES];
+static uint8_t  reached = 0;     // bit per stage stamped in this slot
+static uint32_t seq = 0;
+static bool     inSlot = false;
+
+#if defined(STM32F1xx)
+
+static inline uint32_t cycles() {
+    return DWT->CYCCNT;
+}
+
+static uint8_t cyclesPerUs() {
+    return (uint8_t)(SystemCoreClock / 1000000UL);
+}
+
+#else
+
+// No cycle counter on the host: the (simulated) micros() at the 72 MHz of the F103
+static inline uint32_t cycles() {
+    return micros() * 72UL;
+}
+
+static uint8_t cyclesPerUs() {
+    return 72;
+}
+
+#endif
+
+void begin() {
+#if defined(STM32F1xx)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    pinMode(LATENCY_MARKER_PIN, OUTPUT);
+    digitalWrite(LATENCY_MARKER_PIN, LOW);
+}
+
+static void sendRecord() {
+    uint8_t out[LATENCY_SIZE];
+    out[0] = HEADER1;
+    out[1] = HEADER2;
+    out[2] = LATENCY_RECORD;
+    putU32(&out[3], seq);
+    out[7] = cyclesPerUs();
+    out[8] = reached;
+    for (uint8_t i = 0; i < LAT_STAGES; i++) {
+        putU32(&out[9 + 4 * i], stamps[i]);
+    }
+    putU16(&out[LATENCY_SIZE - V2_CRC_SIZE], Crc::crc16(&out[2], LATENCY_SIZE - 2 - V2_CRC_SIZE));
+
+    Serial.write(out, LATENCY_SIZE);
+}
+
+void slotStart() {
+    // the last slot is complete now, the timed outputs had their chance too
+    if (inSlot) {
+        sendRecord();
+        seq++;
+    }
+    inSlot = true;
+    reached = 0;
+
+    // after the record went out, so the measurement doesn't show up as ADC time
+    digitalWrite(LATENCY_MARKER_PIN, HIGH);
+    mark(LAT_SLOT);
+}
+
+void mark(LatencyStage stage) {
+    if (!inSlot || (reached & (1 << stage))) return;
+
+    stamps[stage] = cycles();
+    reached |= (uint8_t)(1 << stage);
+    if (stage == LAT_RADIO) digitalWrite(LATENCY_MARKER_PIN, LOW);
+}
+
+} // namespace LatencyTrace
+
+#endif // LATENCY_TRACE
@@ -0,0 +1,59 @@
+/**
+ * @file LatencyTrace.h
+ * @author Ebrahim Siami
+ * @brief Latency measurement mode: cycle counter stamps of every control slot
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Build with -D LATENCY_TRACE and every control slot is timed with the DWT
+ * cycle counter at each stage (sim_protocol_format.h, LatencyStage):
+ *
+ *   slot start -> inputs sampled -> pipeline done -> RF packet written -> SimProto bytes queued
+ *
+ * The stamps of a slot go out over USB as an 'L' record at the start of the
+ * next slot, in between the simulator frames if simulator mode is on.
+ * Capture with e.g.  cat /dev/ttyACM0 > latency.bin  and look at the
+ * distributions with tools/latency/latency_analyze.
+ *
+ * LATENCY_MARKER_PIN is high from the slot start until the RF packet is
+ * written. With a logic analyzer on it and on the receiver output that gives
+ * the stick-to-air and air-to-servo parts the cycle counter can't see.
+ *
+ * Without LATENCY_TRACE all calls are empty and cost nothing. Don't combine
+ * it with INPUT_TRACE_RECORD, both write to the USB port on every slot.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "sim_protocol_format.h"
+
+#define LATENCY_MARKER_PIN PB11
+
+namespace LatencyTrace {
+
+#if defined(LATENCY_TRACE)
+
+/**
+ * @brief Starts the cycle counter and sets up the marker pin.
+ */
+void begin();
+
+/**
+ * @brief A control slot starts: sends the record of the last one, marker high.
+ */
+void slotStart();
+
+/**
+ * @brief Stamps a stage of the current slot, only the first time it's reached.
+ */
+void mark(SimProto::LatencyStage stage);
+
+#else
+
+static inline void begin() {}
+static inline void slotStart() {}
+static inline void mark(SimProto::LatencyStage) {}
+
+#endif
+
+} // namespace LatencyTrace
@@ -0,0 +1,112 @@
+/**
+ * @file LogicalSwitches.cpp
+ * @author Ebrahim Siami
+ * @brief Logical switches: conditions on channels, switches and the timer
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "LogicalSwitches.h"
+
+static_assert(LS_FUNC_COUNT <= 16, "lsEvaluate() keeps one result bit per function");
+
+void lsSetChannels(LsInputs& in, const int ch[MIX_CHANNELS]) {
+    for (uint8_t i = 0; i < LS_INPUT_SLOTS; i++) {
+        in.value[i] = 2048;
+    }
+    for (uint8_t i = 0; i < MIX_CHANNELS; i++) {
+        in.value[MIX_SRC_ROLL + i] = ch[i];
+    }
+    in.value[MIX_SRC_MAX] = 4096;
+}
+
+bool lsIsLogic(uint8_t func) {
+    return func == LS_FUNC_AND || func == LS_FUNC_OR || func == LS_FUNC_XOR;
+}
+
+// Switch reference -> state bit + invert flag (bad references read as "none")
+static void compileRef(uint8_t ref, uint8_t& bit, bool& invert) {
+    bit = ref & ~LS_REF_NOT;
+    invert = (ref & LS_REF_NOT) != 0;
+    if (bit >= LS_REF_COUNT) bit = LS_REF_NONE;
+}
+
+void lsCompile(const LogicalSwitch sw[LS_COUNT], LsProgram& out) {
+    for (uint8_t i = 0; i < LS_COUNT; i++) {
+        const LogicalSwitch& s = sw[i];
+        LsOp& op = out.ops[i];
+        op.op = LS_FUNC_OFF;
+        op.a = 0;
+        op.b = 0;
+        op.invert = 0;
+        op.k = 0;
+
+        switch (s.func) {
+            case LS_FUNC_GT:
+            case LS_FUNC_LT:
+            case LS_FUNC_ABS_GT:
+            case LS_FUNC_ABS_LT:
+                if (s.a >= LS_INPUTS) break;
+                op.op = s.func;
+                op.a = s.a;
+                op.k = (int32_t)constrain(s.value, -100, 100) * 2048 / 100;
+                break;
+
+            case LS_FUNC_AND:
+            case LS_FUNC_OR:
+            case LS_FUNC_XOR: {
+                bool invA, invB;
+                op.op = s.func;
+                compileRef(s.a, op.a, invA);
+                compileRef(s.b, op.b, invB);
+                op.invert = (invA ? 1 : 0) | (invB ? 2 : 0);
+                break;
+            }
+
+            case LS_FUNC_TIMER:
+                op.op = s.func;
+                op.k = (int32_t)constrain(s.value, 0, LS_TIMER_MAX_S) * 1000;
+                break;
+        }
+    }
+}
+
+uint32_t lsEvaluate(const LsProgram& program, const LsInputs& in, uint32_t state) {
+    state &= ~((1UL << LS_REF_AUX3) | (1UL << LS_REF_AUX4) | (1UL << LS_REF_NONE));
+    if (in.aux3) state |= 1UL << LS_REF_AUX3;
+    if (in.aux4) state |= 1UL << LS_REF_AUX4;
+
+    for (uint8_t i = 0; i < LS_COUNT; i++) {
+        const LsOp& op = program.ops[i];
+        uint16_t a = ((state >> op.a) & 1) ^ (op.invert & 1);
+        uint16_t b = ((state >> op.b) & 1) ^ ((op.invert >> 1) & 1);
+        int32_t v = in.value[op.a & (LS_INPUT_SLOTS - 1)] - 2048;
+        int32_t sign = v >> 31;
+        int32_t absV = (v ^ sign) - sign;
+
+        // Every function is worked out and the one of this switch is picked
+        // by its bit, so the time per switch doesn't depend on the function
+        uint16_t results = (uint16_t)(v > op.k)                   << LS_FUNC_GT
+                         | (uint16_t)(v < op.k)                   << LS_FUNC_LT
+                         | (uint16_t)(absV > op.k)                << LS_FUNC_ABS_GT
+                         | (uint16_t)(absV < op.k)                << LS_FUNC_ABS_LT
+                         | (a & b)                                << LS_FUNC_AND
+                         | (a | b)                                << LS_FUNC_OR
+                         | (a ^ b)                                << LS_FUNC_XOR
+                         | (uint16_t)(in.timerMs >= (uint32_t)op.k) << LS_FUNC_TIMER;
+        uint32_t on = (results >> op.op) & 1;     // LS_FUNC_OFF is bit 0, never set
+
+        uint8_t bit = LS_REF_L1 + i;
+        state = (state & ~(1UL << bit)) | (on << bit);
+    }
+    return state;
+}
+
+uint8_t lsRefStep(uint8_t ref, bool up) {
+    // 2 entries per reference: plain, then inverted
+    const int count = LS_REF_COUNT * 2;
+    uint8_t bit = ref & ~LS_REF_NOT;
+    int index = (bit < LS_REF_COUNT ? bit * 2 : 0) + ((ref & LS_REF_NOT) ? 1 : 0);
+    index = (index + (up ? 1 : count - 1)) % count;
+    return (uint8_t)((index / 2) | ((index & 1) ? LS_REF_NOT : 0));
+}
@@ -0,0 +1,138 @@
+/**
+ * @file LogicalSwitches.h
+ * @author Ebrahim Siami
+ * @brief Logical switches: conditions on channels, switches and the timer
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Up to 16 logical switches (L1-L16), each one a small condition like
+ * "throttle > -90 %", "|aux1| < 10 %", "L1 AND !Aux3" or "timer ran 120 s".
+ * Their results, together with the physical Aux3/Aux4 switches, can drive
+ * the throttle cut, the flight mode selection and the flight timer.
+ *
+ * lsCompile() turns the user form (percent, seconds, switch numbers) into a
+ * flat table with 12-bit thresholds, milliseconds and bit numbers, only when
+ * something was edited. lsEvaluate() then always runs all LS_COUNT entries,
+ * so a tick costs the same no matter how many switches are in use.
+ *
+ * All results are kept as bits of one uint32_t. A switch that reads another
+ * one sees its result of this tick if it comes later in the list, and the
+ * one of the previous tick otherwise (so loops can't hang anything).
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "Mixer.h"
+
+const uint8_t LS_COUNT = 16;
+
+// What a logical switch checks
+enum LsFunc : uint8_t {
+    LS_FUNC_OFF,         // always off
+    LS_FUNC_GT,          // source a >  value %
+    LS_FUNC_LT,          // source a <  value %
+    LS_FUNC_ABS_GT,      // |source a| > value % (distance from center)
+    LS_FUNC_ABS_LT,      // |source a| < value %
+    LS_FUNC_AND,         // switch a AND switch b
+    LS_FUNC_OR,          // switch a OR  switch b
+    LS_FUNC_XOR,         // switch a XOR switch b
+    LS_FUNC_TIMER,       // flight timer ran for at least 'value' seconds
+    LS_FUNC_COUNT
+};
+
+// Switch reference: LS_REF_<n>, optionally with LS_REF_NOT.
+// LS_REF_NONE is never on, so (LS_REF_NONE | LS_REF_NOT) is always on.
+enum LsRef : uint8_t {
+    LS_REF_NONE,
+    LS_REF_AUX3, LS_REF_AUX4,
+    LS_REF_L1,                           // L1..L16 = LS_REF_L1 + n
+    LS_REF_COUNT = LS_REF_L1 + LS_COUNT
+};
+
+const uint8_t LS_REF_NOT = 0x80;
+
+static_assert(LS_REF_COUNT <= 32, "Logical switch state has to fit in 32 bits");
+
+/**
+ * @brief One logical switch as the user edits it (stored in RadioSettings).
+ */
+struct LogicalSwitch {
+    uint8_t func;         // LsFunc
+    uint8_t a;            // MixSource for comparisons, LsRef for AND/OR/XOR
+    uint8_t b;            // LsRef for AND/OR/XOR
+    int16_t value;        // -100..100 % for comparisons, seconds for LS_FUNC_TIMER
+};
+
+// Limit of LS_FUNC_TIMER
+const int16_t LS_TIMER_MAX_S = 3600;
+
+/**
+ * @brief Compiled logical switch, everything converted to what the tick needs.
+ */
+struct LsOp {
+    uint8_t op;           // LsFunc
+    uint8_t a;            // input index or state bit
+    uint8_t b;            // state bit
+    uint8_t invert;       // bit 0: invert a, bit 1: invert b
+    int32_t k;            // threshold as offset from 2048, or milliseconds
+};
+
+struct LsProgram {
+    LsOp ops[LS_COUNT];
+};
+
+// Comparison inputs, indexed by MixSource (NONE reads center, MAX reads full)
+const uint8_t LS_INPUTS = MIX_SRC_COUNT;
+
+// LsInputs::value[] is padded to a power of two, so the tick can index it
+// with a mask instead of a range check (the padding reads center)
+const uint8_t LS_INPUT_SLOTS = 16;
+
+static_assert(LS_INPUTS <= LS_INPUT_SLOTS, "LS_INPUT_SLOTS too small");
+
+/**
+ * @brief What the logical switches look at during one tick.
+ */
+struct LsInputs {
+    int      value[LS_INPUT_SLOTS];  // 12-bit, see lsSetChannels()
+    bool     aux3, aux4;             // physical switches (after inversion)
+    uint32_t timerMs;                // how long the flight timer has been running
+};
+
+/**
+ * @brief Fills LsInputs::value from the 8 channels in MixChannel order.
+ */
+void lsSetChannels(LsInputs& in, const int ch[MIX_CHANNELS]);
+
+/**
+ * @brief True for functions that take switches as a and b (AND/OR/XOR).
+ */
+bool lsIsLogic(uint8_t func);
+
+/**
+ * @brief Builds the table from the user form. Unknown functions and
+ * out-of-range sources/references are compiled as "off".
+ */
+void lsCompile(const LogicalSwitch sw[LS_COUNT], LsProgram& out);
+
+/**
+ * @brief Runs all LS_COUNT switches once.
+ * @param state Result of the previous tick (0 at startup).
+ * @return New state, test it with lsIsOn().
+ */
+uint32_t lsEvaluate(const LsProgram& program, const LsInputs& in, uint32_t state);
+
+/**
+ * @brief Looks up a switch reference in the state returned by lsEvaluate().
+ */
+static inline bool lsIsOn(uint32_t state, uint8_t ref) {
+    uint8_t bit = ref & ~LS_REF_NOT;
+    bool on = bit < LS_REF_COUNT && ((state >> bit) & 1);
+    return on != ((ref & LS_REF_NOT) != 0);
+}
+
+/**
+ * @brief Next/previous reference in UI order: none, !none, Aux3, !Aux3, ... L16, !L16.
+ */
+uint8_t lsRefStep(uint8_t ref, bool up);
@@ -0,0 +1,102 @@
+/**
+ * @file Mixer.cpp
+ * @author Ebrahim Siami
+ * @brief Programmable mixer: up to 16 free-form mix lines
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "Mixer.h"
+
+// =============================================================================
+// --- Presets ---
+// =============================================================================
+
+struct PresetLine { uint8_t source, destination; int8_t weight; };
+
+// The old mixMode equations, e.g. V-tail A: pitch = (pitch + yaw) / 2, yaw = (pitch - yaw) / 2
+static const PresetLine PRESET_VTAIL_A[] = {
+    { MIX_SRC_PITCH, MIX_CH_PITCH, 50 }, { MIX_SRC_YAW, MIX_CH_PITCH, 50 },
+    { MIX_SRC_PITCH, MIX_CH_YAW,   50 }, { MIX_SRC_YAW, MIX_CH_YAW,  -50 },
+};
+static const PresetLine PRESET_VTAIL_B[] = {
+    { MIX_SRC_PITCH, MIX_CH_PITCH, 50 }, { MIX_SRC_YAW, MIX_CH_PITCH, -50 },
+    { MIX_SRC_PITCH, MIX_CH_YAW,   50 }, { MIX_SRC_YAW, MIX_CH_YAW,    50 },
+};
+static const PresetLine PRESET_DELTA_A[] = {
+    { MIX_SRC_PITCH, MIX_CH_ROLL,  50 }, { MIX_SRC_ROLL, MIX_CH_ROLL,   50 },
+    { MIX_SRC_PITCH, MIX_CH_PITCH, 50 }, { MIX_SRC_ROLL, MIX_CH_PITCH, -50 },
+};
+static const PresetLine PRESET_DELTA_B[] = {
+    { MIX_SRC_PITCH, MIX_CH_ROLL,  50 }, { MIX_SRC_ROLL, MIX_CH_ROLL,  -50 },
+    { MIX_SRC_PITCH, MIX_CH_PITCH, 50 }, { MIX_SRC_ROLL, MIX_CH_PITCH,  50 },
+};
+
+void mixerApplyPreset(MixLine lines[MIX_LINES], uint8_t preset) {
+    memset(lines, 0, sizeof(MixLine) * MIX_LINES);
+
+    const PresetLine* p = nullptr;
+    uint8_t count = 0;
+    switch (preset) {
+        case MIX_PRESET_VTAIL_A: p = PRESET_VTAIL_A; count = 4; break;
+        case MIX_PRESET_VTAIL_B: p = PRESET_VTAIL_B; count = 4; break;
+        case MIX_PRESET_DELTA_A: p = PRESET_DELTA_A; count = 4; break;
+        case MIX_PRESET_DELTA_B: p = PRESET_DELTA_B; count = 4; break;
+        default: break;   // Normal: no lines, everything passes through
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        lines[i].source = p[i].source;
+        lines[i].destination = p[i].destination;
+        lines[i].weight = p[i].weight;
+    }
+}
+
+// =============================================================================
+// --- Kernel ---
+// =============================================================================
+
+static inline bool switchActive(uint8_t sw, const int ch[MIX_CHANNELS]) {
+    switch (sw) {
+        case MIX_SW_AUX3_ON:  return ch[MIX_CH_AUX3] > 2048;
+        case MIX_SW_AUX3_OFF: return ch[MIX_CH_AUX3] <= 2048;
+        case MIX_SW_AUX4_ON:  return ch[MIX_CH_AUX4] > 2048;
+        case MIX_SW_AUX4_OFF: return ch[MIX_CH_AUX4] <= 2048;
+        default:              return true;
+    }
+}
+
+static inline int32_t applyCurve(uint8_t curve, int32_t x) {
+    switch (curve) {
+        case MIX_CURVE_POSITIVE: return x > 0 ? x : 0;
+        case MIX_CURVE_NEGATIVE: return x < 0 ? x : 0;
+        case MIX_CURVE_ABS:      return x < 0 ? -x : x;
+        default:                 return x;
+    }
+}
+
+void mixerRun(const MixLine lines[MIX_LINES], int ch[MIX_CHANNELS]) {
+    // Source vector: offsets from center, index = MixSource
+    int32_t src[MIX_SRC_COUNT];
+    src[MIX_SRC_NONE] = 0;
+    for (uint8_t i = 0; i < MIX_CHANNELS; i++) src[MIX_SRC_ROLL + i] = ch[i] - 2048;
+    src[MIX_SRC_MAX] = 2048;
+
+    // Sums in 1/100 of a step, divided once per destination
+    int32_t acc[MIX_CHANNELS] = { 0 };
+    uint8_t owned = 0;
+
+    for (uint8_t i = 0; i < MIX_LINES; i++) {
+        const MixLine& l = lines[i];
+        if (l.source == MIX_SRC_NONE || l.source >= MIX_SRC_COUNT || l.destination >= MIX_CHANNELS) continue;
+
+        owned |= (uint8_t)(1u << l.destination);
+        if (!switchActive(l.sw, ch)) continue;
+
+        acc[l.destination] += applyCurve(l.curve, src[l.source]) * l.weight + (int32_t)l.offset * 2048;
+    }
+
+    for (uint8_t d = 0; d < MIX_CHANNELS; d++) {
+        if (owned & (1u << d)) ch[d] = 2048 + acc[d] / 100;
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * @file Mixer.h
+ * @author Ebrahim Siami
+ * @brief Programmable mixer: up to 16 free-form mix lines
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Every line adds  weight% * curve(source) + offset%  to one destination
+ * channel. All values are offsets from center (2048), the sum over a
+ * destination is divided by 100 once, so the whole mixer is an integer
+ * matrix-vector multiply (no float, no division per line).
+ *
+ * A destination that has at least one line is owned by the mixer: its input
+ * value is replaced by the sum of its lines (lines switched off add nothing,
+ * so with all of them off the channel sits at center). Destinations without
+ * lines pass their input through unchanged. Sources always read the values
+ * before mixing, so the order of the lines does not matter.
+ *
+ * The old fixed mix modes (V-tail, delta) are available as presets and give
+ * bit-identical outputs (see tools/golden).
+ */
+
+#pragma once
+#include <Arduino.h>
+
+const uint8_t MIX_LINES = 16;
+const uint8_t MIX_CHANNELS = 8;     // Roll, Pitch, Throttle, Yaw, Aux1..Aux4
+
+enum MixChannel : uint8_t {
+    MIX_CH_ROLL, MIX_CH_PITCH, MIX_CH_THROTTLE, MIX_CH_YAW,
+    MIX_CH_AUX1, MIX_CH_AUX2, MIX_CH_AUX3, MIX_CH_AUX4
+};
+
+// Input of a mix line. MIX_SRC_<channel> == MixChannel + 1
+enum MixSource : uint8_t {
+    MIX_SRC_NONE,        // unused line
+    MIX_SRC_ROLL, MIX_SRC_PITCH, MIX_SRC_THROTTLE, MIX_SRC_YAW,
+    MIX_SRC_AUX1, MIX_SRC_AUX2, MIX_SRC_AUX3, MIX_SRC_AUX4,
+    MIX_SRC_MAX,         // constant full deflection (+2048)
+    MIX_SRC_COUNT
+};
+
+// Built-in response of a line to its source
+enum MixCurve : uint8_t {
+    MIX_CURVE_NONE,      // linear
+    MIX_CURVE_POSITIVE,  // x > 0 only
+    MIX_CURVE_NEGATIVE,  // x < 0 only
+    MIX_CURVE_ABS,       // |x|
+    MIX_CURVE_COUNT
+};
+
+// When the line is active
+enum MixSwitch : uint8_t {
+    MIX_SW_ALWAYS,
+    MIX_SW_AUX3_ON, MIX_SW_AUX3_OFF,
+    MIX_SW_AUX4_ON, MIX_SW_AUX4_OFF,
+    MIX_SW_COUNT
+};
+
+struct MixLine {
+    uint8_t source;       // MixSource
+    uint8_t destination;  // MixChannel
+    int8_t  weight;       // -100..100 %
+    int8_t  offset;       // -100..100 % of half travel
+    uint8_t curve;        // MixCurve
+    uint8_t sw;           // MixSwitch
+};
+
+// Presets, same numbering as the old RadioSettings::mixMode
+enum MixPreset : uint8_t {
+    MIX_PRESET_NORMAL, MIX_PRESET_VTAIL_A, MIX_PRESET_VTAIL_B, MIX_PRESET_DELTA_A, MIX_PRESET_DELTA_B,
+    MIX_PRESET_COUNT
+};
+
+/**
+ * @brief Replaces all lines with one of the presets (unknown presets clear the mixer).
+ */
+void mixerApplyPreset(MixLine lines[MIX_LINES], uint8_t preset);
+
+/**
+ * @brief Runs the mixer over the 12-bit channel values in place.
+ * @param ch Channel values in MixChannel order. Results are not limited here.
+ */
+void mixerRun(const MixLine lines[MIX_LINES], int ch[MIX_CHANNELS]);
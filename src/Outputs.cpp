@@ -0,0 +1,103 @@
+/**
+ * @file Outputs.cpp
+ * @author Ebrahim Siami
+ * @brief Output layer: one channel frame per tick, fanned out to every active sink
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "Outputs.h"
+
+static OutputSink* sinks[OUTPUT_MAX_SINKS];
+static uint8_t sinkCount = 0;
+
+// Latest frame, what the timed sinks send
+static ChannelFrame latest = {
+    { 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048 },
+    0, 0, 0
+};
+static bool haveFrame = false;
+
+bool outputsAdd(OutputSink& sink) {
+    for (uint8_t i = 0; i < sinkCount; i++) {
+        if (sinks[i] == &sink) return true;
+    }
+    if (sinkCount >= OUTPUT_MAX_SINKS) return false;
+    sink.enabled = false;
+    sink.lastUs = 0;
+    sink.writes = 0;
+    sink.latencyUs = 0;
+    sink.latencyMaxUs = 0;
+    sink.latencyAvgQ4 = 0;
+    sink.writeMaxUs = 0;
+    sink.writeAvgQ4 = 0;
+    sinks[sinkCount++] = &sink;
+    return true;
+}
+
+void outputEnable(OutputSink& sink, bool enable, uint32_t nowUs) {
+    if (enable && !sink.enabled) sink.lastUs = nowUs;
+    sink.enabled = enable;
+}
+
+void outputSetRate(OutputSink& sink, uint16_t hz) {
+    sink.periodUs = hz ? 1000000UL / hz : 0;
+}
+
+void outputsResetLatency() {
+    for (uint8_t i = 0; i < sinkCount; i++) {
+        sinks[i]->latencyMaxUs = 0;
+        sinks[i]->writeMaxUs = 0;
+    }
+}
+
+void outputsBuildFrame(ChannelFrame& frame, const int* ch, uint8_t count, uint32_t sampleUs) {
+    if (count > OUTPUT_CHANNELS) count = OUTPUT_CHANNELS;
+    for (uint8_t i = 0; i < OUTPUT_CHANNELS; i++) {
+        frame.ch[i] = (i < count) ? (uint16_t)constrain(ch[i], 0, 4095) : 2048;
+    }
+    frame.count = count;
+    frame.seq = latest.seq + (haveFrame ? 1 : 0);
+    frame.timeUs = sampleUs;
+}
+
+// write() with the sample -> transmit time of the frame and the time write() itself took
+static void writeSink(OutputSink& s, const ChannelFrame& frame) {
+    uint32_t startUs = micros();
+    uint32_t latency = startUs - frame.timeUs;
+    s.latencyUs = latency;
+    if (latency > s.latencyMaxUs) s.latencyMaxUs = latency;
+    if (s.writes == 0) s.latencyAvgQ4 = latency << 4;
+    else s.latencyAvgQ4 = s.latencyAvgQ4 - (s.latencyAvgQ4 >> 4) + latency;
+
+    s.write(frame);
+
+    uint32_t cost = micros() - startUs;
+    if (cost > s.writeMaxUs) s.writeMaxUs = cost;
+    if (s.writes == 0) s.writeAvgQ4 = cost << 4;
+    else s.writeAvgQ4 = s.writeAvgQ4 - (s.writeAvgQ4 >> 4) + cost;
+    s.writes++;
+}
+
+void outputsPublish(const ChannelFrame& frame) {
+    latest = frame;
+    haveFrame = true;
+
+    for (uint8_t i = 0; i < sinkCount; i++) {
+        OutputSink& s = *sinks[i];
+        if (s.enabled && s.periodUs == 0) writeSink(s, frame);
+    }
+}
+
+void outputsPoll(uint32_t nowUs) {
+    if (!haveFrame) return;     // nothing to send before the first tick
+
+    for (uint8_t i = 0; i < sinkCount; i++) {
+        OutputSink& s = *sinks[i];
+        if (!s.enabled || s.periodUs == 0 || nowUs - s.lastUs < s.periodUs) continue;
+
+        // keep the rate exact, but don't try to catch up after a long stall (display, EEPROM)
+        s.lastUs = (nowUs - s.lastUs >= 2 * s.periodUs) ? nowUs : s.lastUs + s.periodUs;
+        writeSink(s, latest);
+    }
+}
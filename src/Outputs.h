@@ -0,0 +1,107 @@
+/**
+ * @file Outputs.h
+ * @author Ebrahim Siami
+ * @brief Output layer: one channel frame per tick, fanned out to every active sink
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * The channel pipeline runs once per control tick and ends in a ChannelFrame,
+ * the only form the outputs ever see. Each output (NRF24, CRSF module,
+ * simulator stream, ...) is an OutputSink that brings its own packing in
+ * write() and its own rate in periodUs:
+ *
+ *   periodUs == 0   write() right away for every new frame (outputsPublish())
+ *   periodUs  > 0   write() the latest frame on its own clock (outputsPoll())
+ *
+ * Any number of sinks can be enabled at the same time, the pipeline still
+ * runs once. Adding a protocol is one write() function and an outputsAdd().
+ *
+ * Latency: the frame carries the micros() of the ADC sampling it was made
+ * from, and every write() records how long the frame took from there to
+ * the sink (sample -> process -> pack -> start of the transmission). A
+ * once-per-frame sink only waits for the processing of its own tick, a
+ * timed one up to a period on top of that.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+const uint8_t OUTPUT_CHANNELS = 16;
+const uint8_t OUTPUT_MAX_SINKS = 4;
+
+/**
+ * @brief Canonical frame: 16 channels, 12-bit values (0..4095, 2048 center)
+ * in 16-bit slots. Channels past 'count' read center.
+ */
+struct ChannelFrame {
+    uint16_t ch[OUTPUT_CHANNELS];
+    uint8_t  count;       // channels driven by the pipeline
+    uint32_t seq;         // tick number, counts up by one per frame
+    uint32_t timeUs;      // micros() when the inputs of this frame were sampled
+};
+
+struct OutputSink {
+    const char* name;
+    uint32_t periodUs;                           // 0 = once per frame, see above
+    void (*write)(const ChannelFrame& frame);    // packs and sends in this sink's format
+
+    // --- run-time state, owned by the output layer ---
+    bool     enabled = false;
+    uint32_t lastUs = 0;          // last write of a timed sink
+    uint32_t writes = 0;
+    uint32_t latencyUs = 0;       // sample -> write() of the last frame
+    uint32_t latencyMaxUs = 0;    // worst since outputsResetLatency()
+    uint32_t latencyAvgQ4 = 0;    // running average in 1/16 us, each write weighs 1/16
+    uint32_t writeMaxUs = 0;      // longest write() since outputsResetLatency(), the CPU cost of a frame
+    uint32_t writeAvgQ4 = 0;      // running average of write() in 1/16 us, like latencyAvgQ4
+
+    // A sink is defined by the first three, the rest starts out zero
+    constexpr OutputSink(const char* sinkName, uint32_t period, void (*writeFrame)(const ChannelFrame& frame))
+        : name(sinkName), periodUs(period), write(writeFrame) {}
+};
+
+static inline uint32_t outputLatencyAvgUs(const OutputSink& sink) {
+    return sink.latencyAvgQ4 >> 4;
+}
+
+static inline uint32_t outputWriteAvgUs(const OutputSink& sink) {
+    return sink.writeAvgQ4 >> 4;
+}
+
+/**
+ * @brief Registers a sink (disabled until outputEnable()).
+ * @return false if OUTPUT_MAX_SINKS are in use already.
+ */
+bool outputsAdd(OutputSink& sink);
+
+/**
+ * @brief Starts or stops a sink. A timed sink sends its first frame one period later.
+ */
+void outputEnable(OutputSink& sink, bool enable, uint32_t nowUs);
+
+/**
+ * @brief Sets the rate of a timed sink (0 = once per frame).
+ */
+void outputSetRate(OutputSink& sink, uint16_t hz);
+
+/**
+ * @brief Clears the worst case latency and write() time of every sink (the running averages carry on).
+ */
+void outputsResetLatency();
+
+/**
+ * @brief Fills 'frame' from the pipeline output (clamped to 0..4095).
+ * @param sampleUs micros() when the inputs of this tick were read.
+ */
+void outputsBuildFrame(ChannelFrame& frame, const int* ch, uint8_t count, uint32_t sampleUs);
+
+/**
+ * @brief Hands the frame of this tick to the outputs, the once-per-frame sinks write now.
+ */
+void outputsPublish(const ChannelFrame& frame);
+
+/**
+ * @brief Lets every timed sink write the latest frame if its period is up, call from loop().
+ */
+void outputsPoll(uint32_t nowUs);
@@ -0,0 +1,137 @@
+/**
+ * @file PowerControl.cpp
+ * @author Ebrahim Siami
+ * @brief Adaptive NRF24 TX power from ACK probes
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "PowerControl.h"
+
+namespace PowerControl {
+
+static bool     isEnabled = false;
+static uint8_t  paLevel = LEVEL_MAX;
+static uint8_t  packetCount = 0;
+static bool     everAcked = false;
+
+static uint8_t  recentMisses = 0;     // last 8 probes, bit set = no ACK
+static uint16_t cleanProbes = 0;      // ACKed in a row on this level
+static uint32_t cleanSinceMs = 0;
+static uint32_t lastDownMs = 0;
+static uint32_t lastUpMs = 0;
+static uint32_t holdMs = 0;           // no step down this long after lastUpMs
+static uint32_t changes = 0;
+
+// Time spent on each level, for the battery estimate
+static uint32_t levelMs[LEVEL_MAX + 1];
+static uint32_t lastProbeMs = 0;
+static bool     haveLastProbe = false;
+
+static uint8_t countBits(uint8_t v) {
+    uint8_t n = 0;
+    for (; v; v &= v - 1) n++;
+    return n;
+}
+
+void reset(bool enable) {
+    isEnabled = enable;
+    paLevel = LEVEL_MAX;
+    packetCount = 0;
+    everAcked = false;
+    recentMisses = 0;
+    cleanProbes = 0;
+    holdMs = 0;
+    changes = 0;
+    memset(levelMs, 0, sizeof(levelMs));
+    haveLastProbe = false;
+}
+
+bool enabled() {
+    return isEnabled;
+}
+
+bool probeDue() {
+    if (!isEnabled) return false;
+    if (++packetCount < PROBE_EVERY) return false;
+    packetCount = 0;
+    return true;
+}
+
+static void changeTo(uint8_t newLevel, uint32_t nowMs) {
+    if (newLevel > paLevel) {
+        // stepped down not long ago and that level didn't hold: wait longer before the next try
+        bool failedDown = holdMs && nowMs - lastDownMs < FAILED_DOWN_MS;
+        holdMs = failedDown ? (holdMs * 2 < HOLD_MAX_MS ? holdMs * 2 : HOLD_MAX_MS) : HOLD_MS;
+        lastUpMs = nowMs;
+    } else {
+        lastDownMs = nowMs;
+    }
+    paLevel = newLevel;
+    changes++;
+    recentMisses = 0;
+    cleanProbes = 0;
+    cleanSinceMs = nowMs;
+}
+
+bool probeResult(bool acked, uint32_t nowMs) {
+    if (!isEnabled) return false;
+
+    if (haveLastProbe) levelMs[paLevel] += nowMs - lastProbeMs;
+    lastProbeMs = nowMs;
+    haveLastProbe = true;
+
+    recentMisses = (uint8_t)((recentMisses << 1) | (acked ? 0 : 1));
+    if (acked) {
+        everAcked = true;
+        if (cleanProbes < 0xFFFF) cleanProbes++;
+    } else {
+        cleanProbes = 0;
+        cleanSinceMs = nowMs;
+    }
+    if (!everAcked) return false;     // receiver doesn't ACK, nothing to go by: stay at MAX
+
+    uint8_t misses = countBits(recentMisses);
+    if (misses >= UP_MISSES && paLevel < LEVEL_MAX) {
+        changeTo(misses >= JUMP_MISSES ? LEVEL_MAX : paLevel + 1, nowMs);
+        return true;
+    }
+
+    bool holding = holdMs && nowMs - lastUpMs < holdMs;
+    if (paLevel > LEVEL_MIN && !holding && cleanProbes >= WINDOW && nowMs - cleanSinceMs >= STEP_DOWN_MS) {
+        changeTo(paLevel - 1, nowMs);
+        return true;
+    }
+    return false;
+}
+
+uint8_t level() {
+    return paLevel;
+}
+
+bool receiverAcks() {
+    return everAcked;
+}
+
+uint16_t savedMilliAmps() {
+    uint32_t totalMs = 0;
+    uint64_t weighted = 0;
+    for (uint8_t l = 0; l <= LEVEL_MAX; l++) {
+        totalMs += levelMs[l];
+        weighted += (uint64_t)levelMs[l] * (TX_CURRENT_MA[LEVEL_MAX] - TX_CURRENT_MA[l]);
+    }
+    if (totalMs == 0) return 0;
+    return (uint16_t)(weighted * TX_DUTY_PERCENT / 100 / totalMs);
+}
+
+uint8_t runtimeGainPercent() {
+    uint32_t atMax = BASE_CURRENT_MA + (uint32_t)TX_CURRENT_MA[LEVEL_MAX] * TX_DUTY_PERCENT / 100;
+    uint32_t now = atMax - savedMilliAmps();
+    return (uint8_t)((atMax * 100 + now / 2) / now - 100);
+}
+
+uint32_t levelChanges() {
+    return changes;
+}
+
+} // namespace PowerControl
@@ -0,0 +1,91 @@
+/**
+ * @file PowerControl.h
+ * @author Ebrahim Siami
+ * @brief Adaptive NRF24 TX power from ACK probes
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * The link is one-way, there is no telemetry to tell how well the receiver
+ * hears us. So every PROBE_EVERY-th channel packet asks for an ACK (no
+ * retries, the slot keeps its timing) and the ACK rate of those probes is the
+ * link quality:
+ *
+ *   - no probe missed for STEP_DOWN_MS (and at least WINDOW probes): one PA level down
+ *   - UP_MISSES of the last 8 probes missed: one level up, JUMP_MISSES: straight to MAX
+ *   - after a step up no step down for a hold time, doubled every time the
+ *     level it stepped down to didn't hold (up to HOLD_MAX_MS)
+ *
+ * A receiver that never ACKs (auto-ack off on its pipe) gives no information,
+ * the PA then stays at MAX like without the controller. Same after every new
+ * link (radioSetLink()) and when the controller is switched off.
+ *
+ * Radio.cpp sends the probes and sets the PA level, this file only decides.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+namespace PowerControl {
+
+const uint8_t  PROBE_EVERY = 10;          // 50 probes per second at 500 Hz
+const uint8_t  WINDOW = 32;               // probes a level has to pass before the next one down
+const uint8_t  UP_MISSES = 2;             // of the last 8 probes
+const uint8_t  JUMP_MISSES = 4;
+const uint32_t STEP_DOWN_MS = 2000;
+const uint32_t HOLD_MS = 10000;
+const uint32_t HOLD_MAX_MS = 80000;
+const uint32_t FAILED_DOWN_MS = 5000;     // a step up this soon after a step down: that level didn't hold
+
+// PA levels, same numbers as RF24_PA_MIN..RF24_PA_MAX
+const uint8_t LEVEL_MIN = 0;
+const uint8_t LEVEL_MAX = 3;
+
+// Battery estimate. Rough TX currents of an NRF24L01+PA+LNA module per level
+// (the bare chip: 7 / 7.5 / 9 / 11.3 mA), the rest of the transmitter, and
+// the share of a 2 ms slot the radio spends transmitting (32-byte payload + PLL settling).
+const uint16_t TX_CURRENT_MA[LEVEL_MAX + 1] = { 30, 45, 70, 115 };
+const uint16_t BASE_CURRENT_MA = 60;      // MCU, OLED, regulator
+const uint8_t  TX_DUTY_PERCENT = 70;
+
+/**
+ * @brief Back to MAX with no statistics, for a new link or when it's switched on or off.
+ */
+void reset(bool enable);
+
+bool enabled();
+
+/**
+ * @brief Call for every channel packet: true = ask for an ACK on this one.
+ */
+bool probeDue();
+
+/**
+ * @brief Result of a probe.
+ * @return true if the PA level changed, level() is the new one.
+ */
+bool probeResult(bool acked, uint32_t nowMs);
+
+uint8_t level();
+
+/**
+ * @brief A probe was ACKed since the last reset(), so the controller is working.
+ */
+bool receiverAcks();
+
+/**
+ * @brief Average transmitter current saved against a fixed MAX, since the last reset().
+ */
+uint16_t savedMilliAmps();
+
+/**
+ * @brief Battery runtime gained against a fixed MAX, in percent.
+ */
+uint8_t runtimeGainPercent();
+
+/**
+ * @brief Level changes since the last reset().
+ */
+uint32_t levelChanges();
+
+} // namespace PowerControl
@@ -12,6 +12,10 @@
 
 #include "Radio.h"
 #include <SPI.h>
+#include "LatencyTrace.h"
+#include "bind_format.h"
+#include "PowerControl.h"
+#include "RadioDma.h"
 
 // =============================================================================
 // --- Configuration & Globals ---
@@ -19,12 +23,13 @@
 
 bool radioIsOK = false;
 
-// Initialize RF24 Object (CE Pin, CSN Pin defined in Radio.h)
-RF24 radio(RF_CE_PIN, RF_CSN_PIN);
+// Initialize RF24 Object (CE Pin, CSN Pin defined in Radio.h), SPI as fast as the chip goes
+RF24 radio(RF_CE_PIN, RF_CSN_PIN, NRF24_SPI_HZ);
 
-// Radio Pipe Address
+// Radio Pipe Address of an unbound model
 // WARNING: This must strictly match the address defined in the Receiver firmware.
-const uint64_t pipeOut = 0xE8E8F0F0E1LL;
+// Bound models use their own address instead, see Bind.h and radioSetLink().
+const uint64_t pipeOut = Bind::LEGACY_ADDRESS;
 
 // =============================================================================
 // --- Functions ---
@@ -34,10 +39,13 @@ const uint64_t pipeOut = 0xE8E8F0F0E1LL;
  * @brief Initializes the NRF24L01 module.
  *
  * Settings:
- * - Channel: 100 (2.500 GHz - avoids most WiFi interference).
+ * - Channel: 100 (2.500 GHz - avoids most WiFi interference), a bound model
+ *   gets its own channel and address from radioSetLink().
  * - Data Rate: 250kbps (Offers maximum receiver sensitivity/range).
- * - PA Level: MAX (Maximum transmission power).
- * - AutoAck: Disabled (Provides fixed latency, similar to UDP).
+ * - PA Level: MAX (Maximum transmission power), with the adaptive power
+ *   control only as much as the receiver needs (PowerControl.h).
+ * - AutoAck: Disabled (Provides fixed latency, similar to UDP), the adaptive
+ *   power control asks for an ACK on a few packets.
  */
 void setupRadio() {
     SPI.begin();
@@ -49,27 +57,130 @@ void setupRadio() {
     }
 
     radio.openWritingPipe(pipeOut);
-    radio.setChannel(100);
+    radio.setChannel(Bind::LEGACY_CHANNEL);
     radio.setAutoAck(false);           // Disable ACK for consistent loop time
     radio.setDataRate(RF24_250KBPS);   // Best range
     radio.setPALevel(RF24_PA_MAX);     // Max power
     radio.stopListening();             // Ensure Transmitter Mode
+
+#if NRF24_SPI_DMA
+    RadioDma::begin();                 // channel packets over DMA (RadioDma.h)
+#endif
 }
 
-/**
- * @brief Transmits the control data packet over the air.
- * 
- * @param dataToSend The structured data packet containing channel values.
- */
-void sendRadioData(data_t dataToSend) {
-    radio.write(&dataToSend, sizeof(data_t));
+// A probe whose result comes with the next packet (DMA path)
+static bool probeInFlight = false;
+
+// Auto-ack and PA level for the channel packets
+static void applyPower() {
+    RadioDma::finish();
+    probeInFlight = false;
+    if (PowerControl::enabled()) {
+        // channel packets go out with NO_ACK, the probes wait for one: 500 us at most, no retransmit
+        radio.setAutoAck(true);
+        radio.enableDynamicAck();
+        radio.setRetries(1, 0);
+    } else {
+        radio.setAutoAck(false);
+    }
+    radio.setPALevel(PowerControl::level());
+}
+
+void radioSetLink(const uint8_t address[5], uint8_t hopSeed) {
+    RadioDma::finish();     // every RF24 call waits for a DMA upload still going out
+    if (Bind::isBound(address)) {
+        radio.openWritingPipe(Bind::pipeAddress(address));
+        radio.setChannel(Bind::channelOf(hopSeed));
+    } else {
+        radio.openWritingPipe(pipeOut);
+        radio.setChannel(Bind::LEGACY_CHANNEL);
+    }
+    PowerControl::reset(PowerControl::enabled());   // new link, start over at MAX
+    applyPower();
+}
+
+void radioSetAdaptivePower(bool enable) {
+    if (enable == PowerControl::enabled()) return;
+    PowerControl::reset(enable);
+    applyPower();
 }
 
 bool getRadioStatus() {
     return radioIsOK;
 }
 
+void radioPack(const ChannelFrame& frame, data_t& out) {
+    // frame order: roll, pitch, throttle, yaw, aux1..aux4
+    out.roll     = frame.ch[0] >> 1;
+    out.pitch    = frame.ch[1] >> 1;
+    out.throttle = frame.ch[2] >> 1;
+    out.yaw      = frame.ch[3] >> 1;
+    out.aux1     = frame.ch[4] >> 4;
+    out.aux2     = frame.ch[5] >> 4;
+    out.aux3     = frame.ch[6] > 2048;
+    out.aux4     = frame.ch[7] > 2048;
+}
+
+// Redundant frames: history[0] is the frame being sent, history[j] the one j slots back
+static uint8_t redundancy = 0;
+static uint8_t redundantSeq = 0;
+static data_t history[RadioFormat::MAX_DEPTH + 1];
+static bool historyValid = false;
+
+void radioSetRedundancy(uint8_t depth) {
+    redundancy = depth <= RadioFormat::MAX_DEPTH ? depth : RadioFormat::MAX_DEPTH;
+}
+
+static void probeDone(bool acked) {
+    if (PowerControl::probeResult(acked, millis())) {
+        RadioDma::finish();
+        radio.setPALevel(PowerControl::level());
+    }
+}
+
+static void transmit(const void* payload, uint8_t len) {
+    // NO_ACK only exists with dynamic ACK enabled, otherwise the chip drops the payload
+    bool probe = PowerControl::probeDue();
+    bool noAck = PowerControl::enabled() && !probe;
+
+#if NRF24_SPI_DMA
+    RadioDma::TxResult last = RadioDma::write(payload, len, noAck);
+    if (probeInFlight) probeDone(last == RadioDma::TX_SENT);
+    probeInFlight = probe;
+#else
+    bool acked = radio.write(payload, len, noAck);
+    if (probe) probeDone(acked);
+#endif
+}
+
+static void radioWrite(const ChannelFrame& frame) {
+    if (!radioIsOK) return;   // chip not answering, nothing to send to
+
+    if (redundancy == 0) {
+        data_t packet;
+        radioPack(frame, packet);
+        transmit(&packet, sizeof(data_t));
+        historyValid = false;
+    } else {
+        memmove(&history[1], &history[0], RadioFormat::MAX_DEPTH * sizeof(data_t));
+        radioPack(frame, history[0]);
+        if (!historyValid) {
+            // nothing older yet, repeat the current frame (a receiver sees no gap there anyway)
+            for (uint8_t j = 1; j <= RadioFormat::MAX_DEPTH; j++) history[j] = history[0];
+            historyValid = true;
+        }
+
+        uint8_t packet[RadioFormat::MAX_PACKET];
+        uint8_t len = RadioFormat::makeRedundant(history, redundancy, redundantSeq++, packet);
+        transmit(packet, len);
+    }
+    LatencyTrace::mark(SimProto::LAT_RADIO);
+}
+
+OutputSink radioSink("NRF24", 0, radioWrite);
+
 void setRadioPower(bool enable) {
+    RadioDma::finish();
     if (enable) {
         radio.powerUp(); 
         delay(500);
@@ -17,28 +17,13 @@
 
 #include <Arduino.h>
 #include <RF24.h>
+#include "Outputs.h"
+#include "radio_format.h"     // data_t and the redundant packets
 
 // --- Hardware Pin Configuration (STM32 BluePill) ---
 #define RF_CE_PIN  PB8
 #define RF_CSN_PIN PB9
 
-/**
- * @brief Control Data Packet Structure
- * CRITICAL: This structure must match EXACTLY on the Receiver side.
- */
-#pragma pack(push, 1)
-typedef struct {
-    uint16_t roll     : 11;
-    uint16_t pitch    : 11;
-    uint16_t throttle : 11;
-    uint16_t yaw      : 11;
-    uint8_t  aux1     : 8;
-    uint8_t  aux2     : 8;
-    uint8_t  aux3     : 1;
-    uint8_t  aux4     : 1;
-} data_t;
-#pragma pack(pop)
-
 // Global Radio Object (Defined in Radio.cpp)
 extern RF24 radio;
 
@@ -51,15 +36,38 @@ bool getRadioStatus();
  */
 void setupRadio();
 
-/**
- * @brief Sends a single data packet.
- * @param dataToSend The populated data structure.
- */
-void sendRadioData(data_t dataToSend);
-
 /**
  * @brief use it to turn off the radio (like simulator mode)
  **/
 void setRadioPower(bool enable);
 
+/**
+ * @brief Tunes the radio to the link of a model: the bound address and the
+ * channel of its hop seed, or the fixed legacy address if it was never bound.
+ * Also puts auto-ack and power back to normal after a bind, the adaptive
+ * power control starts over at MAX.
+ */
+void radioSetLink(const uint8_t address[5], uint8_t hopSeed);
+
+/**
+ * @brief Adaptive TX power (PowerControl.h): PA level from ACK probes on
+ * some of the channel packets. Off = MAX and no ACKs, as always.
+ */
+void radioSetAdaptivePower(bool enable);
+
+/**
+ * @brief Packs a channel frame the way the receiver expects it:
+ * 11-bit sticks, 8-bit pots, Aux3/Aux4 as single bits.
+ */
+void radioPack(const ChannelFrame& frame, data_t& out);
+
+/**
+ * @brief Redundant frames (radio_format.h): each packet also carries the
+ * last 'depth' frames, 0 = plain data_t packets.
+ */
+void radioSetRedundancy(uint8_t depth);
+
+// Output sink of the NRF24, one packet per control slot (500 Hz), sent as soon as it's packed
+extern OutputSink radioSink;
+
 #endif // RADIO_H
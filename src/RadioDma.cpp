@@ -0,0 +1,151 @@
+/**
+ * @file RadioDma.cpp
+ * @author Ebrahim Siami
+ * @brief NRF24 channel packets over SPI1 + DMA, without waiting for the air
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "RadioDma.h"
+#include "Radio.h"
+
+namespace RadioDma {
+
+// nRF24L01+ commands and STATUS bits
+static const uint8_t CMD_W_REGISTER = 0x20;
+static const uint8_t CMD_W_TX_PAYLOAD = 0xA0;
+static const uint8_t CMD_W_TX_PAYLOAD_NOACK = 0xB0;
+static const uint8_t CMD_FLUSH_TX = 0xE1;
+static const uint8_t REG_STATUS = 0x07;
+static const uint8_t STATUS_TX_DS = 1 << 5;
+static const uint8_t STATUS_MAX_RT = 1 << 4;
+static const uint8_t STATUS_TX_FULL = 1 << 0;
+
+static TxResult resultOf(uint8_t status) {
+    if (status & STATUS_TX_DS) return TX_SENT;
+    if (status & STATUS_MAX_RT) return TX_FAILED;
+    return TX_NONE;
+}
+
+#if defined(STM32F1xx)
+
+// Command byte + the largest static payload, the DMA reads from here
+static uint8_t txBuffer[1 + 32];
+static uint32_t baudBits = 0;
+
+// CSN low and the DMA running, until DMA1_Channel3_IRQHandler() is done
+static volatile bool uploading = false;
+
+// SPI1_TX is wired to DMA1 channel 3 on the F103. The RX side isn't read,
+// so channel 2 stays free for the CRSF UART.
+void begin() {
+    RCC->AHBENR |= RCC_AHBENR_DMA1EN;
+    DMA1_Channel3->CCR = 0;
+    DMA1_Channel3->CPAR = (uint32_t)&SPI1->DR;
+    NVIC_SetPriority(DMA1_Channel3_IRQn, 2);     // short, and CSN going up is what starts the packet
+    NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+
+    // fastest divider that stays within the NRF24 limit: 72 MHz / 8 = 9 MHz
+    uint32_t br = 0;
+    while (br < 7 && HAL_RCC_GetPCLK2Freq() / (2UL << br) > NRF24_SPI_HZ) br++;
+    baudBits = br << SPI_CR1_BR_Pos;
+}
+
+// RF24 sets the SPI up again for its own transfers, so do it here as well
+static void spiTake() {
+    SPI1->CR1 = (SPI1->CR1 & ~SPI_CR1_BR) | baudBits | SPI_CR1_SPE;
+    (void)SPI1->DR;     // anything left over from before
+    (void)SPI1->SR;
+}
+
+// One byte both ways, polled: only the short commands
+static uint8_t spiByte(uint8_t out) {
+    while (!(SPI1->SR & SPI_SR_TXE)) {}
+    *(volatile uint8_t*)&SPI1->DR = out;
+    while (!(SPI1->SR & SPI_SR_RXNE)) {}
+    return (uint8_t)SPI1->DR;
+}
+
+static uint8_t readClearStatus() {
+    digitalWrite(RF_CSN_PIN, LOW);
+    uint8_t status = spiByte(CMD_W_REGISTER | REG_STATUS);
+    spiByte(STATUS_TX_DS | STATUS_MAX_RT);     // write 1 to clear
+    digitalWrite(RF_CSN_PIN, HIGH);
+    return status;
+}
+
+static void flushTx() {
+    digitalWrite(RF_CSN_PIN, LOW);
+    spiByte(CMD_FLUSH_TX);
+    digitalWrite(RF_CSN_PIN, HIGH);
+}
+
+// Starts the transfer and returns, the ~30 us of 33 bytes at 9 MHz go on without the CPU
+static void upload(uint8_t len) {
+    digitalWrite(RF_CSN_PIN, LOW);
+    uploading = true;
+    DMA1_Channel3->CCR = 0;                  // has to be off to load a new count
+    DMA1->IFCR = DMA_IFCR_CGIF3;
+    DMA1_Channel3->CMAR = (uint32_t)txBuffer;
+    DMA1_Channel3->CNDTR = len;
+    SPI1->CR2 |= SPI_CR2_TXDMAEN;
+    DMA1_Channel3->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE | DMA_CCR_EN;   // memory -> SPI, bytes
+}
+
+// Transfer complete: the last byte is in DR, it and the one in the shift
+// register still take ~2 us at 9 MHz. Then CSN goes up and the FIFO takes
+// the payload.
+extern "C" void DMA1_Channel3_IRQHandler() {
+    DMA1->IFCR = DMA_IFCR_CGIF3;
+    DMA1_Channel3->CCR = 0;
+    while (!(SPI1->SR & SPI_SR_TXE) || (SPI1->SR & SPI_SR_BSY)) {}
+    SPI1->CR2 &= ~SPI_CR2_TXDMAEN;
+    (void)SPI1->DR;     // clears RXNE / OVR of the bytes nobody read
+    (void)SPI1->SR;
+    digitalWrite(RF_CSN_PIN, HIGH);
+    uploading = false;
+}
+
+void finish() {
+    while (uploading) {}
+}
+
+TxResult write(const void* payload, uint8_t len, bool noAck) {
+    finish();           // the packet of the last slot, long done by now
+    spiTake();
+    uint8_t status = readClearStatus();
+    if (status & (STATUS_MAX_RT | STATUS_TX_FULL)) flushTx();   // a failed probe stays in the FIFO
+
+    // Static payload width: always all of it, zero padded like RF24 does
+    uint8_t size = radio.getPayloadSize();
+    if (len > size) len = size;
+    txBuffer[0] = noAck ? CMD_W_TX_PAYLOAD_NOACK : CMD_W_TX_PAYLOAD;
+    memcpy(&txBuffer[1], payload, len);
+    memset(&txBuffer[1 + len], 0, size - len);
+    upload(1 + size);
+
+    // RF24 drops CE after its own writes. High already now, the chip sends once CSN is up again.
+    digitalWrite(RF_CE_PIN, HIGH);
+    return resultOf(status);
+}
+
+#else
+
+// No SPI on the host: the RF24 shim takes the packet at once and keeps the
+// STATUS flags like the chip, so the results come one packet late here too
+void begin() {}
+void finish() {}
+
+TxResult write(const void* payload, uint8_t len, bool noAck) {
+    bool sent, failed, rxReady;
+    radio.whatHappened(sent, failed, rxReady);
+    uint8_t status = (sent ? STATUS_TX_DS : 0) | (failed ? STATUS_MAX_RT : 0);
+    if (failed) radio.flush_tx();
+
+    radio.startFastWrite(payload, len, noAck);
+    return resultOf(status);
+}
+
+#endif
+
+} // namespace RadioDma
@@ -0,0 +1,67 @@
+/**
+ * @file RadioDma.h
+ * @author Ebrahim Siami
+ * @brief NRF24 channel packets over SPI1 + DMA, without waiting for the air
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * RF24::write() clocks the payload out byte by byte and then polls the
+ * STATUS register until the packet has left the antenna: 130 us PLL
+ * settling plus the whole 32-byte payload at 250 kbps, well over a
+ * millisecond of every 2 ms slot spent waiting.
+ *
+ * This path does per packet:
+ *   1. one 2-byte exchange: reads STATUS (= how the last packet went) and clears it
+ *   2. W_TX_PAYLOAD(_NOACK) + the zero padded static payload in a single DMA
+ *      transfer, write() returns as soon as it is started
+ *   3. the DMA transfer complete interrupt raises CSN once the SPI is idle
+ *   4. CE stays high, the chip sends it on its own while the slot goes on
+ *
+ * Until the interrupt the SPI belongs to the DMA: anything that talks to the
+ * radio through RF24 calls finish() first.
+ *
+ * The SPI runs at the NRF24's limit (NRF24_SPI_HZ, 9 MHz on the 72 MHz
+ * APB2). Everything else (setup, bind, power) still goes through RF24.
+ *
+ * Build with -D NRF24_SPI_DMA=0 for the old RF24::write() path, to compare
+ * the "pipeline -> RF" stage of the two with -D LATENCY_TRACE.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#ifndef NRF24_SPI_DMA
+#define NRF24_SPI_DMA 1
+#endif
+
+// Highest SPI clock of the NRF24L01+
+#define NRF24_SPI_HZ 10000000UL
+
+namespace RadioDma {
+
+enum TxResult : uint8_t {
+    TX_NONE,      // nothing to tell (no packet before, or it never finished)
+    TX_SENT,      // on the air, and ACKed if it asked for an ACK
+    TX_FAILED     // asked for an ACK and got none
+};
+
+/**
+ * @brief Sets up the DMA channel. After RF24::begin() and the radio settings.
+ */
+void begin();
+
+/**
+ * @brief Hands one payload to the radio and returns right away.
+ * @param noAck W_TX_PAYLOAD_NOACK, needs RF24::enableDynamicAck().
+ * @return What happened to the packet written before this one.
+ */
+TxResult write(const void* payload, uint8_t len, bool noAck);
+
+/**
+ * @brief Waits until the payload of the last write() is in the radio (CSN up).
+ * Returns at once without an upload in flight or with NRF24_SPI_DMA=0.
+ */
+void finish();
+
+} // namespace RadioDma
@@ -7,20 +7,31 @@
  *
  * Description:
  * Defines the 'RadioSettings' structure used to persist configuration data
- * (trims, channel inversions, UI preferences) into the external EEPROM.
+ * (trims, channel inversions, UI preferences) into the flash emulated EEPROM.
  * 
- * WARNING: Changing the order or type of members in this struct will
- * invalidate existing EEPROM data!
+ * This is the in-RAM form. What actually goes to flash is the packed
+ * 'StoredSettings' in SettingsStore.h. If you add a member here, add it to
+ * StoredSettings too, then bump SETTINGS_VERSION and add a migration step
+ * in SettingsStore.cpp, otherwise existing EEPROM data will be reset!
  */
 
 #ifndef SETTINGS_H
 #define SETTINGS_H
 
 #include <Arduino.h>
+#include "Mixer.h"
+#include "Curves.h"
+#include "FlightModes.h"
+#include "LogicalSwitches.h"
 
-struct RadioSettings {
+// Where the channels go (RadioSettings::rfOutput)
+enum RfOutput : uint8_t {
+    RF_OUTPUT_NRF24,      // on-board NRF24L01+ (Radio.h)
+    RF_OUTPUT_CRSF,       // external CRSF module on the UART (CrsfOutput.h)
+    RF_OUTPUT_COUNT
+};
 
-    uint32_t magic;
+struct RadioSettings {
 
     // --- Trim Configuration ---
     // Range: 0 - 4095 (Center: 2048)
@@ -64,10 +75,39 @@ struct RadioSettings {
     uint8_t dualRateYaw;    // CH4
 
     // --- Channels Mix Mode ---
-    uint8_t mixMode;
+    uint8_t mixMode;          // Last applied preset (MixPreset), shown in the menu
+
+    // --- Programmable Mixer ---
+    MixLine mixLines[MIX_LINES];
+
+    // --- Custom Curves ---
+    // One per stick (Roll, Pitch, Throttle, Yaw), call curveBuild() after editing
+    CustomCurve stickCurves[CURVE_CHANNELS];
+
+    // --- Flight Modes ---
+    // Mode 0 is everything above, modes 1-3 are selected with aux3/aux4
+    bool flightModesEnabled;
+    uint16_t flightModeFadeMs;                 // cross-fade time, 0 = switch at once
+    FlightMode flightModes[FLIGHT_MODES - 1];
+
+    // --- Logical Switches ---
+    // Call lsCompile() after editing. The functions below take an LsRef
+    // (Aux3/Aux4 or L1-L16, optionally inverted)
+    LogicalSwitch logicalSwitches[LS_COUNT];
+    uint8_t throttleCutSwitch;    // throttle held at idle while on, LS_REF_NONE = no cut
+    uint8_t timerSwitch;          // timer runs while on, LS_REF_NONE = runs with the throttle
+    uint8_t flightModeSwitch[2];  // mode bit 0 / bit 1 (default Aux3 / Aux4)
+
+    // --- RF Output ---
+    uint8_t rfOutput;             // RfOutput
+    uint16_t crsfRateHz;          // CRSF frames per second, Crsf::RATE_MIN_HZ..RATE_MAX_HZ
+    uint8_t rfRedundancy;         // NRF24: earlier frames repeated in every packet, 0..RadioFormat::MAX_DEPTH
+    bool rfAdaptivePower;         // NRF24: PA level from ACK probes (PowerControl.h), off = always MAX
 
-    // --- Data Integrity ---
-    uint8_t checksum;
+    // --- Binding ---
+    // NRF24 link of this model from the bind procedure (Bind.h), all 0 = never bound (legacy address)
+    uint8_t rfAddress[5];
+    uint8_t hopSeed;
 };
 
 #endif // SETTINGS_H
\ No newline at end of file
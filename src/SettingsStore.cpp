@@ -0,0 +1,763 @@
+/**
+ * @file SettingsStore.cpp
+ * @author Ebrahim Siami
+ * @brief Versioned settings storage with CRC and schema migration
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Adding a new schema version:
+ * 1. keep a copy of the old layout below (RadioSettingsV<n>),
+ * 2. write migrateV<n>toV<n+1>() that upgrades the image in place,
+ * 3. append it to MIGRATIONS[] and bump SETTINGS_VERSION.
+ */
+
+#include "SettingsStore.h"
+#include "Crc.h"
+#include "CrsfOutput.h"
+#include "radio_format.h"
+#include <FlashStorage_STM32.hpp>
+
+// =============================================================================
+// --- Legacy Layouts ---
+// =============================================================================
+
+/**
+ * @brief v1 layout (firmware <= 4.0.1), magic and XOR checksum inside the struct.
+ */
+struct RadioSettingsV1 {
+    uint32_t magic;
+    int trim1, trim2, trim3;
+    int calibMin[4], calibCenter[4], calibMax[4];
+    int epaMin[4], subTrim[4], epaMax[4];
+    int expoRoll, expoPitch, expoYaw;
+    bool buzzerEnabled;
+    bool lightModeEnabled;
+    bool channelInverted[8];
+    bool airplaneMode;
+    bool dualRateEnabled;
+    uint8_t dualRateRoll, dualRatePitch, dualRateYaw;
+    uint8_t mixMode;
+    uint8_t checksum;
+};
+
+/**
+ * @brief v2 layout, plain RadioSettings behind a SettingsHeader.
+ */
+struct RadioSettingsV2 {
+    int trim1, trim2, trim3;
+    int calibMin[4], calibCenter[4], calibMax[4];
+    int epaMin[4], subTrim[4], epaMax[4];
+    int expoRoll, expoPitch, expoYaw;
+    bool buzzerEnabled;
+    bool lightModeEnabled;
+    bool channelInverted[8];
+    bool airplaneMode;
+    bool dualRateEnabled;
+    uint8_t dualRateRoll, dualRatePitch, dualRateYaw;
+    uint8_t mixMode;
+};
+
+/**
+ * @brief v3 layout, StoredSettings before the programmable mixer.
+ */
+#pragma pack(push, 1)
+struct StoredSettingsV3 {
+    int16_t trim[3];
+    int16_t calibMin[4], calibCenter[4], calibMax[4];
+    int16_t epaMin[4], subTrim[4], epaMax[4];
+    int8_t  expo[3];
+    uint8_t flags;
+    uint8_t invertMask;
+    uint8_t dualRate[3];
+    uint8_t mixMode;
+    uint8_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredSettingsV3) == 64, "StoredSettingsV3 size mismatch");
+static_assert(offsetof(StoredSettings, mixLines) == sizeof(StoredSettingsV3),
+              "StoredSettings must start with the v3 layout");
+/**
+ * @brief v4 layout, v3 followed by the mix lines.
+ */
+#pragma pack(push, 1)
+struct StoredSettingsV4 {
+    StoredSettingsV3 base;
+    uint8_t mixLines[MIX_LINES][4];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredSettingsV4) == 128, "StoredSettingsV4 size mismatch");
+
+/**
+ * @brief v5 layout, v4 followed by the custom curves.
+ */
+#pragma pack(push, 1)
+struct StoredSettingsV5 {
+    StoredSettingsV4 base;
+    uint8_t curvePoints[CURVE_CHANNELS];
+    int8_t  curveY[CURVE_CHANNELS][CURVE_MAX_POINTS];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredSettingsV5) == 200, "StoredSettingsV5 size mismatch");
+
+/**
+ * @brief v6 layout, v5 followed by the flight modes.
+ */
+#pragma pack(push, 1)
+struct StoredSettingsV6 {
+    StoredSettingsV5 base;
+    uint16_t flightModeFadeMs;
+    StoredFlightMode flightModes[FLIGHT_MODES - 1];
+    uint8_t reserved2;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredSettingsV6) == 242, "StoredSettingsV6 size mismatch");
+static_assert(offsetof(StoredSettings, flightModeFadeMs) == sizeof(StoredSettingsV5),
+              "v6 must start with the v5 layout");
+static_assert(offsetof(StoredSettings, logicalSwitches) == sizeof(StoredSettingsV6),
+              "v7 must start with the v6 layout");
+
+/**
+ * @brief v7 layout, v6 followed by the logical switches.
+ */
+#pragma pack(push, 1)
+struct StoredSettingsV7 {
+    StoredSettingsV6 base;
+    StoredLogicalSwitch logicalSwitches[LS_COUNT];
+    uint8_t throttleCutSwitch;
+    uint8_t timerSwitch;
+    uint8_t flightModeSwitch[2];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredSettingsV7) == 326, "StoredSettingsV7 size mismatch");
+static_assert(offsetof(StoredSettings, rfOutput) == sizeof(StoredSettingsV7),
+              "v8 must start with the v7 layout");
+
+/**
+ * @brief v8 layout, v7 followed by the RF output.
+ */
+#pragma pack(push, 1)
+struct StoredSettingsV8 {
+    StoredSettingsV7 base;
+    uint8_t rfOutput;
+    uint8_t reserved3;
+    uint16_t crsfRateHz;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredSettingsV8) == 330, "StoredSettingsV8 size mismatch");
+static_assert(offsetof(StoredSettings, rfAddress) == sizeof(StoredSettingsV8),
+              "v9 must start with the v8 layout");
+
+/**
+ * @brief v9 layout, v8 followed by the bind result.
+ */
+#pragma pack(push, 1)
+struct StoredSettingsV9 {
+    StoredSettingsV8 base;
+    uint8_t rfAddress[5];
+    uint8_t hopSeed;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredSettingsV9) == 336, "StoredSettingsV9 size mismatch");
+static_assert(offsetof(StoredSettings, rfRedundancy) == sizeof(StoredSettingsV9),
+              "v10 must start with the v9 layout");
+
+// Scratch space big enough for every layout we know about
+const size_t SETTINGS_IMAGE_MAX = sizeof(StoredSettings) > sizeof(RadioSettingsV1)
+                                ? sizeof(StoredSettings) : sizeof(RadioSettingsV1);
+
+static_assert(sizeof(RadioSettingsV1) <= SETTINGS_IMAGE_MAX, "Scratch too small");
+static_assert(sizeof(RadioSettingsV2) <= SETTINGS_IMAGE_MAX, "Scratch too small");
+static_assert(sizeof(StoredSettingsV7) <= SETTINGS_IMAGE_MAX, "Scratch too small");
+static_assert(sizeof(StoredSettingsV8) <= SETTINGS_IMAGE_MAX, "Scratch too small");
+static_assert(sizeof(StoredSettingsV9) <= SETTINGS_IMAGE_MAX, "Scratch too small");
+
+// =============================================================================
+// --- Migrations ---
+// =============================================================================
+
+typedef bool (*MigrationFn)(uint8_t* image, uint16_t& length);
+
+/**
+ * @brief v1 -> v2: magic and checksum moved out to SettingsHeader.
+ */
+static bool migrateV1toV2(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(RadioSettingsV1)) return false;
+
+    RadioSettingsV1 v1;
+    memcpy(&v1, image, sizeof(v1));
+
+    RadioSettingsV2 v2;
+    memset(&v2, 0, sizeof(v2));
+    v2.trim1 = v1.trim1;
+    v2.trim2 = v1.trim2;
+    v2.trim3 = v1.trim3;
+    for (int i = 0; i < 4; i++) {
+        v2.calibMin[i]    = v1.calibMin[i];
+        v2.calibCenter[i] = v1.calibCenter[i];
+        v2.calibMax[i]    = v1.calibMax[i];
+        v2.epaMin[i]      = v1.epaMin[i];
+        v2.subTrim[i]     = v1.subTrim[i];
+        v2.epaMax[i]      = v1.epaMax[i];
+    }
+    v2.expoRoll  = v1.expoRoll;
+    v2.expoPitch = v1.expoPitch;
+    v2.expoYaw   = v1.expoYaw;
+    v2.buzzerEnabled    = v1.buzzerEnabled;
+    v2.lightModeEnabled = v1.lightModeEnabled;
+    for (int i = 0; i < 8; i++) v2.channelInverted[i] = v1.channelInverted[i];
+    v2.airplaneMode    = v1.airplaneMode;
+    v2.dualRateEnabled = v1.dualRateEnabled;
+    v2.dualRateRoll    = v1.dualRateRoll;
+    v2.dualRatePitch   = v1.dualRatePitch;
+    v2.dualRateYaw     = v1.dualRateYaw;
+    v2.mixMode         = v1.mixMode;
+
+    memcpy(image, &v2, sizeof(v2));
+    length = sizeof(v2);
+    return true;
+}
+
+/**
+ * @brief v2 -> v3: int fields narrowed to int16_t/int8_t, inversion as bitmask.
+ */
+static bool migrateV2toV3(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(RadioSettingsV2)) return false;
+
+    RadioSettingsV2 v2;
+    memcpy(&v2, image, sizeof(v2));
+
+    // v2 has exactly the same members as the in-RAM struct had in v3
+    RadioSettings ram;
+    memset(&ram, 0, sizeof(ram));
+    ram.trim1 = v2.trim1;
+    ram.trim2 = v2.trim2;
+    ram.trim3 = v2.trim3;
+    memcpy(ram.calibMin, v2.calibMin, sizeof(v2.calibMin));
+    memcpy(ram.calibCenter, v2.calibCenter, sizeof(v2.calibCenter));
+    memcpy(ram.calibMax, v2.calibMax, sizeof(v2.calibMax));
+    memcpy(ram.epaMin, v2.epaMin, sizeof(v2.epaMin));
+    memcpy(ram.subTrim, v2.subTrim, sizeof(v2.subTrim));
+    memcpy(ram.epaMax, v2.epaMax, sizeof(v2.epaMax));
+    ram.expoRoll  = v2.expoRoll;
+    ram.expoPitch = v2.expoPitch;
+    ram.expoYaw   = v2.expoYaw;
+    ram.buzzerEnabled    = v2.buzzerEnabled;
+    ram.lightModeEnabled = v2.lightModeEnabled;
+    memcpy(ram.channelInverted, v2.channelInverted, sizeof(v2.channelInverted));
+    ram.airplaneMode    = v2.airplaneMode;
+    ram.dualRateEnabled = v2.dualRateEnabled;
+    ram.dualRateRoll    = v2.dualRateRoll;
+    ram.dualRatePitch   = v2.dualRatePitch;
+    ram.dualRateYaw     = v2.dualRateYaw;
+    ram.mixMode         = v2.mixMode;
+
+    // Today's StoredSettings starts with the v3 layout, keep only that part
+    StoredSettings packed;
+    settingsPack(ram, packed);
+
+    memcpy(image, &packed, sizeof(StoredSettingsV3));
+    length = sizeof(StoredSettingsV3);
+    return true;
+}
+
+static void packMixLines(const MixLine in[MIX_LINES], uint8_t out[MIX_LINES][4]);
+
+/**
+ * @brief v3 -> v4: mix lines appended, filled from the old fixed mixMode.
+ */
+static bool migrateV3toV4(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(StoredSettingsV3)) return false;
+
+    StoredSettingsV4 v4;
+    memcpy(&v4.base, image, sizeof(v4.base));
+
+    MixLine lines[MIX_LINES];
+    mixerApplyPreset(lines, v4.base.mixMode);
+    packMixLines(lines, v4.mixLines);
+
+    memcpy(image, &v4, sizeof(v4));
+    length = sizeof(v4);
+    return true;
+}
+
+/**
+ * @brief v4 -> v5: custom curves appended, all of them off.
+ */
+static bool migrateV4toV5(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(StoredSettingsV4)) return false;
+
+    StoredSettingsV5 v5;
+    memset(&v5, 0, sizeof(v5));
+    memcpy(&v5.base, image, sizeof(v5.base));
+
+    memcpy(image, &v5, sizeof(v5));
+    length = sizeof(v5);
+    return true;
+}
+
+/**
+ * @brief v5 -> v6: flight modes appended with their defaults, switched off.
+ */
+static bool migrateV5toV6(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(StoredSettingsV5)) return false;
+
+    RadioSettings defaults;
+    settingsSetDefaults(defaults);
+
+    StoredSettings v6;
+    settingsPack(defaults, v6);
+    memcpy(&v6, image, sizeof(StoredSettingsV5));
+    v6.flags &= ~STORED_FLAG_FLIGHT_MODES;
+
+    memcpy(image, &v6, sizeof(StoredSettingsV6));
+    length = sizeof(StoredSettingsV6);
+    return true;
+}
+
+/**
+ * @brief v6 -> v7: logical switches appended, all off. Modes keep following Aux3/Aux4.
+ */
+static bool migrateV6toV7(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(StoredSettingsV6)) return false;
+
+    RadioSettings defaults;
+    settingsSetDefaults(defaults);
+
+    StoredSettings v7;
+    settingsPack(defaults, v7);
+    memcpy(&v7, image, sizeof(StoredSettingsV6));
+
+    memcpy(image, &v7, sizeof(StoredSettingsV7));
+    length = sizeof(StoredSettingsV7);
+    return true;
+}
+
+/**
+ * @brief v7 -> v8: RF output appended, stays on the NRF24.
+ */
+static bool migrateV7toV8(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(StoredSettingsV7)) return false;
+
+    RadioSettings defaults;
+    settingsSetDefaults(defaults);
+
+    StoredSettings v8;
+    settingsPack(defaults, v8);
+    memcpy(&v8, image, sizeof(StoredSettingsV7));
+
+    memcpy(image, &v8, sizeof(StoredSettingsV8));
+    length = sizeof(StoredSettingsV8);
+    return true;
+}
+
+/**
+ * @brief v8 -> v9: bind result appended, not bound, so the model stays on the legacy address.
+ */
+static bool migrateV8toV9(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(StoredSettingsV8)) return false;
+
+    RadioSettings defaults;
+    settingsSetDefaults(defaults);
+
+    StoredSettings v9;
+    settingsPack(defaults, v9);
+    memcpy(&v9, image, sizeof(StoredSettingsV8));
+
+    memcpy(image, &v9, sizeof(StoredSettingsV9));
+    length = sizeof(StoredSettingsV9);
+    return true;
+}
+
+/**
+ * @brief v9 -> v10: NRF24 redundancy appended, off (plain packets as before).
+ */
+static bool migrateV9toV10(uint8_t* image, uint16_t& length) {
+    if (length != sizeof(StoredSettingsV9)) return false;
+
+    RadioSettings defaults;
+    settingsSetDefaults(defaults);
+
+    StoredSettings v10;
+    settingsPack(defaults, v10);
+    memcpy(&v10, image, sizeof(StoredSettingsV9));
+
+    memcpy(image, &v10, sizeof(v10));
+    length = sizeof(v10);
+    return true;
+}
+
+// MIGRATIONS[i] upgrades version (i + 1) to version (i + 2)
+static const MigrationFn MIGRATIONS[] = {
+    migrateV1toV2,
+    migrateV2toV3,
+    migrateV3toV4,
+    migrateV4toV5,
+    migrateV5toV6,
+    migrateV6toV7,
+    migrateV7toV8,
+    migrateV8toV9,
+    migrateV9toV10,
+};
+
+static_assert(sizeof(MIGRATIONS) / sizeof(MIGRATIONS[0]) == SETTINGS_VERSION - 1,
+              "Every schema version needs a migration step");
+
+// =============================================================================
+// --- Helpers ---
+// =============================================================================
+
+static uint16_t headerCrc(uint16_t version, uint16_t length, const uint8_t* payload) {
+    uint16_t crc = Crc::crc16((const uint8_t*)&version, sizeof(version));
+    crc = Crc::crc16((const uint8_t*)&length, sizeof(length), crc);
+    return Crc::crc16(payload, length, crc);
+}
+
+static uint8_t legacyChecksum(const RadioSettingsV1& v1) {
+    const uint8_t* p = (const uint8_t*)&v1;
+    uint8_t sum = 0;
+    for (size_t i = 0; i < offsetof(RadioSettingsV1, checksum); i++) {
+        sum ^= p[i];
+    }
+    return sum;
+}
+
+static void packMixLines(const MixLine in[MIX_LINES], uint8_t out[MIX_LINES][4]) {
+    for (uint8_t i = 0; i < MIX_LINES; i++) {
+        out[i][0] = (in[i].source & 0x0F) | (uint8_t)(in[i].destination << 4);
+        out[i][1] = (uint8_t)in[i].weight;
+        out[i][2] = (uint8_t)in[i].offset;
+        out[i][3] = (in[i].curve & 0x0F) | (uint8_t)(in[i].sw << 4);
+    }
+}
+
+static void unpackMixLines(const uint8_t in[MIX_LINES][4], MixLine out[MIX_LINES]) {
+    for (uint8_t i = 0; i < MIX_LINES; i++) {
+        out[i].source      = in[i][0] & 0x0F;
+        out[i].destination = in[i][0] >> 4;
+        out[i].weight      = (int8_t)in[i][1];
+        out[i].offset      = (int8_t)in[i][2];
+        out[i].curve       = in[i][3] & 0x0F;
+        out[i].sw          = in[i][3] >> 4;
+    }
+}
+
+// =============================================================================
+// --- Public API ---
+// =============================================================================
+
+void settingsPack(const RadioSettings& in, StoredSettings& out) {
+    // The 12-bit values (trims, calibration, EPA, sub-trim), int -> int16_t
+    out.trim[0] = (int16_t)in.trim1;
+    out.trim[1] = (int16_t)in.trim2;
+    out.trim[2] = (int16_t)in.trim3;
+    for (uint8_t i = 0; i < 4; i++) {
+        out.calibMin[i]    = (int16_t)in.calibMin[i];
+        out.calibCenter[i] = (int16_t)in.calibCenter[i];
+        out.calibMax[i]    = (int16_t)in.calibMax[i];
+        out.epaMin[i]      = (int16_t)in.epaMin[i];
+        out.subTrim[i]     = (int16_t)in.subTrim[i];
+        out.epaMax[i]      = (int16_t)in.epaMax[i];
+    }
+
+    out.expo[0] = (int8_t)in.expoRoll;
+    out.expo[1] = (int8_t)in.expoPitch;
+    out.expo[2] = (int8_t)in.expoYaw;
+
+    out.flags = 0;
+    if (in.buzzerEnabled)    out.flags |= STORED_FLAG_BUZZER;
+    if (in.lightModeEnabled) out.flags |= STORED_FLAG_LIGHT_MODE;
+    if (in.airplaneMode)     out.flags |= STORED_FLAG_AIRPLANE;
+    if (in.dualRateEnabled)  out.flags |= STORED_FLAG_DUAL_RATE;
+    if (in.flightModesEnabled) out.flags |= STORED_FLAG_FLIGHT_MODES;
+    if (in.rfAdaptivePower)  out.flags |= STORED_FLAG_ADAPTIVE_POWER;
+
+    out.invertMask = 0;
+    for (int i = 0; i < 8; i++) {
+        if (in.channelInverted[i]) out.invertMask |= (1 << i);
+    }
+
+    out.dualRate[0] = in.dualRateRoll;
+    out.dualRate[1] = in.dualRatePitch;
+    out.dualRate[2] = in.dualRateYaw;
+    out.mixMode = in.mixMode;
+    out.reserved = 0;
+    packMixLines(in.mixLines, out.mixLines);
+
+    for (uint8_t i = 0; i < CURVE_CHANNELS; i++) {
+        out.curvePoints[i] = in.stickCurves[i].points;
+        memcpy(out.curveY[i], in.stickCurves[i].y, CURVE_MAX_POINTS);
+    }
+
+    out.flightModeFadeMs = in.flightModeFadeMs;
+    for (uint8_t m = 0; m < FLIGHT_MODES - 1; m++) {
+        const FlightMode& src = in.flightModes[m];
+        StoredFlightMode& dst = out.flightModes[m];
+        for (uint8_t a = 0; a < 3; a++) {
+            dst.trim[a] = (int16_t)src.trim[a];
+            dst.expo[a] = (int8_t)src.expo[a];
+            dst.rate[a] = src.rate[a];
+        }
+        dst.mixMode = src.mixMode;
+    }
+    out.reserved2 = 0;
+
+    for (uint8_t i = 0; i < LS_COUNT; i++) {
+        const LogicalSwitch& src = in.logicalSwitches[i];
+        StoredLogicalSwitch& dst = out.logicalSwitches[i];
+        dst.func  = src.func;
+        dst.a     = src.a;
+        dst.b     = src.b;
+        dst.value = src.value;
+    }
+    out.throttleCutSwitch   = in.throttleCutSwitch;
+    out.timerSwitch         = in.timerSwitch;
+    out.flightModeSwitch[0] = in.flightModeSwitch[0];
+    out.flightModeSwitch[1] = in.flightModeSwitch[1];
+
+    out.rfOutput   = in.rfOutput;
+    out.reserved3  = 0;
+    out.crsfRateHz = in.crsfRateHz;
+
+    memcpy(out.rfAddress, in.rfAddress, sizeof(out.rfAddress));
+    out.hopSeed = in.hopSeed;
+    out.rfRedundancy = in.rfRedundancy;
+    out.reserved4 = 0;
+}
+
+void settingsUnpack(const StoredSettings& in, RadioSettings& out) {
+    memset(&out, 0, sizeof(RadioSettings));
+
+    out.trim1 = in.trim[0];
+    out.trim2 = in.trim[1];
+    out.trim3 = in.trim[2];
+    for (uint8_t i = 0; i < 4; i++) {
+        out.calibMin[i]    = in.calibMin[i];
+        out.calibCenter[i] = in.calibCenter[i];
+        out.calibMax[i]    = in.calibMax[i];
+        out.epaMin[i]      = in.epaMin[i];
+        out.subTrim[i]     = in.subTrim[i];
+        out.epaMax[i]      = in.epaMax[i];
+    }
+
+    out.expoRoll  = in.expo[0];
+    out.expoPitch = in.expo[1];
+    out.expoYaw   = in.expo[2];
+
+    out.buzzerEnabled    = in.flags & STORED_FLAG_BUZZER;
+    out.lightModeEnabled = in.flags & STORED_FLAG_LIGHT_MODE;
+    out.airplaneMode     = in.flags & STORED_FLAG_AIRPLANE;
+    out.dualRateEnabled  = in.flags & STORED_FLAG_DUAL_RATE;
+    out.flightModesEnabled = in.flags & STORED_FLAG_FLIGHT_MODES;
+    out.rfAdaptivePower = in.flags & STORED_FLAG_ADAPTIVE_POWER;
+
+    for (int i = 0; i < 8; i++) {
+        out.channelInverted[i] = (in.invertMask >> i) & 1;
+    }
+
+    out.dualRateRoll  = in.dualRate[0];
+    out.dualRatePitch = in.dualRate[1];
+    out.dualRateYaw   = in.dualRate[2];
+    out.mixMode = in.mixMode;
+    unpackMixLines(in.mixLines, out.mixLines);
+
+    for (uint8_t i = 0; i < CURVE_CHANNELS; i++) {
+        out.stickCurves[i].points = in.curvePoints[i];
+        memcpy(out.stickCurves[i].y, in.curveY[i], CURVE_MAX_POINTS);
+        curveBuild(out.stickCurves[i]);   // also turns off curves with a bad point count
+    }
+
+    out.flightModeFadeMs = in.flightModeFadeMs > FLIGHT_MODE_FADE_MAX_MS ? FLIGHT_MODE_FADE_MAX_MS : in.flightModeFadeMs;
+    for (uint8_t m = 0; m < FLIGHT_MODES - 1; m++) {
+        const StoredFlightMode& src = in.flightModes[m];
+        FlightMode& dst = out.flightModes[m];
+        for (uint8_t a = 0; a < 3; a++) {
+            dst.trim[a] = src.trim[a];
+            dst.expo[a] = src.expo[a];
+            dst.rate[a] = src.rate[a];
+        }
+        dst.mixMode = src.mixMode;
+    }
+
+    // lsCompile() takes care of bad values, nothing to check here
+    for (uint8_t i = 0; i < LS_COUNT; i++) {
+        const StoredLogicalSwitch& src = in.logicalSwitches[i];
+        LogicalSwitch& dst = out.logicalSwitches[i];
+        dst.func  = src.func;
+        dst.a     = src.a;
+        dst.b     = src.b;
+        dst.value = src.value;
+    }
+    out.throttleCutSwitch   = in.throttleCutSwitch;
+    out.timerSwitch         = in.timerSwitch;
+    out.flightModeSwitch[0] = in.flightModeSwitch[0];
+    out.flightModeSwitch[1] = in.flightModeSwitch[1];
+
+    out.rfOutput   = in.rfOutput < RF_OUTPUT_COUNT ? in.rfOutput : (uint8_t)RF_OUTPUT_NRF24;
+    out.crsfRateHz = constrain(in.crsfRateHz, Crsf::RATE_MIN_HZ, Crsf::RATE_MAX_HZ);
+
+    memcpy(out.rfAddress, in.rfAddress, sizeof(out.rfAddress));
+    out.hopSeed = in.hopSeed;
+    out.rfRedundancy = in.rfRedundancy <= RadioFormat::MAX_DEPTH ? in.rfRedundancy : 0;
+}
+
+void settingsSetDefaults(RadioSettings& s) {
+    memset(&s, 0, sizeof(RadioSettings));
+
+    s.trim1 = 2048;
+    s.trim2 = 2048;
+    s.trim3 = 2048;
+    s.airplaneMode = false;
+    s.buzzerEnabled = true;
+    s.lightModeEnabled = false;
+
+    // Be sure about default D/R values
+    s.dualRateRoll = 100;
+    s.dualRatePitch = 100;
+    s.dualRateYaw = 100;
+    s.dualRateEnabled = false;
+
+    for (int i = 0; i < 4; i++) {
+        s.calibMin[i] = 0;
+        s.calibCenter[i] = 2048;
+        s.calibMax[i] = 4095;
+    }
+
+    s.expoRoll = 0;
+    s.expoPitch = 0;
+    s.expoYaw = 0;
+
+    // Default Channels mix
+    s.mixMode = MIX_PRESET_NORMAL;
+    mixerApplyPreset(s.mixLines, s.mixMode);
+
+    // No custom curves (memset above left them at 0 points)
+    for (int i = 0; i < CURVE_CHANNELS; i++) {
+        curveBuild(s.stickCurves[i]);
+    }
+
+    // Flight modes off, modes 1-3 start neutral
+    s.flightModesEnabled = false;
+    s.flightModeFadeMs = 300;
+    flightModesSetDefaults(s);
+
+    // Logical switches all off (memset), modes on the aux switches as before
+    s.throttleCutSwitch = LS_REF_NONE;
+    s.timerSwitch = LS_REF_NONE;
+    s.flightModeSwitch[0] = LS_REF_AUX3;
+    s.flightModeSwitch[1] = LS_REF_AUX4;
+
+    // On-board NRF24, the CRSF rate is only used once a module is selected
+    s.rfOutput = RF_OUTPUT_NRF24;
+    s.crsfRateHz = Crsf::RATE_DEFAULT_HZ;
+    s.rfRedundancy = 0;           // plain packets, every receiver reads them
+    s.rfAdaptivePower = false;    // needs a receiver that ACKs, so MAX unless asked for
+
+    // Never bound, the legacy address until the bind procedure runs
+    memset(s.rfAddress, 0, sizeof(s.rfAddress));
+    s.hopSeed = 0;
+
+    for (int i = 0; i < 8; i++) {
+        s.channelInverted[i] = false;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        s.epaMin[i] = 0;
+        s.subTrim[i] = 2048;
+        s.epaMax[i] = 4095;
+    }
+}
+
+SettingsLoadResult settingsDecodeImage(const uint8_t* image, size_t len, RadioSettings& out) {
+    static uint8_t work[SETTINGS_IMAGE_MAX];
+    uint16_t version;
+    uint16_t length;
+
+    if (len < sizeof(uint32_t)) return SETTINGS_DEFAULTED;
+
+    uint32_t magic;
+    memcpy(&magic, image, sizeof(magic));
+
+    if (magic == SETTINGS_LEGACY_MAGIC) {
+        // v1: the whole struct is the image, no separate header
+        if (len < sizeof(RadioSettingsV1)) return SETTINGS_DEFAULTED;
+
+        RadioSettingsV1 v1;
+        memcpy(&v1, image, sizeof(v1));
+        if (v1.checksum != legacyChecksum(v1)) return SETTINGS_DEFAULTED;
+
+        version = 1;
+        length = sizeof(RadioSettingsV1);
+        memcpy(work, image, length);
+    }
+    else if (magic == SETTINGS_HEADER_MAGIC) {
+        if (len < sizeof(SettingsHeader)) return SETTINGS_DEFAULTED;
+
+        SettingsHeader header;
+        memcpy(&header, image, sizeof(header));
+        version = header.version;
+        length = header.length;
+
+        if (version < 2 || version > SETTINGS_VERSION) return SETTINGS_DEFAULTED;
+        if (length > SETTINGS_IMAGE_MAX || sizeof(header) + length > len) return SETTINGS_DEFAULTED;
+
+        const uint8_t* payload = image + sizeof(header);
+        if (header.crc != headerCrc(version, length, payload)) return SETTINGS_DEFAULTED;
+
+        memcpy(work, payload, length);
+    }
+    else {
+        return SETTINGS_DEFAULTED;
+    }
+
+    // Upgrade one version at a time until we reach the current layout
+    bool migrated = false;
+    while (version < SETTINGS_VERSION) {
+        if (!MIGRATIONS[version - 1](work, length)) return SETTINGS_DEFAULTED;
+        version++;
+        migrated = true;
+    }
+
+    if (length != sizeof(StoredSettings)) return SETTINGS_DEFAULTED;
+
+    StoredSettings stored;
+    memcpy(&stored, work, sizeof(stored));
+    settingsUnpack(stored, out);
+    return migrated ? SETTINGS_MIGRATED : SETTINGS_LOADED;
+}
+
+SettingsLoadResult settingsLoad(RadioSettings& s) {
+    static uint8_t image[sizeof(SettingsHeader) + SETTINGS_IMAGE_MAX];
+
+    EEPROM.get(SETTINGS_EEPROM_ADDRESS, image);
+
+    SettingsLoadResult result = settingsDecodeImage(image, sizeof(image), s);
+    if (result == SETTINGS_DEFAULTED) {
+        settingsSetDefaults(s);
+    }
+    return result;
+}
+
+void settingsSave(const RadioSettings& s) {
+    struct __attribute__((packed)) {
+        SettingsHeader header;
+        StoredSettings payload;
+    } image;
+
+    image.header.magic = SETTINGS_HEADER_MAGIC;
+    image.header.version = SETTINGS_VERSION;
+    image.header.length = sizeof(StoredSettings);
+    image.header.reserved = 0;
+    settingsPack(s, image.payload);
+    image.header.crc = headerCrc(image.header.version, image.header.length, (const uint8_t*)&image.payload);
+
+    noInterrupts();
+    EEPROM.put(SETTINGS_EEPROM_ADDRESS, image);
+    interrupts();
+}
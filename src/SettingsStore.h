@@ -0,0 +1,167 @@
+/**
+ * @file SettingsStore.h
+ * @author Ebrahim Siami
+ * @brief Versioned settings storage with CRC and schema migration
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Settings are stored as a small header followed by a packed payload:
+ *
+ *   [magic:4][version:2][length:2][crc16:2][reserved:2][payload:length]
+ *
+ * The payload is 'StoredSettings', a compact fixed-width copy of the in-RAM
+ * 'RadioSettings'. Keeping them apart lets the UI work with plain ints while
+ * the flash image stays small (338 bytes instead of 768).
+ *
+ * The CRC-16 covers version, length and the payload. When an older layout is
+ * found, it is upgraded step by step (v1 -> v2 -> ...) by the migration table
+ * in SettingsStore.cpp instead of being thrown away.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "Settings.h"
+
+// Flash emulated EEPROM address of the settings header
+#define SETTINGS_EEPROM_ADDRESS 10
+
+// Header magic ("RCST") used since schema v2
+#define SETTINGS_HEADER_MAGIC 0x54534352
+
+// Magic of the original v1 layout (stored inside RadioSettings, XOR checksum)
+#define SETTINGS_LEGACY_MAGIC 0x2C4A1DF2
+
+// Current schema version of StoredSettings
+#define SETTINGS_VERSION 10
+
+#pragma pack(push, 1)
+struct SettingsHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t length;    // payload length in bytes
+    uint16_t crc;       // CRC-16 of version, length and payload
+    uint16_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SettingsHeader) == 12, "SettingsHeader size mismatch");
+
+// StoredSettings::flags
+#define STORED_FLAG_BUZZER     (1 << 0)
+#define STORED_FLAG_LIGHT_MODE (1 << 1)
+#define STORED_FLAG_AIRPLANE   (1 << 2)
+#define STORED_FLAG_DUAL_RATE  (1 << 3)
+#define STORED_FLAG_FLIGHT_MODES (1 << 4)
+#define STORED_FLAG_ADAPTIVE_POWER (1 << 5)   // always 0 before, so older images load with it off
+
+/**
+ * @brief On-flash form of FlightMode.
+ */
+#pragma pack(push, 1)
+struct StoredFlightMode {
+    int16_t trim[3];
+    int8_t  expo[3];
+    uint8_t rate[3];
+    uint8_t mixMode;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredFlightMode) == 13, "StoredFlightMode size mismatch");
+
+/**
+ * @brief On-flash form of LogicalSwitch (same fields, packed).
+ */
+#pragma pack(push, 1)
+struct StoredLogicalSwitch {
+    uint8_t func;
+    uint8_t a;
+    uint8_t b;
+    int16_t value;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredLogicalSwitch) == 5, "StoredLogicalSwitch size mismatch");
+
+/**
+ * @brief On-flash form of RadioSettings (schema v10).
+ * All 12-bit values are int16_t, expo fits in int8_t (-100..100)
+ * and the 8 inversion flags are packed into one bitmask.
+ * A mix line takes 4 bytes: [source | destination << 4][weight][offset][curve | switch << 4].
+ * Curves keep only their point count and the points in percent, the 12-bit
+ * table is rebuilt on load.
+ */
+#pragma pack(push, 1)
+struct StoredSettings {
+    int16_t trim[3];
+    int16_t calibMin[4];
+    int16_t calibCenter[4];
+    int16_t calibMax[4];
+    int16_t epaMin[4];
+    int16_t subTrim[4];
+    int16_t epaMax[4];
+    int8_t  expo[3];          // Roll, Pitch, Yaw
+    uint8_t flags;            // STORED_FLAG_*
+    uint8_t invertMask;       // bit n = CH(n+1) inverted
+    uint8_t dualRate[3];      // Roll, Pitch, Yaw
+    uint8_t mixMode;
+    uint8_t reserved;         // keeps the size even for halfword flash programming
+    uint8_t mixLines[MIX_LINES][4];
+    uint8_t curvePoints[CURVE_CHANNELS];              // 0, 5, 9 or 17
+    int8_t  curveY[CURVE_CHANNELS][CURVE_MAX_POINTS]; // -100..100 %
+    uint16_t flightModeFadeMs;
+    StoredFlightMode flightModes[FLIGHT_MODES - 1];
+    uint8_t reserved2;
+    StoredLogicalSwitch logicalSwitches[LS_COUNT];
+    uint8_t throttleCutSwitch;
+    uint8_t timerSwitch;
+    uint8_t flightModeSwitch[2];
+    uint8_t rfOutput;
+    uint8_t reserved3;
+    uint16_t crsfRateHz;
+    uint8_t rfAddress[5];
+    uint8_t hopSeed;
+    uint8_t rfRedundancy;
+    uint8_t reserved4;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(StoredSettings) == 338, "StoredSettings size mismatch");
+
+/**
+ * @brief Converts between the in-RAM and the on-flash representation.
+ */
+void settingsPack(const RadioSettings& in, StoredSettings& out);
+void settingsUnpack(const StoredSettings& in, RadioSettings& out);
+
+enum SettingsLoadResult : uint8_t {
+    SETTINGS_LOADED,    // current version, CRC ok
+    SETTINGS_MIGRATED,  // older version, upgraded in RAM (caller should save)
+    SETTINGS_DEFAULTED  // missing or corrupted, defaults applied (caller should save)
+};
+
+/**
+ * @brief Fills the structure with factory defaults.
+ */
+void settingsSetDefaults(RadioSettings& s);
+
+/**
+ * @brief Reads, validates and (if needed) migrates the stored settings.
+ */
+SettingsLoadResult settingsLoad(RadioSettings& s);
+
+/**
+ * @brief Writes header + payload to flash in a single EEPROM.put().
+ */
+void settingsSave(const RadioSettings& s);
+
+/**
+ * @brief Validates and migrates a raw settings image (header + payload).
+ * Used by settingsLoad() and usable on its own to check old byte images.
+ *
+ * @param image Stored bytes starting at the header (or at the v1 magic).
+ * @param len Number of valid bytes in 'image'.
+ * @param out Receives the migrated settings on success.
+ * @return SETTINGS_DEFAULTED if the image is unusable ('out' is untouched).
+ */
+SettingsLoadResult settingsDecodeImage(const uint8_t* image, size_t len, RadioSettings& out);
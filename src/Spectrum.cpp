@@ -0,0 +1,110 @@
+/**
+ * @file Spectrum.cpp
+ * @author Ebrahim Siami
+ * @brief 2.4 GHz channel survey with the NRF24 carrier detect (RPD)
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "Spectrum.h"
+#include "Radio.h"
+#include "RadioDma.h"
+
+namespace Spectrum {
+
+static uint8_t  counts[CHANNELS];
+static uint8_t  maxCount = 0;
+static uint16_t sweepCount = 0;
+static uint8_t  channel = 0;
+static bool     tuned = false;      // RF_CH set, waiting DWELL_US before reading RPD
+static uint32_t tunedUs = 0;
+static bool     running = false;
+
+void start() {
+    memset(counts, 0, sizeof(counts));
+    maxCount = 0;
+    sweepCount = 0;
+    channel = 0;
+    tuned = false;
+
+    RadioDma::finish();     // a channel packet may still be going into the FIFO
+    radio.setAutoAck(false);
+    radio.startListening();
+    running = true;
+}
+
+void stop() {
+    if (!running) return;
+    running = false;
+    radio.stopListening();
+}
+
+bool active() {
+    return running;
+}
+
+static void count(uint8_t ch) {
+    if (counts[ch] == 0xFF) {
+        // halve everything instead of overflowing, the shape stays
+        for (uint8_t i = 0; i < CHANNELS; i++) counts[i] >>= 1;
+        maxCount >>= 1;
+    }
+    counts[ch]++;
+    if (counts[ch] > maxCount) maxCount = counts[ch];
+}
+
+void poll(uint32_t nowUs) {
+    if (!running) return;
+
+    if (!tuned) {
+        // RX has to be entered again on the new channel for a fresh RPD
+        digitalWrite(RF_CE_PIN, LOW);
+        radio.setChannel(channel);
+        digitalWrite(RF_CE_PIN, HIGH);
+        tunedUs = nowUs;
+        tuned = true;
+        return;
+    }
+
+    if (nowUs - tunedUs < DWELL_US) return;
+
+    if (radio.testRPD()) count(channel);
+    tuned = false;
+    if (++channel >= CHANNELS) {
+        channel = 0;
+        sweepCount++;
+    }
+}
+
+const uint8_t* hits() {
+    return counts;
+}
+
+uint8_t peak() {
+    return maxCount;
+}
+
+uint16_t sweeps() {
+    return sweepCount;
+}
+
+uint8_t position() {
+    return channel;
+}
+
+uint8_t quietest(uint8_t first, uint8_t count) {
+    uint8_t best = first;
+    uint16_t bestScore = 0xFFFF;
+    for (uint8_t ch = first; ch < first + count && ch < CHANNELS; ch++) {
+        uint16_t score = 2 * counts[ch];
+        if (ch > 0) score += counts[ch - 1];
+        if (ch + 1 < CHANNELS) score += counts[ch + 1];
+        if (score < bestScore) {
+            bestScore = score;
+            best = ch;
+        }
+    }
+    return best;
+}
+
+} // namespace Spectrum
@@ -0,0 +1,77 @@
+/**
+ * @file Spectrum.h
+ * @author Ebrahim Siami
+ * @brief 2.4 GHz channel survey with the NRF24 carrier detect (RPD)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * Sweeps all 126 NRF24 channels (2.400 .. 2.525 GHz) over and over and
+ * counts per channel how often something above -64 dBm was there
+ * (testRPD()). The counts are one byte per channel; when one would
+ * overflow all of them are halved, so the picture keeps its shape and
+ * slowly forgets old traffic.
+ *
+ * poll() does one step per call and never waits: either tune the next
+ * channel (CE low, RF_CH, CE high) or, DWELL_US later, read RPD there. The
+ * radio is in RX meanwhile, so the NRF24 output is off while a scan runs
+ * (main.cpp, applyRfOutput()). Afterwards radioSetLink() puts it back.
+ *
+ * quietest() picks a channel from the result, the bind procedure uses it
+ * for the link (Bind::start()).
+ */
+
+#pragma once
+#include <Arduino.h>
+
+namespace Spectrum {
+
+const uint8_t  CHANNELS = 126;
+const uint32_t DWELL_US = 200;      // RX settling 130 us + 40 us for the AGC, with some slack
+const uint8_t  MIN_SWEEPS = 10;     // before quietest() means something
+
+/**
+ * @brief Starts a new scan, the counts start at 0. The radio must be powered
+ * and the NRF24 output off.
+ */
+void start();
+
+/**
+ * @brief Stops the scan, the counts stay. Call radioSetLink() afterwards.
+ */
+void stop();
+
+bool active();
+
+/**
+ * @brief One step of the scan, call from loop() while active().
+ */
+void poll(uint32_t nowUs);
+
+/**
+ * @brief Hits per channel, CHANNELS of them.
+ */
+const uint8_t* hits();
+
+/**
+ * @brief Highest count, for scaling a bar graph.
+ */
+uint8_t peak();
+
+/**
+ * @brief Full sweeps since start().
+ */
+uint16_t sweeps();
+
+/**
+ * @brief Channel of the running sweep (the one tuned or being measured).
+ */
+uint8_t position();
+
+/**
+ * @brief Quietest channel in first .. first + count - 1. Its neighbours count
+ * too, a busy one next door still bleeds into it.
+ */
+uint8_t quietest(uint8_t first, uint8_t count);
+
+} // namespace Spectrum
@@ -0,0 +1,176 @@
+/**
+ * @file Trainer.cpp
+ * @author Ebrahim Siami
+ * @brief Trainer / HIL mode: channel frames from the host over USB instead of the sticks
+ * @version 4.0.1
+ * @date 2026-10-16
+ */
+
+#include "Trainer.h"
+
+namespace Trainer {
+
+using namespace SimProto;
+
+static const uint16_t RING_MASK = RING_SIZE - 1;
+
+static uint8_t  ring[RING_SIZE];
+static uint16_t head = 0;    // next byte from the USB driver goes here (free running)
+static uint16_t tail = 0;    // first byte not parsed yet (free running)
+
+static uint16_t hostCh[V2_MAX_CHANNELS];
+static uint8_t  hostCount = 0;
+static bool     haveSeq = false;
+static uint8_t  lastSeq = 0;
+static bool     gotFrame = false;    // a good frame since the link went down
+static bool     link = false;
+static uint32_t lastFrameMs = 0;
+
+static Stats st;
+
+// Byte 'i' of the unparsed data
+static inline uint8_t at(uint16_t i) {
+    return ring[(uint16_t)(tail + i) & RING_MASK];
+}
+
+// CRC-16 over 'len' unparsed bytes starting at 'from', in place (two pieces if it wraps)
+static uint16_t ringCrc16(uint16_t from, uint16_t len) {
+    uint16_t start = (uint16_t)(tail + from) & RING_MASK;
+    uint16_t first = RING_SIZE - start;
+    if (first > len) first = len;
+    uint16_t crc = Crc::crc16(&ring[start], first);
+    return Crc::crc16(ring, len - first, crc);
+}
+
+// USB driver queue -> free space of the ring (the one copy), up to its end and then from the start
+static void fill() {
+    while (true) {
+        uint16_t space = RING_SIZE - (uint16_t)(head - tail);
+        int avail = Serial.available();
+        if (space == 0 || avail <= 0) return;
+
+        uint16_t start = head & RING_MASK;
+        uint16_t n = RING_SIZE - start;
+        if (n > space) n = space;
+        if ((int)n > avail) n = (uint16_t)avail;
+        size_t got = Serial.readBytes(&ring[start], n);
+        if (got == 0) return;
+        head += (uint16_t)got;
+    }
+}
+
+static void skip() {
+    tail++;
+    st.skippedBytes++;
+}
+
+// Sequence check and channels of a frame with a good CRC
+static void take(uint32_t nowMs) {
+    uint8_t seq = at(3);
+    if (haveSeq) {
+        uint8_t gap = (uint8_t)(seq - lastSeq - 1);
+        if (gap >= 128) {   // went backwards or repeated
+            st.staleFrames++;
+            return;
+        }
+        st.lostFrames += gap;
+    }
+    haveSeq = true;
+    lastSeq = seq;
+
+    // 12-bit unpacking straight from the ring: [a7..a0] [b3..b0 a11..a8] [b11..b4]
+    uint8_t count = at(4);
+    uint16_t k = HOST_HEADER_SIZE;
+    for (uint8_t i = 0; i < count; i += 2) {
+        uint8_t b0 = at(k++);
+        uint8_t b1 = at(k++);
+        hostCh[i] = (uint16_t)(b0 | ((b1 & 0x0F) << 8));
+        if (i + 1 < count) {
+            hostCh[i + 1] = (uint16_t)((b1 >> 4) | (at(k++) << 4));
+        }
+    }
+    hostCount = count;
+
+    gotFrame = true;
+    lastFrameMs = nowMs;
+    st.frames++;
+}
+
+static void parse(uint32_t nowMs) {
+    while (true) {
+        uint16_t avail = head - tail;
+        if (avail < HOST_HEADER_SIZE) return;
+
+        if (at(0) != HEADER1 || at(1) != HEADER2 || at(2) != HOST_CHANNELS) { skip(); continue; }
+        uint8_t count = at(4);
+        if (count == 0 || count > V2_MAX_CHANNELS) { skip(); continue; }
+
+        uint16_t len = (uint16_t)hostFrameSize(count);
+        if (avail < len) return;
+
+        uint16_t crc = (uint16_t)(at(len - 2) | (at(len - 1) << 8));
+        if (ringCrc16(2, len - 2 - V2_CRC_SIZE) != crc) {
+            st.crcErrors++;
+            skip();
+            continue;
+        }
+
+        take(nowMs);
+        tail += len;
+    }
+}
+
+void begin(uint32_t nowMs) {
+    // whatever the host sent before the mode was on is old news
+    while (Serial.available() > 0) Serial.read();
+
+    head = tail = 0;
+    hostCount = 0;
+    haveSeq = false;
+    gotFrame = false;
+    link = false;
+    lastFrameMs = nowMs;
+    memset(&st, 0, sizeof(st));
+}
+
+void poll(uint32_t nowMs) {
+    fill();
+    parse(nowMs);
+}
+
+LinkEvent update(uint32_t nowMs) {
+    bool fresh = gotFrame && nowMs - lastFrameMs <= TIMEOUT_MS;
+
+    if (!link && fresh) {
+        link = true;
+        return LINK_UP;
+    }
+    if (link && !fresh) {
+        link = false;
+        gotFrame = false;
+        haveSeq = false;    // the host may have restarted, take its next sequence as is
+        st.timeouts++;
+        return LINK_LOST;
+    }
+    return LINK_NONE;
+}
+
+bool linkUp() {
+    return link;
+}
+
+uint8_t apply(int* ch, uint8_t count) {
+    if (!link) return 0;
+
+    uint8_t n = count < hostCount ? count : hostCount;
+    for (uint8_t i = 0; i < n; i++) {
+        ch[i] = hostCh[i];
+    }
+    return n;
+}
+
+const Stats& stats() {
+    return st;
+}
+
+} // namespace Trainer
@@ -0,0 +1,82 @@
+/**
+ * @file Trainer.h
+ * @author Ebrahim Siami
+ * @brief Trainer / HIL mode: channel frames from the host over USB instead of the sticks
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Description:
+ * A PC streams channel frames (sim_protocol_format.h, type 'H') into the USB
+ * port and the transmitter sends them to the model instead of the sticks,
+ * for scripted flight tests and hardware-in-the-loop rigs.
+ *
+ * - CDC bytes are copied once, from the receive queue of the USB driver into
+ *   a ring buffer with Serial.readBytes(), and parsed where they sit there:
+ *   the header, the CRC (over at most two pieces of the ring) and the 12-bit
+ *   channels are all read in place, no frame is assembled in between.
+ * - A frame only counts with a good CRC. Its sequence number has to move
+ *   forward, repeated or older frames are dropped and gaps are counted.
+ * - Watchdog: no good frame for TIMEOUT_MS and the sticks are back in
+ *   control, until the host streams again.
+ *
+ * Host channels replace the pipeline output before the throttle interlock,
+ * so the throttle cut still wins and a fresh source has to bring its throttle
+ * to idle before it goes through (see main.cpp).
+ */
+
+#pragma once
+#include <Arduino.h>
+#include "sim_protocol_format.h"
+
+namespace Trainer {
+
+// No good host frame for this long -> back to the sticks
+const uint32_t TIMEOUT_MS = 100;
+
+// CDC receive ring, a power of two so the indexes just wrap (8 of the biggest frames)
+const uint16_t RING_SIZE = 256;
+
+static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of two");
+static_assert(RING_SIZE >= 2 * SimProto::HOST_MAX_FRAME, "the ring must hold a frame and the start of the next one");
+
+enum LinkEvent : uint8_t {
+    LINK_NONE,
+    LINK_UP,      // host frames are driving the channels
+    LINK_LOST     // watchdog: back to the sticks
+};
+
+struct Stats {
+    uint32_t frames;          // good frames taken
+    uint32_t crcErrors;
+    uint32_t lostFrames;      // counted from sequence gaps
+    uint32_t staleFrames;     // sequence went backwards or repeated, dropped
+    uint32_t skippedBytes;    // dropped while resynchronizing
+    uint32_t timeouts;        // watchdog fell back to the sticks
+};
+
+/**
+ * @brief Starts over: empty ring, link down, stats cleared. Call when the mode is switched on.
+ */
+void begin(uint32_t nowMs);
+
+/**
+ * @brief Moves what the USB driver has into the ring and takes every complete frame, call from loop().
+ */
+void poll(uint32_t nowMs);
+
+/**
+ * @brief Runs the watchdog, call once per control tick before apply().
+ */
+LinkEvent update(uint32_t nowMs);
+
+bool linkUp();
+
+/**
+ * @brief Overwrites the first channels with the latest host frame while the link is up.
+ * @return Number of channels replaced (0 = the sticks are in control).
+ */
+uint8_t apply(int* ch, uint8_t count);
+
+const Stats& stats();
+
+} // namespace Trainer
@@ -0,0 +1,127 @@
+/**
+ * @file bind_format.h
+ * @author Ebrahim Siami
+ * @brief NRF24 bind procedure - addresses, channels and the bind packet
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Plain C++ (no Arduino) so the same definitions are used by the firmware,
+ * the stand-in receiver of the native build and a receiver firmware.
+ *
+ * Every transmitter derives its own 40-bit NRF24 address and a hop seed from
+ * the STM32 unique ID (Bind.h). Binding hands them to the receiver:
+ *
+ *   1. ANNOUNCE on the bind link (BIND_ADDRESS, BIND_CHANNEL) with auto-ack,
+ *      low power, until a receiver in bind mode acknowledges one.
+ *   2. CONFIRM on the new link (the derived address, channelOf(hopSeed)) until
+ *      the receiver acknowledges there too, i.e. it really switched over.
+ *      No ACK within CONFIRM_MS -> back to 1. Every few packets of step 1 are
+ *      a CONFIRM on the new link too, in case the ACK of the ANNOUNCE got lost
+ *      after the receiver took it.
+ *
+ * Bind packet (13 bytes, the radio pads it to its payload size):
+ *   'B' 'D' type version address[5] hopSeed channel crc16
+ *
+ *   type     PACKET_ANNOUNCE or PACKET_CONFIRM
+ *   address  the NRF24 address as openWritingPipe() takes it, byte 0 = LSB
+ *   channel  RF channel of the bound link (= channelOf(hopSeed))
+ *   crc16    CRC-16/CCITT-FALSE over everything before it, little endian
+ *
+ * A receiver that never went through a bind keeps listening on the fixed
+ * LEGACY_ADDRESS / LEGACY_CHANNEL, and so does an unbound transmitter.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "Crc.h"
+
+namespace Bind {
+
+// What every transmitter built from this repo used before binding existed
+const uint64_t LEGACY_ADDRESS = 0xE8E8F0F0E1LL;
+const uint8_t  LEGACY_CHANNEL = 100;
+
+// Bind link, shared by everyone (low power, so only the receiver next to the transmitter hears it)
+const uint64_t BIND_ADDRESS = 0xC3B4A5D2E1LL;
+const uint8_t  BIND_CHANNEL = 5;
+
+// Bound links are spread over 2.476 .. 2.524 GHz, above the usual WiFi channels
+const uint8_t HOP_FIRST = 76;
+const uint8_t HOP_CHANNELS = 49;
+
+const uint8_t ADDRESS_SIZE = 5;
+const uint8_t VERSION = 1;
+
+const uint8_t MAGIC1 = 'B';
+const uint8_t MAGIC2 = 'D';
+
+enum PacketType : uint8_t {
+    PACKET_ANNOUNCE = 1,
+    PACKET_CONFIRM  = 2
+};
+
+const size_t PACKET_SIZE = 13;
+
+/**
+ * @brief Address and hop seed of a bound link.
+ */
+struct Binding {
+    uint8_t address[ADDRESS_SIZE];
+    uint8_t hopSeed;
+};
+
+/**
+ * @brief false for the all-zero address of an unbound model.
+ */
+inline bool isBound(const uint8_t address[ADDRESS_SIZE]) {
+    for (uint8_t i = 0; i < ADDRESS_SIZE; i++) {
+        if (address[i]) return true;
+    }
+    return false;
+}
+
+inline uint8_t channelOf(uint8_t hopSeed) {
+    return (uint8_t)(HOP_FIRST + hopSeed % HOP_CHANNELS);
+}
+
+// address[] -> the 40-bit value of openWritingPipe(uint64_t)
+inline uint64_t pipeAddress(const uint8_t address[ADDRESS_SIZE]) {
+    uint64_t v = 0;
+    for (int8_t i = ADDRESS_SIZE - 1; i >= 0; i--) v = (v << 8) | address[i];
+    return v;
+}
+
+inline void makePacket(PacketType type, const Binding& b, uint8_t out[PACKET_SIZE]) {
+    out[0] = MAGIC1;
+    out[1] = MAGIC2;
+    out[2] = type;
+    out[3] = VERSION;
+    memcpy(&out[4], b.address, ADDRESS_SIZE);
+    out[9] = b.hopSeed;
+    out[10] = channelOf(b.hopSeed);
+    uint16_t crc = Crc::crc16(out, PACKET_SIZE - 2);
+    out[11] = (uint8_t)crc;
+    out[12] = (uint8_t)(crc >> 8);
+}
+
+/**
+ * @brief Checks a received payload (PACKET_SIZE or more bytes, padding ignored).
+ * @return true and 'type' / 'out' filled if it's a good bind packet of our version.
+ */
+inline bool parsePacket(const uint8_t* in, size_t len, PacketType& type, Binding& out) {
+    if (len < PACKET_SIZE || in[0] != MAGIC1 || in[1] != MAGIC2 || in[3] != VERSION) return false;
+    if (in[2] != PACKET_ANNOUNCE && in[2] != PACKET_CONFIRM) return false;
+
+    uint16_t crc = (uint16_t)(in[11] | (in[12] << 8));
+    if (Crc::crc16(in, PACKET_SIZE - 2) != crc) return false;
+    if (in[10] != channelOf(in[9])) return false;
+
+    type = (PacketType)in[2];
+    memcpy(out.address, &in[4], ADDRESS_SIZE);
+    out.hopSeed = in[9];
+    return isBound(out.address);
+}
+
+} // namespace Bind
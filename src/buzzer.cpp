@@ -6,7 +6,7 @@
  * @date 2026-04-18
  */
 
-#include "Buzzer.h"
+#include "buzzer.h"
 
 // ---------- Patterns ----------
 // 1- User Interface Sounds (UI)
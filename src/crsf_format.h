@@ -0,0 +1,94 @@
+/**
+ * @file crsf_format.h
+ * @author Ebrahim Siami
+ * @brief CRSF (Crossfire / ExpressLRS) RC channels frame - wire format
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Plain C++ (no Arduino) so the same definitions are used by the firmware
+ * and by the host tools in tools/.
+ *
+ * RC_CHANNELS_PACKED frame (26 bytes):
+ *   addr len type payload[22] crc8
+ *
+ *   addr    0xEE (transmitter module)
+ *   len     bytes after 'len': type + payload + crc = 24
+ *   type    0x16
+ *   payload 16 channels x 11 bit, little endian bit stream, ch1 in the lowest bits
+ *   crc8    CRC-8/DVB-S2 (poly 0xD5) over type and payload
+ *
+ * Channel values are 172..1811 with 992 at center, which a CRSF receiver
+ * turns into 988..2012 us.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Crsf {
+
+const uint8_t ADDR_MODULE = 0xEE;
+const uint8_t TYPE_RC_CHANNELS = 0x16;
+
+const uint8_t CHANNELS = 16;
+const size_t  PAYLOAD_SIZE = CHANNELS * 11 / 8;     // 22
+const size_t  FRAME_SIZE = 3 + PAYLOAD_SIZE + 1;    // 26
+const uint8_t FRAME_LEN = PAYLOAD_SIZE + 2;         // value of the 'len' byte
+
+// Biggest frame the protocol allows (addr + len + up to 62 bytes)
+const size_t  MAX_FRAME_SIZE = 64;
+
+const uint16_t CHANNEL_MIN = 172;
+const uint16_t CHANNEL_MID = 992;
+const uint16_t CHANNEL_MAX = 1811;
+
+// Module UART speed, the default of TBS and ExpressLRS modules
+const uint32_t BAUD = 400000;
+
+/**
+ * @brief 12-bit channel (0..4095, 2048 center) -> CRSF value (172..1811, 992 center).
+ */
+inline uint16_t from12bit(int v) {
+    if (v < 0) v = 0;
+    if (v > 4095) v = 4095;
+    return (uint16_t)(CHANNEL_MIN + ((uint32_t)v * (CHANNEL_MAX - CHANNEL_MIN) + 2047) / 4095);
+}
+
+/**
+ * @brief CRSF value -> 12-bit channel, the inverse of from12bit() (for the host tools).
+ */
+inline int to12bit(uint16_t v) {
+    if (v < CHANNEL_MIN) v = CHANNEL_MIN;
+    if (v > CHANNEL_MAX) v = CHANNEL_MAX;
+    return (int)(((uint32_t)(v - CHANNEL_MIN) * 4095 + (CHANNEL_MAX - CHANNEL_MIN) / 2) / (CHANNEL_MAX - CHANNEL_MIN));
+}
+
+inline void packChannels(const uint16_t ch[CHANNELS], uint8_t out[PAYLOAD_SIZE]) {
+    uint32_t bits = 0;
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < CHANNELS; i++) {
+        bits |= (uint32_t)(ch[i] & 0x07FF) << count;
+        count += 11;
+        while (count >= 8) {
+            *out++ = (uint8_t)bits;
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+}
+
+inline void unpackChannels(const uint8_t in[PAYLOAD_SIZE], uint16_t ch[CHANNELS]) {
+    uint32_t bits = 0;
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < CHANNELS; i++) {
+        while (count < 11) {
+            bits |= (uint32_t)(*in++) << count;
+            count += 8;
+        }
+        ch[i] = (uint16_t)(bits & 0x07FF);
+        bits >>= 11;
+        count -= 11;
+    }
+}
+
+} // namespace Crsf
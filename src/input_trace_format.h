@@ -0,0 +1,89 @@
+/**
+ * @file input_trace_format.h
+ * @author Ebrahim Siami
+ * @brief Input trace - record format
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Plain C++ (no Arduino), shared by the recorder in the firmware and the
+ * replay driver of the native build.
+ *
+ * A trace is just a stream of 25-byte records, one per ADC tick, with the
+ * raw inputs exactly as the firmware read them (before any filtering):
+ *
+ *   AA BB 'T' seq t:u32 adc[7]:u16 inputs:u16 crc8
+ *
+ *   t       micros() of the tick (wraps after ~71 min, use the differences)
+ *   adc     PA0 roll, PA1 pitch, PA2 throttle, PA3 yaw, PB0 aux1, PB1 aux2, PA4 battery
+ *   inputs  digitalRead() levels, bit order in InputBit below (1 = HIGH)
+ *   crc8    CRC-8 over everything before it
+ *
+ * The header is the one of the simulator protocol with its own type byte,
+ * so a capture of the USB port can be replayed even if it is mixed with
+ * other output: records are found by resyncing on AA BB 'T' and the CRC.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "Crc.h"
+
+namespace InputTrace {
+
+const uint8_t HEADER1 = 0xAA;
+const uint8_t HEADER2 = 0xBB;
+const uint8_t TYPE    = 'T';
+
+const uint8_t ADC_CHANNELS = 7;
+const uint8_t INPUT_COUNT  = 11;
+const size_t  RECORD_SIZE  = 25;
+
+enum AdcChannel : uint8_t {
+    ADC_ROLL, ADC_PITCH, ADC_THROTTLE, ADC_YAW, ADC_AUX1, ADC_AUX2, ADC_BATTERY
+};
+
+enum InputBit : uint8_t {
+    IN_ENTER, IN_UP, IN_DOWN,
+    IN_TRIM1, IN_TRIM2, IN_TRIM3, IN_TRIM4, IN_TRIM5, IN_TRIM6,
+    IN_AUX3, IN_AUX4
+};
+
+struct Record {
+    uint8_t  seq;
+    uint32_t timeUs;
+    uint16_t adc[ADC_CHANNELS];
+    uint16_t inputs;
+};
+
+inline void encode(const Record& r, uint8_t out[RECORD_SIZE]) {
+    out[0] = HEADER1;
+    out[1] = HEADER2;
+    out[2] = TYPE;
+    out[3] = r.seq;
+    for (int i = 0; i < 4; i++) out[4 + i] = (uint8_t)(r.timeUs >> (8 * i));
+    for (int i = 0; i < ADC_CHANNELS; i++) {
+        out[8 + 2 * i] = (uint8_t)r.adc[i];
+        out[9 + 2 * i] = (uint8_t)(r.adc[i] >> 8);
+    }
+    out[22] = (uint8_t)r.inputs;
+    out[23] = (uint8_t)(r.inputs >> 8);
+    out[24] = Crc::crc8(out, RECORD_SIZE - 1);
+}
+
+/**
+ * @brief Decodes one record starting at 'in' (RECORD_SIZE bytes).
+ * @return false if the header or the CRC does not match.
+ */
+inline bool decode(const uint8_t* in, Record& r) {
+    if (in[0] != HEADER1 || in[1] != HEADER2 || in[2] != TYPE) return false;
+    if (Crc::crc8(in, RECORD_SIZE - 1) != in[RECORD_SIZE - 1]) return false;
+
+    r.seq = in[3];
+    r.timeUs = 0;
+    for (int i = 0; i < 4; i++) r.timeUs |= (uint32_t)in[4 + i] << (8 * i);
+    for (int i = 0; i < ADC_CHANNELS; i++) r.adc[i] = (uint16_t)(in[8 + 2 * i] | (in[9 + 2 * i] << 8));
+    r.inputs = (uint16_t)(in[22] | (in[23] << 8));
+    return true;
+}
+
+} // namespace InputTrace
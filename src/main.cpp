@@ -17,9 +17,19 @@
 #include "DisplayManager.h"
 #include "sim_protocol.h" // my own little library to send data
 #include "Settings.h"
-#include "Buzzer.h"
+#include "SettingsStore.h"
+#include "buzzer.h"
 #include "Button.h"
 #include "Radio.h"
+#include "CrsfOutput.h"
+#include "Outputs.h"
+#include "Trainer.h"
+#include "Bind.h"
+#include "Spectrum.h"
+#include "LatencyTrace.h"
+#include "InputTrace.h"
+#include "ChannelPipeline.h"
+#include "Arming.h"
 
 // =============================================================================
 // --- Hardware Configuration & Pin Definitions ---
@@ -42,7 +52,13 @@
 #define BUZZER_PIN PC13
 const int VOLTAGE_PIN = PA4;
 
-#define SETTINGS_MAGIC 0x2C4A1DF2
+// Inputs captured by the input trace recorder, in record order (see input_trace_format.h)
+const uint8_t InputTrace::ADC_PINS[InputTrace::ADC_CHANNELS] = { PA0, PA1, PA2, PA3, PB0, PB1, VOLTAGE_PIN };
+const uint8_t InputTrace::INPUT_PINS[InputTrace::INPUT_COUNT] = {
+    BTN_ENTER, BTN_UP, BTN_DOWN,
+    TRIM_BTN_1, TRIM_BTN_2, TRIM_BTN_3, TRIM_BTN_4, TRIM_BTN_5, TRIM_BTN_6,
+    PB4, PB5
+};
 
 // =============================================================================
 // --- Global Objects & Variables ---
@@ -118,9 +134,24 @@ bool isTimeEditMode = false;
 
 // --- Radio & Telemetry ---
 RadioSettings settings;
-unsigned long lastSendTime = 0;
-const unsigned long SEND_INTERVAL = 2; // ~500Hz Update Rate
-data_t data;
+
+// --- Flight Modes ---
+FlightModeState flightModeState = { 0, 0, 256, 0, 0, 0 };
+MixLine flightModeMixTables[FLIGHT_MODES][MIX_LINES];  // rebuilt by flightModesBuild()
+
+// --- Logical Switches ---
+LsProgram lsProgram;           // rebuilt by lsCompile()
+uint32_t lsState = 0;          // results of the last tick, see lsIsOn()
+int lsChannels[MIX_CHANNELS] = {2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048}; // mixer output of the last tick
+
+// --- Throttle Interlock ---
+ArmingState armingState;       // throttle held at idle until armed, see Arming.h
+
+// --- Outputs ---
+const uint8_t RF_OUTPUT_NONE = RF_OUTPUT_COUNT;   // simulator mode, nothing on the air
+uint8_t activeRfOutput = RF_OUTPUT_NRF24;         // what runs right now, setupRadio() leaves the NRF24 on
+ChannelFrame outputFrame;                         // final channels of the last tick, see Outputs.h
+data_t data;                                      // NRF24 packing of outputFrame
 
 // --- Display Refresh Logic ---
 unsigned long lastDisplayTime = 0;
@@ -143,12 +174,27 @@ int tempCalibMax[4];
 int expoMenuIndex = 0;
 bool isExpoEditMode = false;
 
+// Curve Editor States (0: Back, 1: Channel, 2: Points, 3: Point, 4: Value, 5: Save)
+int curveMenuIndex = 0;
+int curveChannel = 2;         // starts on throttle, the most common one
+int curvePoint = 0;
+bool isCurveEditMode = false;
+
+// Logical Switch Page States (0: Back, 1-4: switch, 5-8: functions, 9: Save)
+int lsMenuIndex = 0;
+int lsIndex = 0;
+bool isLsEditMode = false;
+
+// Channel Survey Page (0: Back, 1: Bind on the quietest channel)
+int spectrumMenuIndex = 0;
+
 // center deadband
 const int deadband = 50;  // NOTE: it depends on the quality of sticks youre using.
 
-// ADC update rate
-unsigned long lastAdcTime = 0;
-const unsigned long ADC_INTERVAL = 2;
+// Control slot: sample -> process -> pack -> transmit, back to back every 2 ms (500 Hz)
+const uint32_t CONTROL_PERIOD_US = 2000;
+uint32_t nextSlotUs = 0;
+unsigned long lastAdcTime = 0;      // millis() of the last slot
 
 // i know everything is Fucking israel fault, fuck zionist forever, fuck jews forever. FUCK they all.
 
@@ -157,6 +203,10 @@ const unsigned long ADC_INTERVAL = 2;
 // true  = Stop sending data packets to radio and send simulator data via USB
 bool simulatorMode;     // by the way im not going to save it in EEPROM for safety reasons.
 
+// --- Trainer / HIL Mode ---
+// true = channel frames from the host over USB drive the outputs while they keep coming (Trainer.h)
+bool trainerMode;       // not saved either, same reason
+
 // =============================================================================
 // --- Helper Functions ---
 // =============================================================================
@@ -232,78 +282,65 @@ void handleLowBatteryAlarm() {
     }
 }
 
-uint8_t calculateChecksum() {
-    uint8_t* data = (uint8_t*)&settings;
-    uint8_t sum = 0;
-    for (size_t i = 0; i < offsetof(RadioSettings, checksum); i++) {
-        sum ^= data[i];
-    }
-    return sum;
-}
-
 void saveSettings() {
-    settings.checksum = calculateChecksum();
-    noInterrupts();
-    EEPROM.put(10, settings);
-    interrupts();
+    settingsSave(settings);
 }
 
-void loadSettings() {
-
-    EEPROM.get(10, settings);
-
-    uint8_t calcChecksum = calculateChecksum();
-
-    bool invalid = (settings.magic != SETTINGS_MAGIC) || (settings.checksum != calculateChecksum());
-
-    if (invalid) {
-
-        memset(&settings, 0, sizeof(RadioSettings));
-
-        settings.magic = SETTINGS_MAGIC;
-
-        settings.trim1 = 2048;
-        settings.trim2 = 2048;
-        settings.trim3 = 2048;
-        settings.airplaneMode = false;
-        settings.buzzerEnabled = true;
-        settings.lightModeEnabled = false;
+/**
+ * @brief Brings the RF hardware and the output sinks in line with settings.rfOutput
+ * and the simulator mode. Only powers what changed, the NRF24 takes 500 ms to power up.
+ */
+void applyRfOutput() {
+    uint8_t wanted = simulatorMode ? RF_OUTPUT_NONE : settings.rfOutput;
 
-        // Be sure about default D/R values
-        settings.dualRateRoll = 100;
-        settings.dualRatePitch = 100;
-        settings.dualRateYaw = 100;
-        settings.dualRateEnabled = false;
+    if (wanted != RF_OUTPUT_NRF24 && Bind::active()) {   // the NRF24 is going off, so is the bind
+        Bind::cancel();
+        radioSetLink(settings.rfAddress, settings.hopSeed);
+    }
+    if (wanted != RF_OUTPUT_NRF24 && Spectrum::active()) {   // ... and the channel survey
+        Spectrum::stop();
+        radioSetLink(settings.rfAddress, settings.hopSeed);
+    }
 
-        // Checking the calibration
-        for (int i = 0; i < 4; i++) {
-            settings.calibMin[i] = 0;
-            settings.calibCenter[i] = 2048;
-            settings.calibMax[i] = 4095;
-        }
+    if (wanted != activeRfOutput) {
+        if (activeRfOutput == RF_OUTPUT_NRF24) setRadioPower(false);
+        if (activeRfOutput == RF_OUTPUT_CRSF) Crsf::end();
 
-        // Checking the Expo values
-        settings.expoRoll = 0;
-        settings.expoPitch = 0;
-        settings.expoYaw = 0;
+        if (wanted == RF_OUTPUT_NRF24) setRadioPower(true);
+        if (wanted == RF_OUTPUT_CRSF) Crsf::begin();
+        activeRfOutput = wanted;
+    }
 
-        // Default Channels mix
-        settings.mixMode = 0;
+    uint32_t now = micros();
+    radioSetRedundancy(settings.rfRedundancy);
+    radioSetAdaptivePower(settings.rfAdaptivePower);
+    outputSetRate(Crsf::sink, settings.crsfRateHz);
+    outputEnable(radioSink, wanted == RF_OUTPUT_NRF24 && !Bind::active() && !Spectrum::active(), now);   // bind packets only while binding
+    outputEnable(Crsf::sink, wanted == RF_OUTPUT_CRSF, now);
+    outputEnable(SimProto::sink, simulatorMode, now);
+}
 
-        // check the invert channl status
-        for (int i = 0; i < 8; i++) {
-            settings.channelInverted[i] = false;
-        }
+/**
+ * @brief Sticks + mixer of one flight mode for the current tick.
+ * @param aux Aux1, Aux2 (12-bit) and the Aux3/Aux4 switches (0/4095).
+ */
+void processFlightMode(uint8_t mode, const int stickRaw[STICK_COUNT], const int aux[4], int ch[MIX_CHANNELS]) {
+    StickParams params;
+    flightModeSticks(settings, mode, params);
+    processSticks(settings, params, deadband, stickRaw, ch);
 
-        for (int i = 0; i < 4; i++) {
-            settings.epaMin[i] = 0;
-            settings.subTrim[i] = 2048;
-            settings.epaMax[i] = 4095;
-        }
+    for (uint8_t i = 0; i < 4; i++) ch[MIX_CH_AUX1 + i] = aux[i];
+    applyMix(settings, flightModeMixTables[mode], ch);
+}
 
-        // finally saves the settings 
+void loadSettings() {
+    // Older layouts are migrated in RAM, corrupted data falls back to defaults.
+    // Either way, write it back once in the current format.
+    if (settingsLoad(settings) != SETTINGS_LOADED) {
         saveSettings();
     }
+    flightModesBuild(settings, flightModeMixTables);
+    lsCompile(settings.logicalSwitches, lsProgram);
 }
 
 bool isThrottleActive(uint8_t thr) {
@@ -324,8 +361,12 @@ void handleTimerLogic(uint8_t currentThrottle) {
         return; 
     }
 
-    // Check if throttle is active to "Run" the clock
-    isTimerRunning = isThrottleActive(currentThrottle);
+    // Check if throttle is active to "Run" the clock (or the timer switch, if one is set)
+    if (settings.timerSwitch == LS_REF_NONE) {
+        isTimerRunning = isThrottleActive(currentThrottle);
+    } else {
+        isTimerRunning = lsIsOn(lsState, settings.timerSwitch);
+    }
 
     if (isTimerRunning) {
         long oldTime = timerRemainingMillis;
@@ -375,6 +416,144 @@ void handleTimerLogic(uint8_t currentThrottle) {
     }
 }
 
+/**
+ * @brief How long the armed timer has been running (input of the logical switches).
+ */
+unsigned long timerElapsedMillis() {
+    if (!isTimerArmed) return 0;
+    if (selectedTimerMinutes <= 0) return timerRemainingMillis;  // stopwatch counts up
+    return (long)selectedTimerMinutes * 60 * 1000 - timerRemainingMillis;
+}
+
+/**
+ * @brief Up/Down on the logical switch page while a row is in edit mode.
+ */
+void editLogicalSwitch(bool up) {
+    LogicalSwitch& sw = settings.logicalSwitches[lsIndex];
+    bool logic = lsIsLogic(sw.func);
+    bool compare = sw.func >= LS_FUNC_GT && sw.func <= LS_FUNC_ABS_LT;
+
+    switch (lsMenuIndex) {
+        case 1:
+            lsIndex = (lsIndex + (up ? 1 : LS_COUNT - 1)) % LS_COUNT;
+            return;
+        case 2: {
+            sw.func = (sw.func + (up ? 1 : LS_FUNC_COUNT - 1)) % LS_FUNC_COUNT;
+            bool nowCompare = sw.func >= LS_FUNC_GT && sw.func <= LS_FUNC_ABS_LT;
+            // a, b and value mean something else now, start over
+            if (lsIsLogic(sw.func) != logic || nowCompare != compare) {
+                sw.a = nowCompare ? (uint8_t)MIX_SRC_THROTTLE : (uint8_t)LS_REF_NONE;
+                sw.b = LS_REF_NONE;
+                sw.value = 0;
+            }
+            break;
+        }
+        case 3:
+            if (logic) sw.a = lsRefStep(sw.a, up);
+            else if (compare) sw.a = (sw.a - 1 + (up ? 1 : MIX_SRC_AUX4 - 1)) % MIX_SRC_AUX4 + 1;  // Roll..Aux4
+            break;
+        case 4:
+            if (logic) sw.b = lsRefStep(sw.b, up);
+            else if (compare) sw.value = constrain(sw.value + (up ? 5 : -5), -100, 100);
+            else if (sw.func == LS_FUNC_TIMER) sw.value = constrain(sw.value + (up ? 10 : -10), 0, LS_TIMER_MAX_S);
+            break;
+        case 5: settings.throttleCutSwitch = lsRefStep(settings.throttleCutSwitch, up); break;
+        case 6: settings.timerSwitch = lsRefStep(settings.timerSwitch, up); break;
+        case 7: settings.flightModeSwitch[0] = lsRefStep(settings.flightModeSwitch[0], up); break;
+        case 8: settings.flightModeSwitch[1] = lsRefStep(settings.flightModeSwitch[1], up); break;
+    }
+    lsCompile(settings.logicalSwitches, lsProgram);
+}
+
+/**
+ * @brief Buzzer feedback of the throttle interlock.
+ */
+void handleArmingEvent(ArmEvent event) {
+    switch (event) {
+        case ARM_EVT_BLOCKED: playBeepEvent(EVT_ERROR); break;    // throttle up, not sending it
+        case ARM_EVT_ARMED:   playBeepEvent(EVT_CONFIRM); break;
+        case ARM_EVT_CUT_ON:
+        case ARM_EVT_CUT_OFF: playBeepEvent(EVT_CLICK); break;
+        default: break;
+    }
+}
+
+void handleTrainerEvent(Trainer::LinkEvent event) {
+    switch (event) {
+        case Trainer::LINK_UP:   playBeepEvent(EVT_CONFIRM); break;
+        case Trainer::LINK_LOST: playBeepEvent(EVT_ERROR); break;   // host went quiet, sticks are back
+        default: break;
+    }
+
+    // New source: its throttle has to be at idle before it goes through
+    if (event != Trainer::LINK_NONE && armingState.state == ARM_ARMED) {
+        armingReset(armingState);
+    }
+}
+
+/**
+ * @brief Starts the bind procedure (Bind.h), only with the NRF24 on the air.
+ */
+void bindStart() {
+    if (activeRfOutput != RF_OUTPUT_NRF24 || !getRadioStatus()) {
+        playBeepEvent(EVT_ERROR);
+        return;
+    }
+
+    // The model loses its link now, on the new one the throttle has to come back to idle first
+    armingReset(armingState);
+
+    // After a channel survey: the quietest channel of the hop range instead of the UID's
+    uint8_t channel = 0;
+    if (Spectrum::sweeps() >= Spectrum::MIN_SWEEPS) {
+        channel = Spectrum::quietest(Bind::HOP_FIRST, Bind::HOP_CHANNELS);
+    }
+    Bind::start(millis(), channel);
+    applyRfOutput();
+    playBeepEvent(EVT_CLICK);
+}
+
+/**
+ * @brief Starts the channel survey (Spectrum.h), the NRF24 listens instead of sending.
+ * @return false without a working NRF24.
+ */
+bool spectrumStart() {
+    if (activeRfOutput != RF_OUTPUT_NRF24 || !getRadioStatus() || Bind::active()) {
+        playBeepEvent(EVT_ERROR);
+        return false;
+    }
+
+    // Same as a bind: no channel packets while it runs
+    armingReset(armingState);
+    Spectrum::start();
+    applyRfOutput();
+    playBeepEvent(EVT_CLICK);
+    return true;
+}
+
+void spectrumStop() {
+    Spectrum::stop();
+    radioSetLink(settings.rfAddress, settings.hopSeed);
+    applyRfOutput();
+}
+
+void handleBindEvent(Bind::Event event) {
+    if (event == Bind::BIND_NONE) return;
+
+    if (event == Bind::BIND_DONE) {
+        const Bind::Binding& b = Bind::result();
+        memcpy(settings.rfAddress, b.address, sizeof(settings.rfAddress));
+        settings.hopSeed = b.hopSeed;
+        saveSettings();
+        playBeepEvent(EVT_CONFIRM);
+    } else {
+        playBeepEvent(EVT_ERROR);    // no receiver answered, the model keeps its old link
+    }
+
+    radioSetLink(settings.rfAddress, settings.hopSeed);
+    applyRfOutput();
+}
+
 void scrollMenu(int &currentIndex, int maxIndex, bool scrollDown) {
     if (scrollDown) {
         currentIndex = (currentIndex + 1) % (maxIndex + 1);
@@ -412,7 +591,7 @@ void checkAutoReturn() {
     }
     
     // 2. In any edit mode - user is actively configuring something
-    if (isTimeEditMode || isDREditMode || isExpoEditMode || isAdvEditMode) {
+    if (isTimeEditMode || isDREditMode || isExpoEditMode || isAdvEditMode || isCurveEditMode || isLsEditMode) {
         resetAutoReturnTimer(); // Don't timeout while editing
         return;
     }
@@ -422,12 +601,20 @@ void checkAutoReturn() {
         resetAutoReturnTimer(); // Don't timeout during calibration
         return;
     }
+
+    // 4. Watching a channel survey, the NRF24 is off anyway until it's left
+    if (currentPage == PAGE_SPECTRUM) {
+        resetAutoReturnTimer();
+        return;
+    }
     
     // Reset all edit mode flags before returning
     isTimeEditMode = false;
     isDREditMode = false;
     isExpoEditMode = false;
     isAdvEditMode = false;
+    isCurveEditMode = false;
+    isLsEditMode = false;
     
     // Return to main page
     currentPage = PAGE_MAIN3;
@@ -459,6 +646,9 @@ void handleNavigationButtons() {
         case PAGE_CHANNELS_ADVANCED: currentMaxIndex = 4; activeIndexPtr = &advChannelSelectIndex; break;
         case PAGE_CHANNEL_CONFIG:    currentMaxIndex = 4; activeIndexPtr = &advConfigMenuIndex; break;
         case PAGE_EXPO: currentMaxIndex = 4; activeIndexPtr = &expoMenuIndex; break;
+        case PAGE_CURVES: currentMaxIndex = 5; activeIndexPtr = &curveMenuIndex; break;
+        case PAGE_LOGIC_SWITCHES: currentMaxIndex = 9; activeIndexPtr = &lsMenuIndex; break;
+        case PAGE_SPECTRUM: currentMaxIndex = 1; activeIndexPtr = &spectrumMenuIndex; break;
     }
 
     // ----------------------
@@ -480,14 +670,24 @@ void handleNavigationButtons() {
             }
         }
         else if (currentPage == PAGE_DUAL_RATE && isDREditMode) {
-            if (drMenuIndex == 2 && settings.dualRateRoll < 100) settings.dualRateRoll += 5;
-            if (drMenuIndex == 3 && settings.dualRatePitch < 100) settings.dualRatePitch += 5;
-            if (drMenuIndex == 4 && settings.dualRateYaw < 100) settings.dualRateYaw += 5;
+            if (drMenuIndex >= 2 && drMenuIndex <= 4) {
+                uint8_t& rate = flightModeRate(settings, flightModeState.active, drMenuIndex - 2);
+                if (rate < 100) rate += 5;
+            }
         }
         else if (currentPage == PAGE_EXPO && isExpoEditMode) {
-            if (expoMenuIndex == 1 && settings.expoRoll < 100) settings.expoRoll += 5;
-            if (expoMenuIndex == 2 && settings.expoPitch < 100) settings.expoPitch += 5;
-            if (expoMenuIndex == 3 && settings.expoYaw < 100) settings.expoYaw += 5;
+            if (expoMenuIndex >= 1 && expoMenuIndex <= 3) {
+                int& expo = flightModeExpo(settings, flightModeState.active, expoMenuIndex - 1);
+                if (expo < 100) expo += 5;
+            }
+        }
+        else if (currentPage == PAGE_CURVES && isCurveEditMode) {
+            CustomCurve& curve = settings.stickCurves[curveChannel];
+            if (curveMenuIndex == 3 && curvePoint < curve.points - 1) curvePoint++;
+            if (curveMenuIndex == 4 && curve.y[curvePoint] < 100) { curve.y[curvePoint] += 5; curveBuild(curve); }
+        }
+        else if (currentPage == PAGE_LOGIC_SWITCHES && isLsEditMode) {
+            editLogicalSwitch(true);
         }
         else if (currentPage == PAGE_CHANNEL_CONFIG && isAdvEditMode) {
             if (advConfigMenuIndex == 1 && settings.epaMin[currentEditingChannel] < 2000) settings.epaMin[currentEditingChannel] += 10;
@@ -522,14 +722,24 @@ void handleNavigationButtons() {
             }
         }
         else if (currentPage == PAGE_DUAL_RATE && isDREditMode) {
-            if (drMenuIndex == 2 && settings.dualRateRoll > 10) settings.dualRateRoll -= 5;
-            if (drMenuIndex == 3 && settings.dualRatePitch > 10) settings.dualRatePitch -= 5;
-            if (drMenuIndex == 4 && settings.dualRateYaw > 10) settings.dualRateYaw -= 5;
+            if (drMenuIndex >= 2 && drMenuIndex <= 4) {
+                uint8_t& rate = flightModeRate(settings, flightModeState.active, drMenuIndex - 2);
+                if (rate > 10) rate -= 5;
+            }
         }
         else if (currentPage == PAGE_EXPO && isExpoEditMode) {
-            if (expoMenuIndex == 1 && settings.expoRoll > -100) settings.expoRoll -= 5;
-            if (expoMenuIndex == 2 && settings.expoPitch > -100) settings.expoPitch -= 5;
-            if (expoMenuIndex == 3 && settings.expoYaw > -100) settings.expoYaw -= 5;
+            if (expoMenuIndex >= 1 && expoMenuIndex <= 3) {
+                int& expo = flightModeExpo(settings, flightModeState.active, expoMenuIndex - 1);
+                if (expo > -100) expo -= 5;
+            }
+        }
+        else if (currentPage == PAGE_CURVES && isCurveEditMode) {
+            CustomCurve& curve = settings.stickCurves[curveChannel];
+            if (curveMenuIndex == 3 && curvePoint > 0) curvePoint--;
+            if (curveMenuIndex == 4 && curve.y[curvePoint] > -100) { curve.y[curvePoint] -= 5; curveBuild(curve); }
+        }
+        else if (currentPage == PAGE_LOGIC_SWITCHES && isLsEditMode) {
+            editLogicalSwitch(false);
         }
         else if (currentPage == PAGE_CHANNEL_CONFIG && isAdvEditMode) {
             if (advConfigMenuIndex == 1 && settings.epaMin[currentEditingChannel] > 0) settings.epaMin[currentEditingChannel] -= 10;
@@ -618,8 +828,22 @@ void handleNavigationButtons() {
                         settings.buzzerEnabled = !settings.buzzerEnabled; saveSettings(); showSavingFeedback(); playBeepEvent(EVT_CONFIRM); break;
                     case SETTING_THROTTLE_MODE:
                         settings.airplaneMode = !settings.airplaneMode; saveSettings(); showSavingFeedback(); playBeepEvent(EVT_CONFIRM); break;
+                    case SETTING_FLIGHT_MODES: {
+                        // Off -> On with 0 / 0.3 / 1 / 2 s cross-fade -> Off
+                        static const uint16_t FADES[] = { 0, 300, 1000, 2000 };
+                        const uint8_t fadeCount = sizeof(FADES) / sizeof(FADES[0]);
+                        uint8_t next = 0;
+                        if (settings.flightModesEnabled) {
+                            while (next < fadeCount && FADES[next] != settings.flightModeFadeMs) next++;
+                            next++;
+                        }
+                        settings.flightModesEnabled = next < fadeCount;
+                        if (settings.flightModesEnabled) settings.flightModeFadeMs = FADES[next];
+                        saveSettings(); showSavingFeedback(); playBeepEvent(EVT_CONFIRM); break;
+                    }
                     case SETTING_RESET_TRIMS:
-                        settings.trim1 = 2048; settings.trim2 = 2048; settings.trim3 = 2048; saveSettings(); showSavingFeedback(); playBeepEvent(EVT_CONFIRM); break;
+                        for (uint8_t a = 0; a < 3; a++) flightModeTrim(settings, flightModeState.active, a) = 2048;
+                        saveSettings(); showSavingFeedback(); playBeepEvent(EVT_CONFIRM); break;
                     case SETTING_CH_INVERT:
                         currentPage = PAGE_CH_INVERT; invertMenuIndex = 0; playBeepEvent(EVT_CLICK); break;
                     case SETTING_INFO:
@@ -642,22 +866,98 @@ void handleNavigationButtons() {
                         expoMenuIndex = 0; 
                         playBeepEvent(EVT_CLICK); 
                         break;
+                    case FEATURE_CURVES:
+                        currentPage = PAGE_CURVES;
+                        curveMenuIndex = 0;
+                        curvePoint = 0;
+                        isCurveEditMode = false;
+                        playBeepEvent(EVT_CLICK);
+                        break;
+                    case FEATURE_LOGIC_SWITCHES:
+                        currentPage = PAGE_LOGIC_SWITCHES;
+                        lsMenuIndex = 0;
+                        isLsEditMode = false;
+                        playBeepEvent(EVT_CLICK);
+                        break;
                     case FEATURE_CALIBRATION:
                         currentPage = PAGE_CALIBRATION; playBeepEvent(EVT_CLICK); break;
                     case FEATURE_CHANNELS_MIX:
-                        settings.mixMode = (settings.mixMode + 1) % 5; // very genius way i learned today!
+                        if (flightModeState.active == 0) {
+                            settings.mixMode = (settings.mixMode + 1) % MIX_PRESET_COUNT; // very genius way i learned today!
+                            mixerApplyPreset(settings.mixLines, settings.mixMode);
+                        } else {
+                            // Modes 1-3 cycle Base (= mode 0 lines) -> presets -> Base
+                            uint8_t& mix = flightModeMix(settings, flightModeState.active);
+                            mix = (mix == FLIGHT_MODE_MIX_BASE) ? 0 : (mix + 1 < MIX_PRESET_COUNT ? mix + 1 : FLIGHT_MODE_MIX_BASE);
+                        }
+                        flightModesBuild(settings, flightModeMixTables);
                         saveSettings();
                         showSavingFeedback();
+                        playBeepEvent(EVT_CONFIRM);
+                        break;
+                    case FEATURE_RF_OUTPUT: {
+                        // NRF24 -> NRF24 x2 -> NRF24 x3 -> CRSF at 150 / 250 / 333 / 500 Hz -> NRF24
+                        static const uint16_t RATES[] = { 150, 250, 333, 500 };
+                        const uint8_t rateCount = sizeof(RATES) / sizeof(RATES[0]);
+                        if (settings.rfOutput == RF_OUTPUT_NRF24 && settings.rfRedundancy < RadioFormat::MAX_DEPTH) {
+                            settings.rfRedundancy++;    // every frame in one more packet
+                        } else {
+                            uint8_t next = 0;
+                            if (settings.rfOutput == RF_OUTPUT_CRSF) {
+                                while (next < rateCount && RATES[next] != settings.crsfRateHz) next++;
+                                next++;
+                            }
+                            settings.rfOutput = next < rateCount ? RF_OUTPUT_CRSF : RF_OUTPUT_NRF24;
+                            if (settings.rfOutput == RF_OUTPUT_CRSF) settings.crsfRateHz = RATES[next];
+                            settings.rfRedundancy = 0;
+                        }
+                        applyRfOutput();
+                        saveSettings(); showSavingFeedback(); playBeepEvent(EVT_CONFIRM); break;
+                    }
+                    case FEATURE_TX_POWER:
+                        settings.rfAdaptivePower = !settings.rfAdaptivePower;
+                        applyRfOutput();
+                        saveSettings(); showSavingFeedback(); playBeepEvent(EVT_CONFIRM); break;
+                    case FEATURE_BIND:
+                        if (Bind::active()) {    // second press cancels
+                            Bind::cancel();
+                            radioSetLink(settings.rfAddress, settings.hopSeed);
+                            applyRfOutput();
+                            playBeepEvent(EVT_CANCEL);
+                        } else {
+                            bindStart();
+                        }
+                        break;
+                    case FEATURE_SPECTRUM:
+                        if (spectrumStart()) {
+                            currentPage = PAGE_SPECTRUM;
+                            spectrumMenuIndex = 0;
+                        }
+                        break;
+                    case FEATURE_TRAINER:
+                        trainerMode = !trainerMode;
+
+                        if (trainerMode) {
+                            if (simulatorMode) { // one user of the USB port at a time
+                                simulatorMode = false;
+                                SimProto::flush();
+                                applyRfOutput();
+                            }
+                            Trainer::begin(millis());
+                        } else if (Trainer::linkUp() && armingState.state == ARM_ARMED) {
+                            armingReset(armingState);   // back to the sticks, same rule as a lost link
+                        }
+
                         playBeepEvent(EVT_CONFIRM);
                         break;
                     case FEATURE_SIMULATOR:
                         simulatorMode = !simulatorMode;
+                        if (simulatorMode) trainerMode = false;
 
-                        if (simulatorMode) {
-                            setRadioPower(false);
-                        } else {
-                            setRadioPower(true);
+                        if (!simulatorMode) {
+                            SimProto::flush(); // don't leave half a batch behind
                         }
+                        applyRfOutput();
 
                         playBeepEvent(EVT_CONFIRM);
                         break;
@@ -803,6 +1103,81 @@ void handleNavigationButtons() {
                     playBeepEvent(EVT_CANCEL); 
                 }
                 break;
+
+            case PAGE_CURVES: {
+                CustomCurve& curve = settings.stickCurves[curveChannel];
+
+                if (curveMenuIndex == 0) {
+                    currentPage = PAGE_FEATURES;
+                    featuresMenuIndex = FEATURE_CURVES;
+                    playBeepEvent(EVT_CANCEL);
+                }
+                else if (curveMenuIndex == 1) {
+                    curveChannel = (curveChannel + 1) % CURVE_CHANNELS;
+                    curvePoint = 0;
+                    playBeepEvent(EVT_CLICK);
+                }
+                else if (curveMenuIndex == 2) {
+                    // Off -> 5 -> 9 -> 17 -> Off, the shape is kept when the count changes
+                    uint8_t next = curve.points == 0 ? 5 : curve.points == 5 ? 9 : curve.points == 9 ? 17 : 0;
+                    curveSetPoints(curve, next);
+                    curvePoint = 0;
+                    playBeepEvent(EVT_CLICK);
+                }
+                else if (curveMenuIndex == 3 || curveMenuIndex == 4) {
+                    if (curve.points == 0) {
+                        playBeepEvent(EVT_ERROR); // nothing to edit while the curve is off
+                    } else {
+                        isCurveEditMode = !isCurveEditMode;
+                        playBeepEvent(isCurveEditMode ? EVT_CLICK : EVT_CONFIRM);
+                    }
+                }
+                else if (curveMenuIndex == 5) {
+                    saveSettings();
+                    showSavingFeedback();
+                    currentPage = PAGE_FEATURES;
+                    featuresMenuIndex = FEATURE_CURVES;
+                    playBeepEvent(EVT_CONFIRM);
+                }
+                break;
+            }
+
+            case PAGE_LOGIC_SWITCHES:
+                if (lsMenuIndex == 0) {
+                    currentPage = PAGE_FEATURES;
+                    featuresMenuIndex = FEATURE_LOGIC_SWITCHES;
+                    playBeepEvent(EVT_CANCEL);
+                }
+                else if (lsMenuIndex == 9) {
+                    saveSettings();
+                    showSavingFeedback();
+                    currentPage = PAGE_FEATURES;
+                    featuresMenuIndex = FEATURE_LOGIC_SWITCHES;
+                    playBeepEvent(EVT_CONFIRM);
+                }
+                else {
+                    isLsEditMode = !isLsEditMode;
+                    playBeepEvent(isLsEditMode ? EVT_CLICK : EVT_CONFIRM);
+                }
+                break;
+
+            case PAGE_SPECTRUM:
+                if (spectrumMenuIndex == 0) {
+                    spectrumStop();
+                    currentPage = PAGE_FEATURES;
+                    featuresMenuIndex = FEATURE_SPECTRUM;
+                    playBeepEvent(EVT_CANCEL);
+                }
+                else if (Spectrum::sweeps() < Spectrum::MIN_SWEEPS) {
+                    playBeepEvent(EVT_ERROR);   // not enough of a picture yet
+                }
+                else {
+                    spectrumStop();
+                    bindStart();               // on the quietest channel, Bind row shows it binding
+                    currentPage = PAGE_FEATURES;
+                    featuresMenuIndex = FEATURE_BIND;
+                }
+                break;
         }
     }
 }
@@ -880,78 +1255,17 @@ void handleTrimButtons() {
         }
     };
 
-    processTrim(trimButton1, settings.trim1, true, 0);  // Roll Trim Up
-    processTrim(trimButton2, settings.trim1, false, 0); // Roll Trim Down
+    // Trim buttons always move the trims of the flight mode that is flown
+    uint8_t fm = flightModeState.active;
 
-    processTrim(trimButton3, settings.trim2, true, 1);  // Pitch Trim Up
-    processTrim(trimButton4, settings.trim2, false, 1); // Pitch Trim Down
+    processTrim(trimButton1, flightModeTrim(settings, fm, 0), true, 0);  // Roll Trim Up
+    processTrim(trimButton2, flightModeTrim(settings, fm, 0), false, 0); // Roll Trim Down
 
-    processTrim(trimButton5, settings.trim3, true, 3);  // Yaw Trim Up
-    processTrim(trimButton6, settings.trim3, false, 3); // Yaw Trim Down
-}
-
-int processChannel(int rawValue,
-                   int calibMin, int calibCenter, int calibMax, int deadband,
-                   int expoPercent,
-                   int dualRatePercent,
-                   int subTrimValue,
-                   bool invert,
-                   int epaMin, int epaMax)
-{
-
-    rawValue = constrain(rawValue, calibMin, calibMax);
-    // its really hard to code without you:(
-
-    // --- Step 2: Calibration & Deadband ---
-    int val;
-    if ((calibCenter - calibMin) < 100 || (calibMax - calibCenter) < 100) {
-        return subTrimValue;
-    }
+    processTrim(trimButton3, flightModeTrim(settings, fm, 1), true, 1);  // Pitch Trim Up
+    processTrim(trimButton4, flightModeTrim(settings, fm, 1), false, 1); // Pitch Trim Down
 
-    if (abs(rawValue - calibCenter) <= deadband) {
-        val = 2048;
-    } else if (rawValue < calibCenter) {
-        val = map(rawValue, calibMin, calibCenter - deadband, 0, 2048);
-    } else {
-        val = map(rawValue, calibCenter + deadband, calibMax, 2048, 4095);
-    }
-    val = constrain(val, 0, 4095);
-
-    // --- Step 3: EXPO ---
-    if (expoPercent != 0) {
-        // Normalize to -1.0 to +1.0
-        float normalized = (val - 2048) / 2048.0f;
-        
-        // Apply EXPO formula
-        float cube = normalized * normalized * normalized; // i think that its much faster than pow
-        float expo = expoPercent / 100.0f;
-        float output = (1.0f - expo) * normalized + expo * cube;
-        
-        // Convert back to 12-bit
-        val = 2048 + (int)(output * 2048.0f);
-    }
-
-    // --- Step 4: Dual Rate (DR) ---
-    if (dualRatePercent < 100) {
-        long offset = val - 2048;
-        offset = (offset * dualRatePercent) / 100;
-        val = 2048 + offset;
-    }
-
-    // --- Step 5: Reverse ---
-    if (invert) {
-        val = 4095 - val;
-    }
-
-    // --- Step 6: Sub-Trim and EPA (End Point Adjustment) ---
-    int result;
-    if (val <= 2048) {
-        result = map(val, 0, 2048, epaMin, subTrimValue);
-    } else {
-        result = map(val, 2048, 4095, subTrimValue, epaMax);
-    }
-
-    return constrain(result, epaMin, epaMax);
+    processTrim(trimButton5, flightModeTrim(settings, fm, 2), true, 3);  // Yaw Trim Up
+    processTrim(trimButton6, flightModeTrim(settings, fm, 2), false, 3); // Yaw Trim Down
 }
 
 // =============================================================================
@@ -984,11 +1298,20 @@ void setup() {
     showSplashScreen("System Init...", 3000);
 
     buzzer.begin(BUZZER_PIN);
+    LatencyTrace::begin();      // nothing unless built with -D LATENCY_TRACE
 
     simulatorMode = false;
+    trainerMode = false;
 
     setupRadio();
     loadSettings();
+    radioSetLink(settings.rfAddress, settings.hopSeed);   // the bound address of this model, if any
+
+    outputsAdd(radioSink);
+    outputsAdd(Crsf::sink);
+    outputsAdd(SimProto::sink);
+    applyRfOutput();            // CRSF module instead of the NRF24 if selected
+    armingReset(armingState);   // no throttle until the stick has been at idle
 
     playBeepEvent(EVT_STARTUP);
 
@@ -1070,18 +1393,58 @@ void loop() {
     // 3.5. Check auto-return to PAGE_MAIN3 on inactivity
     checkAutoReturn();
 
-    // 4. Input Mapping (ADC -> Channel Data)
+    // 3.6. Simulator host may ask for another protocol version
+    if (simulatorMode) {
+        SimProto::poll();
+    }
+
+    // 3.7. Trainer host frames: USB -> ring buffer -> latest channels
+    if (trainerMode) {
+        Trainer::poll(currentTime);
+    }
+
+    // 3.8. Bind procedure: one bind packet every Bind::PACKET_MS instead of the channels
+    if (Bind::active()) {
+        handleBindEvent(Bind::poll(currentTime));
+    }
+
+    // 3.9. Channel survey: one step (tune or read RPD) per loop, never waits
+    if (Spectrum::active()) {
+        Spectrum::poll(micros());
+    }
 
-    if (currentTime - lastAdcTime >= ADC_INTERVAL) {
+    // 4. Control slot: Input Mapping (ADC -> Channel Data) -> pipeline -> outputs
+    // The NRF24 transmits at the end of the slot, right after the frame is made,
+    // so a sample waits only for its own processing and never for a second timer.
+    uint32_t slotUs = micros();
+    if ((int32_t)(slotUs - nextSlotUs) >= 0) {
+        // fixed 2 ms grid, but no burst of slots after a long stall (display, EEPROM)
+        nextSlotUs = (slotUs - nextSlotUs >= CONTROL_PERIOD_US) ? slotUs + CONTROL_PERIOD_US
+                                                                : nextSlotUs + CONTROL_PERIOD_US;
         lastAdcTime = currentTime;
+        LatencyTrace::slotStart();
 
         // a- read the raw value and apply the filter
-        int rawRoll     = applyAnalogFilter(analogRead(PA0), 0);
-        int rawPitch    = applyAnalogFilter(analogRead(PA1), 1);
-        int rawThrottle = applyAnalogFilter(analogRead(PA2), 2);
-        int rawYaw      = applyAnalogFilter(analogRead(PA3), 3);
-        int rawAux1     = applyAnalogFilter(analogRead(PB0), 4);
-        int rawAux2     = applyAnalogFilter(analogRead(PB1), 5);
+        uint32_t sampleUs = micros();
+        uint16_t adc[InputTrace::ADC_CHANNELS];
+        for (uint8_t i = 0; i < 6; i++) {
+            adc[i] = analogRead(InputTrace::ADC_PINS[i]);
+        }
+        LatencyTrace::mark(SimProto::LAT_SAMPLED);
+
+#if defined(INPUT_TRACE_RECORD)
+        if (!simulatorMode) {
+            adc[InputTrace::ADC_BATTERY] = analogRead(VOLTAGE_PIN);
+            InputTrace::record(adc, InputTrace::readInputs());
+        }
+#endif
+
+        int rawRoll     = applyAnalogFilter(adc[InputTrace::ADC_ROLL], 0);
+        int rawPitch    = applyAnalogFilter(adc[InputTrace::ADC_PITCH], 1);
+        int rawThrottle = applyAnalogFilter(adc[InputTrace::ADC_THROTTLE], 2);
+        int rawYaw      = applyAnalogFilter(adc[InputTrace::ADC_YAW], 3);
+        int rawAux1     = applyAnalogFilter(adc[InputTrace::ADC_AUX1], 4);
+        int rawAux2     = applyAnalogFilter(adc[InputTrace::ADC_AUX2], 5);
 
         // if we are in calibration memu
         if (currentPage == PAGE_CALIBRATION && calibStep == 2) {
@@ -1098,157 +1461,84 @@ void loop() {
             if (rawYaw > tempCalibMax[3]) tempCalibMax[3] = rawYaw;
         }
 
-        // --- Combining Sub-Trim and Digital Trim ---
-        int combinedTrimRoll  = settings.subTrim[0] + (settings.trim1 - 2048);
-        int combinedTrimPitch = settings.subTrim[1] + (settings.trim2 - 2048);
-        int combinedTrimYaw   = settings.subTrim[3] + (settings.trim3 - 2048);
-
-        // --- Process main channels ---
-        int roll_12b = processChannel(
-            rawRoll,
-            settings.calibMin[0], settings.calibCenter[0], settings.calibMax[0], deadband,
-            settings.expoRoll,
-            settings.dualRateEnabled ? settings.dualRateRoll : 100,
-            combinedTrimRoll,
-            settings.channelInverted[0],
-            settings.epaMin[0], settings.epaMax[0]
-        );
-
-        int pitch_12b = processChannel(
-            rawPitch,
-            settings.calibMin[1], settings.calibCenter[1], settings.calibMax[1], deadband,
-            settings.expoPitch,
-            settings.dualRateEnabled ? settings.dualRatePitch : 100,
-            combinedTrimPitch,
-            settings.channelInverted[1],
-            settings.epaMin[1], settings.epaMax[1]
-        );
-
-        int yaw_12b = processChannel(
-            rawYaw,
-            settings.calibMin[3], settings.calibCenter[3], settings.calibMax[3], deadband,
-            settings.expoYaw,
-            settings.dualRateEnabled ? settings.dualRateYaw : 100,
-            combinedTrimYaw,
-            settings.channelInverted[3],
-            settings.epaMin[3], settings.epaMax[3]
-        );
-
-        // --- Throttle Logic ---
-        int throttle_calibrated;
-        if (abs(rawThrottle - settings.calibCenter[2]) <= deadband) {
-            throttle_calibrated = 2048;
-        } else {
-            throttle_calibrated = map(rawThrottle, settings.calibMin[2], settings.calibMax[2], 0, 4095);
-        }
-        
-        int throttle_pre_map = throttle_calibrated;
-        if (settings.airplaneMode) {
-            if (throttle_pre_map < 2048) {
-                throttle_pre_map = 0;
-            } else {
-                throttle_pre_map = map(throttle_pre_map, 2048, 4095, 0, 4095);
-            }
-        }
-        
-        // Apply final mapping (Reverse, Subtrim, EPA) for throttle
-        if (settings.channelInverted[2]) {
-            throttle_pre_map = 4095 - throttle_pre_map;
-        }
-        int throttle_12b;
-        if (throttle_pre_map <= 2048) {
-            throttle_12b = map(throttle_pre_map, 0, 2048, settings.epaMin[2], settings.subTrim[2]);
-        } else {
-            throttle_12b = map(throttle_pre_map, 2048, 4095, settings.subTrim[2], settings.epaMax[2]);
-        }
-        throttle_12b = constrain(throttle_12b, settings.epaMin[2], settings.epaMax[2]);
-
         // --- AUX channels and Switches ---
         int aux1_12b = (true ^ settings.channelInverted[4]) ? (4095 - rawAux1) : rawAux1;
         int aux2_12b = (settings.channelInverted[5]) ? (4095 - rawAux2) : rawAux2;
 
         bool aux3Raw = digitalRead(PB4);
-        data.aux3 = settings.channelInverted[6] ? !aux3Raw : aux3Raw;
+        bool aux3 = settings.channelInverted[6] ? !aux3Raw : aux3Raw;
         bool aux4Raw = digitalRead(PB5);
-        data.aux4 = settings.channelInverted[7] ? !aux4Raw : aux4Raw;
+        bool aux4 = settings.channelInverted[7] ? !aux4Raw : aux4Raw;
+
+        // --- Logical switches (channels of the last tick, switches and timer of now) ---
+        LsInputs lsIn;
+        lsSetChannels(lsIn, lsChannels);
+        lsIn.aux3 = aux3;
+        lsIn.aux4 = aux4;
+        lsIn.timerMs = timerElapsedMillis();
+        lsState = lsEvaluate(lsProgram, lsIn, lsState);
+
+        // --- Flight mode from the switches, cross-fade when it changes ---
+        bool modeBit0 = lsIsOn(lsState, settings.flightModeSwitch[0]);
+        bool modeBit1 = lsIsOn(lsState, settings.flightModeSwitch[1]);
+        flightModeUpdate(flightModeState, flightModeFromSwitches(settings, modeBit0, modeBit1),
+                         settings.flightModeFadeMs, millis());
+
+        // --- Calibration, expo, dual rate, EPA, throttle and mixer ---
+        int stickRaw[STICK_COUNT] = { rawRoll, rawPitch, rawThrottle, rawYaw };
+        int auxIn[4] = { aux1_12b, aux2_12b, aux3 ? 4095 : 0, aux4 ? 4095 : 0 };
+        int mixCh[MIX_CHANNELS];
+        processFlightMode(flightModeState.active, stickRaw, auxIn, mixCh);
+
+        if (flightModeState.weight < 256) {
+            int fadeCh[MIX_CHANNELS];
+            processFlightMode(flightModeState.previous, stickRaw, auxIn, fadeCh);
+            flightModeBlend(fadeCh, mixCh, flightModeState.weight, mixCh, MIX_CHANNELS);
+        }
 
-        int final_roll_12b  = roll_12b;
-        int final_pitch_12b = pitch_12b;
-        int final_yaw_12b   = yaw_12b;
+        // --- Trainer / HIL: host channels instead of the sticks while its frames keep coming ---
+        uint8_t hostChannels = 0;
+        if (trainerMode) {
+            handleTrainerEvent(Trainer::update(currentTime));
+            hostChannels = Trainer::apply(mixCh, MIX_CHANNELS);
+        }
 
-        int pitch_offset = pitch_12b - 2048;
-        int roll_offset  = roll_12b - 2048;
-        int yaw_offset   = yaw_12b - 2048;
+        // Switches look at the channels before the throttle cut, else a cut could hold itself
+        memcpy(lsChannels, mixCh, sizeof(lsChannels));
 
-        if (settings.mixMode == 1) { 
-            // Mode V-Tail A (Default)
-            final_pitch_12b = 2048 + (pitch_offset + yaw_offset) / 2;
-            final_yaw_12b   = 2048 + (pitch_offset - yaw_offset) / 2;
-        } 
-        else if (settings.mixMode == 2) { 
-            // Mode V-Tail B (inverted)
-            final_pitch_12b = 2048 + (pitch_offset - yaw_offset) / 2;
-            final_yaw_12b   = 2048 + (pitch_offset + yaw_offset) / 2;
-        }
-        else if (settings.mixMode == 3) { 
-            // Mode Delta A (Default, flying wing)
-            final_roll_12b  = 2048 + (pitch_offset + roll_offset) / 2;
-            final_pitch_12b = 2048 + (pitch_offset - roll_offset) / 2;
-        }
-        else if (settings.mixMode == 4) { 
-            // Mode Delta B (Inverted)
-            final_roll_12b  = 2048 + (pitch_offset - roll_offset) / 2;
-            final_pitch_12b = 2048 + (pitch_offset + roll_offset) / 2;
-        }
+        // --- Last stage: throttle interlock / cut, nothing touches the throttle after this ---
+        // (the stick decides about idle, curve and mixer may keep the output off the EPA end)
+        int throttleIdle = throttleIdleValue(settings);
+        int throttleFromIdle = hostChannels > MIX_CH_THROTTLE ? abs(mixCh[MIX_CH_THROTTLE] - throttleIdle)
+                                                              : throttleStickTravel(rawThrottle, settings);
+        ArmEvent armEvent = armingUpdate(armingState, lsIsOn(lsState, settings.throttleCutSwitch),
+                                         throttleFromIdle, currentTime);
+        mixCh[MIX_CH_THROTTLE] = armingApply(armingState, mixCh[MIX_CH_THROTTLE], throttleIdle);
+        handleArmingEvent(armEvent);
 
-        final_roll_12b  = constrain(final_roll_12b,  settings.epaMin[0], settings.epaMax[0]);
-        final_pitch_12b = constrain(final_pitch_12b, settings.epaMin[1], settings.epaMax[1]);
-        final_yaw_12b   = constrain(final_yaw_12b,   settings.epaMin[3], settings.epaMax[3]);
+        // --- One frame for all outputs, each sink packs and paces it itself ---
+        outputsBuildFrame(outputFrame, mixCh, MIX_CHANNELS, sampleUs);
+        LatencyTrace::mark(SimProto::LAT_PIPELINE);
 
         // i think that mix is almost done, hope it works well
         // if fucking jews allows me, fuck israel fuck trump fuck epstein
         // fuck everything in this fucking world
 
-        // i will shift data 1 bit for main channels and 4 bit for Potentiometers
-        data.roll     = final_roll_12b >> 1;
-        data.pitch    = final_pitch_12b >> 1;
-        data.throttle = throttle_12b >> 1;
-        data.yaw      = final_yaw_12b >> 1;
-        data.aux1     = aux1_12b >> 4;
-        data.aux2     = aux2_12b >> 4;
-        // finished lets test it
-
-        if (simulatorMode) {
-            // fuck everything
-            // we will put simulator sending datas here.
-            SimProto::send(
-                final_roll_12b, 
-                final_pitch_12b, 
-                throttle_12b, 
-                final_yaw_12b, 
-                aux1_12b, 
-                aux2_12b, 
-                data.aux3, 
-                data.aux4
-            ); 
-            // god, pls pls pls help me
-            // its 3 am and i still work on this way
-            // the fact is that i cant use usb HID in STM32Duino core and iBUS doesnt works well on USB CDC
-            // i think that its duo to the packets sizes and timings of simulated serial, so im testing this way.
-        }
+        // The dashboard, the flight timer and the replay look at the NRF24 packing
+        radioPack(outputFrame, data);
+
+        // Once-per-frame sinks (NRF24, simulator stream) write now, the timed ones in step 5
+        // the fact is that i cant use usb HID in STM32Duino core and iBUS doesnt works well on USB CDC
+        // i think that its duo to the packets sizes and timings of simulated serial, so im testing this way.
+        outputsPublish(outputFrame);
 
         handleTimerLogic(data.throttle);
     }
 
     unsigned long t8 = millis();
 
-    // 5. Radio Transmission
-    if (currentTime - lastSendTime >= SEND_INTERVAL) {
-        lastSendTime = currentTime;
-        if (!simulatorMode && getRadioStatus() == true) {  // send data only when radio is connected and sim is off.
-            sendRadioData(data);
-        }
-    }
+    // 5. Timed outputs (CRSF at 150-500 Hz on its own clock), the NRF24 went out in the slot
+    outputsPoll(micros());
 
     unsigned long t9 = millis();
 
@@ -1279,6 +1569,10 @@ void loop() {
 //   Serial.print("Update NavigationButtons: "); Serial.println(t7 - t6);
 //   Serial.print("Update Input Mapping(4): ");  Serial.println(t8 - t7);
 //   Serial.print("Update RadioSend: ");         Serial.println(t9 - t8);
+//   Serial.print("Sample->TX us (avg/max): ");  Serial.print(outputLatencyAvgUs(radioSink));
+//   Serial.print(" / ");                        Serial.println(radioSink.latencyMaxUs);
+//   Serial.print("NRF24 write us (avg/max): "); Serial.print(outputWriteAvgUs(radioSink));   // CPU per packet, build
+//   Serial.print(" / ");                        Serial.println(radioSink.writeMaxUs);        // once more with NRF24_SPI_DMA=0
 //   Serial.print("Update Screen: ");            Serial.println(t10 - t9);
   
 //   Serial.println("-------------------------");
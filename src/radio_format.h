@@ -0,0 +1,176 @@
+/**
+ * @file radio_format.h
+ * @author Ebrahim Siami
+ * @brief NRF24 channel packets - wire format, with the optional redundant frames
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Plain C++ (no Arduino) so the same definitions are used by the firmware,
+ * a receiver firmware and the host tools in tools/.
+ *
+ * Plain packet (8 bytes): data_t, one control frame.
+ *
+ * Redundant packet (10 + 7 * depth bytes, depth 1 or 2):
+ *   data_t tag seq prev[depth]
+ *
+ *   data_t  the current frame, first, so a receiver that knows nothing about
+ *           redundancy reads it exactly like a plain packet
+ *   tag     REDUNDANT_TAG | depth (a plain packet has the radio's zero padding here)
+ *   seq     frame counter, +1 per frame
+ *   prev[j] frame seq-1-j as the difference to the current frame:
+ *           int8 roll, pitch, throttle, yaw (11-bit units), int8 aux1, aux2,
+ *           aux3 | aux4 << 1. DELTA_ESCAPE = moved too far to fit, that
+ *           channel can't be recovered (the current value stands in).
+ *
+ * The NRF24 drops packets with a bad CRC itself, so on this one-way link a
+ * frame is either there or not. With depth n every frame goes out in n + 1
+ * packets, and the receiver gets back the frames of up to n lost packets in
+ * a row from the next good one (RedundantRx), each one 2 ms later per
+ * position.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief Control Data Packet Structure
+ * CRITICAL: This structure must match EXACTLY on the Receiver side.
+ */
+#pragma pack(push, 1)
+typedef struct {
+    uint16_t roll     : 11;
+    uint16_t pitch    : 11;
+    uint16_t throttle : 11;
+    uint16_t yaw      : 11;
+    uint8_t  aux1     : 8;
+    uint8_t  aux2     : 8;
+    uint8_t  aux3     : 1;
+    uint8_t  aux4     : 1;
+} data_t;
+#pragma pack(pop)
+
+namespace RadioFormat {
+
+const uint8_t REDUNDANT_TAG = 0xA0;
+const uint8_t MAX_DEPTH = 2;
+const int8_t  DELTA_ESCAPE = -128;
+
+const uint8_t DELTA_SIZE = 7;
+const uint8_t REDUNDANT_HEADER = sizeof(data_t) + 2;
+const uint8_t MAX_PACKET = REDUNDANT_HEADER + MAX_DEPTH * DELTA_SIZE;   // 24
+
+static_assert(MAX_PACKET <= 32, "an NRF24 payload is 32 bytes at most");
+
+inline uint8_t packetSize(uint8_t depth) {
+    return depth ? (uint8_t)(REDUNDANT_HEADER + depth * DELTA_SIZE) : (uint8_t)sizeof(data_t);
+}
+
+inline bool sameFrame(const data_t& a, const data_t& b) {
+    return a.roll == b.roll && a.pitch == b.pitch && a.throttle == b.throttle && a.yaw == b.yaw &&
+           a.aux1 == b.aux1 && a.aux2 == b.aux2 && a.aux3 == b.aux3 && a.aux4 == b.aux4;
+}
+
+static inline int8_t delta(int from, int to) {
+    int d = from - to;
+    return (d < -127 || d > 127) ? DELTA_ESCAPE : (int8_t)d;
+}
+
+static inline int undelta(int cur, int8_t d) {
+    return d == DELTA_ESCAPE ? cur : cur + d;
+}
+
+/**
+ * @brief Builds a redundant packet.
+ * @param history history[0] is the current frame, history[j] the one j frames back (depth + 1 of them).
+ * @return Packet length, packetSize(depth).
+ */
+inline uint8_t makeRedundant(const data_t* history, uint8_t depth, uint8_t seq, uint8_t* out) {
+    const data_t& cur = history[0];
+    memcpy(out, &cur, sizeof(data_t));
+    out[sizeof(data_t)] = (uint8_t)(REDUNDANT_TAG | depth);
+    out[sizeof(data_t) + 1] = seq;
+
+    uint8_t* p = out + REDUNDANT_HEADER;
+    for (uint8_t j = 1; j <= depth; j++) {
+        const data_t& old = history[j];
+        *p++ = (uint8_t)delta(old.roll, cur.roll);
+        *p++ = (uint8_t)delta(old.pitch, cur.pitch);
+        *p++ = (uint8_t)delta(old.throttle, cur.throttle);
+        *p++ = (uint8_t)delta(old.yaw, cur.yaw);
+        *p++ = (uint8_t)delta(old.aux1, cur.aux1);
+        *p++ = (uint8_t)delta(old.aux2, cur.aux2);
+        *p++ = (uint8_t)(old.aux3 | (old.aux4 << 1));
+    }
+    return packetSize(depth);
+}
+
+/**
+ * @brief Receiver side: turns packets back into frames, including the lost
+ * ones the redundancy can bring back.
+ */
+struct RedundantRx {
+    bool     haveSeq = false;
+    uint8_t  lastSeq = 0;
+
+    uint32_t packets = 0;       // good packets
+    uint32_t recovered = 0;     // lost frames brought back
+    uint32_t approximate = 0;   // ... of them with an escaped channel
+    uint32_t lost = 0;          // frames that stayed lost (gap longer than the depth)
+
+    /**
+     * @brief Feeds one received payload. Calls out(frame, late) for every
+     * frame it yields, oldest first: the recovered ones with late = how many
+     * frames too late they are, then the current one with late = 0.
+     */
+    template <typename F>
+    void receive(const uint8_t* payload, uint8_t len, F out) {
+        if (len < sizeof(data_t)) return;
+        data_t cur;
+        memcpy(&cur, payload, sizeof(data_t));
+        packets++;
+
+        uint8_t depth = 0;
+        if (len >= REDUNDANT_HEADER && (payload[sizeof(data_t)] & 0xF0) == REDUNDANT_TAG) {
+            depth = payload[sizeof(data_t)] & 0x0F;
+            if (depth > MAX_DEPTH || len < packetSize(depth)) depth = 0;
+        }
+        if (depth == 0) {        // plain packet, nothing to count with
+            haveSeq = false;
+            out(cur, 0);
+            return;
+        }
+
+        uint8_t seq = payload[sizeof(data_t) + 1];
+        uint8_t gap = haveSeq ? (uint8_t)(seq - lastSeq - 1) : 0;
+        haveSeq = true;
+        lastSeq = seq;
+        if (gap >= 128) gap = 0;     // went backwards: transmitter restarted, start over
+
+        uint8_t back = gap < depth ? gap : depth;
+        lost += gap - back;
+
+        for (uint8_t j = back; j >= 1; j--) {
+            const int8_t* d = (const int8_t*)(payload + REDUNDANT_HEADER + (j - 1) * DELTA_SIZE);
+            data_t f = cur;
+            f.roll     = (uint16_t)undelta(cur.roll, d[0]);
+            f.pitch    = (uint16_t)undelta(cur.pitch, d[1]);
+            f.throttle = (uint16_t)undelta(cur.throttle, d[2]);
+            f.yaw      = (uint16_t)undelta(cur.yaw, d[3]);
+            f.aux1     = (uint8_t)undelta(cur.aux1, d[4]);
+            f.aux2     = (uint8_t)undelta(cur.aux2, d[5]);
+            f.aux3     = d[6] & 1;
+            f.aux4     = (d[6] >> 1) & 1;
+
+            bool escaped = false;
+            for (uint8_t k = 0; k < 6; k++) escaped |= (d[k] == DELTA_ESCAPE);
+            recovered++;
+            if (escaped) approximate++;
+            out(f, j);
+        }
+        out(cur, 0);
+    }
+};
+
+} // namespace RadioFormat
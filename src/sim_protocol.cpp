@@ -7,39 +7,154 @@
  */
 
 #include "sim_protocol.h"
+#include "Crc.h"
+#include "LatencyTrace.h"
 
 namespace SimProto {
 
+// --- Negotiated state ---
+static uint8_t version = VERSION_1;
+static uint8_t batchSize = 1;
+static uint8_t channels = V2_MIN_CHANNELS;
+
+// --- v2 batch being collected ---
+static uint8_t frame[V2_MAX_FRAME];
+static uint8_t samplesInFrame = 0;
+static uint32_t lastSampleUs = 0;
+static uint8_t frameSeq = 0;
+
+// --- Host request parser ---
+static uint8_t request[REQUEST_SIZE];
+static uint8_t requestLen = 0;
+
 uint8_t crc8(const uint8_t* data, size_t len) {
-    uint8_t crc = 0x00;
-    while (len--) {
-        crc ^= *data++;
-        for (uint8_t i = 0; i < 8; i++)
-            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
-    }
-    return crc;
+    return Crc::crc8(data, len);
 }
 
-void send(uint16_t r, uint16_t p, uint16_t t, uint16_t y, uint16_t a1, uint16_t a2, bool a3, bool a4) {
+static void sendV1(const uint16_t* ch, uint8_t switches) {
     static uint8_t seq = 0;
     Packet packet;
 
     packet.seq = seq++;
 
-    packet.channels[0] = r  & 0x0FFF;
-    packet.channels[1] = p  & 0x0FFF;
-    packet.channels[2] = t  & 0x0FFF;
-    packet.channels[3] = y  & 0x0FFF;
-    packet.channels[4] = a1 & 0x0FFF;
-    packet.channels[5] = a2 & 0x0FFF;
+    for (uint8_t i = 0; i < 6; i++) {
+        packet.channels[i] = ch[i] & 0x0FFF;
+    }
 
-    packet.auxSwitches = 0;
-    if (a3) packet.auxSwitches |= 1 << 0;
-    if (a4) packet.auxSwitches |= 1 << 1;
+    packet.auxSwitches = switches;
 
     packet.crc = crc8((uint8_t*)&packet, sizeof(Packet) - 1);
 
     Serial.write((uint8_t*)&packet, sizeof(Packet));
+    LatencyTrace::mark(LAT_USB);
+}
+
+void flush() {
+    if (samplesInFrame == 0) return;
+
+    frame[0] = HEADER1;
+    frame[1] = HEADER2;
+    frame[2] = VERSION_2;
+    frame[3] = frameSeq++;
+    frame[4] = channels;
+    frame[5] = samplesInFrame;
+    // frame[6..9] (t0) was filled in by the first sample
+
+    size_t len = v2FrameSize(channels, samplesInFrame);
+    putU16(&frame[len - V2_CRC_SIZE], Crc::crc16(&frame[2], len - 2 - V2_CRC_SIZE));
+
+    // One USB transfer for the whole batch
+    Serial.write(frame, len);
+    LatencyTrace::mark(LAT_USB);
+    samplesInFrame = 0;
+}
+
+static void queueV2(const uint16_t* ch, uint8_t switches) {
+    uint32_t now = micros();
+
+    if (samplesInFrame == 0) {
+        putU32(&frame[6], now);
+        lastSampleUs = now;
+    }
+
+    uint8_t* sample = &frame[V2_HEADER_SIZE + samplesInFrame * v2SampleSize(channels)];
+    uint32_t dt = now - lastSampleUs;
+    putU16(sample, dt > 0xFFFF ? 0xFFFF : (uint16_t)dt);
+    sample[2] = switches;
+    pack12(ch, channels, sample + 3);
+
+    lastSampleUs = now;
+    samplesInFrame++;
+
+    if (samplesInFrame >= batchSize) flush();
+}
+
+// ch[0..5] analog, ch[6] / ch[7] the switches as 0/4095, then up to V2_MAX_CHANNELS more
+static void sendChannels(const uint16_t* ch) {
+    uint8_t switches = 0;
+    if (ch[6]) switches |= 1 << 0;
+    if (ch[7]) switches |= 1 << 1;
+
+    if (version == VERSION_2) queueV2(ch, switches);
+    else sendV1(ch, switches);
 }
 
-} // namespace SimProto
\ No newline at end of file
+void send(uint16_t r, uint16_t p, uint16_t t, uint16_t y, uint16_t a1, uint16_t a2, bool a3, bool a4) {
+    uint16_t ch[V2_MAX_CHANNELS] = { r, p, t, y, a1, a2,
+                                     (uint16_t)(a3 ? 4095 : 0), (uint16_t)(a4 ? 4095 : 0) };
+    for (uint8_t i = V2_MIN_CHANNELS; i < V2_MAX_CHANNELS; i++) ch[i] = 2048;
+    sendChannels(ch);
+}
+
+static void applyRequest() {
+    uint8_t reqVersion = request[3];
+    uint8_t reqBatch = request[4];
+    uint8_t reqChannels = request[5];
+
+    if (request[2] != REQUEST_VERSION) return;
+    if (crc8(&request[2], REQUEST_SIZE - 3) != request[REQUEST_SIZE - 1]) return;
+    if (reqVersion != VERSION_1 && reqVersion != VERSION_2) return;
+
+    flush();    // never mix versions inside one frame
+    version = reqVersion;
+    batchSize = constrain(reqBatch, 1, V2_MAX_BATCH);
+    channels = constrain(reqChannels, V2_MIN_CHANNELS, V2_MAX_CHANNELS);
+}
+
+void poll() {
+    while (Serial.available() > 0) {
+        uint8_t b = (uint8_t)Serial.read();
+
+        // resync on the header bytes
+        if (requestLen == 0 && b != HEADER1) continue;
+        if (requestLen == 1 && b != HEADER2) { requestLen = (b == HEADER1) ? 1 : 0; continue; }
+
+        request[requestLen++] = b;
+        if (requestLen == REQUEST_SIZE) {
+            applyRequest();
+            requestLen = 0;
+        }
+    }
+}
+
+uint8_t activeVersion() {
+    return version;
+}
+
+uint8_t activeChannels() {
+    return channels;
+}
+
+static void writeFrame(const ChannelFrame& f) {
+    static_assert(OUTPUT_CHANNELS >= V2_MAX_CHANNELS, "v2 sends up to V2_MAX_CHANNELS of the frame");
+
+    uint16_t ch[V2_MAX_CHANNELS];
+    memcpy(ch, f.ch, sizeof(ch));
+    ch[6] = f.ch[6] > 2048 ? 4095 : 0;
+    ch[7] = f.ch[7] > 2048 ? 4095 : 0;
+    sendChannels(ch);
+}
+
+OutputSink sink("SimProto", 0, writeFrame);
+
+} // namespace SimProto
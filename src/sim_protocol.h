@@ -4,10 +4,14 @@
  * @brief Simulator Data Protocol
  * @version 4.0.1
  * @date 2026-04-27
+ *
+ * The wire format of both protocol versions is described in sim_protocol_format.h
  */
 
 #pragma once
 #include <Arduino.h>
+#include "sim_protocol_format.h"
+#include "Outputs.h"
 
 namespace SimProto {
 
@@ -27,9 +31,34 @@ static_assert(sizeof(Packet) == 18, "Packet size mismatch");
 
 uint8_t crc8(const uint8_t* data, size_t len);
 
+// One tick of the 8 classic channels, the ones past them in a v2 sample read center
 void send(
-    uint16_t r, uint16_t p, uint16_t t, uint16_t y, 
+    uint16_t r, uint16_t p, uint16_t t, uint16_t y,
     uint16_t a1, uint16_t a2, bool a3, bool a4
     );
 
-} // namespace SimProto
\ No newline at end of file
+/**
+ * @brief Reads version requests from the host (non-blocking).
+ * Call it from loop() while simulator mode is on.
+ */
+void poll();
+
+/**
+ * @brief Writes out a partially filled v2 batch (e.g. when leaving simulator mode).
+ */
+void flush();
+
+/**
+ * @brief Currently active protocol version (1 until the host asks for 2).
+ */
+uint8_t activeVersion();
+
+/**
+ * @brief Channels per v2 sample (V2_MIN_CHANNELS until the host asks for more).
+ */
+uint8_t activeChannels();
+
+// Output sink, one sample per frame (the host side sees every tick)
+extern OutputSink sink;
+
+} // namespace SimProto
@@ -0,0 +1,150 @@
+/**
+ * @file sim_protocol_format.h
+ * @author Ebrahim Siami
+ * @brief Simulator Data Protocol - wire format
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Plain C++ (no Arduino) so the same definitions are used by the firmware
+ * and by the host tools in tools/.
+ *
+ * v1 packet (18 bytes, one per control tick):
+ *   AA BB 01 seq ch[6]:u16 aux:u8 crc8
+ *
+ * v2 frame (1..4 samples per frame, up to 16 channels at 12 bit):
+ *   AA BB 02 seq nCh nSamples t0:u32
+ *   nSamples x { dt:u16 switches:u8 channels:packed 12 bit }
+ *   crc16 (CCITT-FALSE over everything after AA BB, little endian)
+ *
+ *   t0 is micros() of the first sample, dt is the time since the previous
+ *   sample (0 for the first one). Channels are packed two per 3 bytes:
+ *   [a7..a0] [b3..b0 a11..a8] [b11..b4]
+ *
+ * Version request (host -> transmitter):
+ *   AA BB 'V' version batch channels crc8
+ *   Selects the protocol version (1 or 2), how many samples the transmitter
+ *   collects before it writes a v2 frame and how many channels each v2
+ *   sample carries (8..16, out of range values are clamped). The first 8 are
+ *   6 analog + the 2 switches as 0/4095, the rest come straight from the
+ *   channel frame of the outputs (Outputs.h).
+ *
+ * Channel frame (host -> transmitter, trainer / HIL mode, Trainer.h):
+ *   AA BB 'H' seq nCh channels:packed 12 bit crc16
+ *   seq goes up by one per frame, nCh is 1..16, packing and crc16 as in v2.
+ *
+ * Latency record (transmitter -> host, -D LATENCY_TRACE builds, LatencyTrace.h):
+ *   AA BB 'L' seq:u32 mhz:u8 flags:u8 t[5]:u32 crc16
+ *   One per control slot, sent at the start of the next one. t[] are cycle
+ *   counter values (mhz cycles per us): slot start, inputs sampled, pipeline
+ *   done, RF packet written, SimProto bytes queued. Bit n of flags is set if
+ *   t[n] was reached in that slot. crc16 as in v2.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "Crc.h"
+
+namespace SimProto {
+
+const uint8_t HEADER1 = 0xAA;
+const uint8_t HEADER2 = 0xBB;
+
+const uint8_t VERSION_1 = 1;
+const uint8_t VERSION_2 = 2;
+
+const uint8_t REQUEST_VERSION = 'V';
+const size_t  REQUEST_SIZE = 7;
+
+const uint8_t HOST_CHANNELS = 'H';
+const size_t  HOST_HEADER_SIZE = 5;
+
+const uint8_t LATENCY_RECORD = 'L';
+
+enum LatencyStage : uint8_t {
+    LAT_SLOT,         // control slot starts, the GPIO marker goes high
+    LAT_SAMPLED,      // ADC frame captured
+    LAT_PIPELINE,     // channel frame built
+    LAT_RADIO,        // NRF24 FIFO written / CRSF DMA started, the marker goes low
+    LAT_USB,          // SimProto bytes handed to the USB stack
+    LAT_STAGES
+};
+
+const size_t LATENCY_SIZE = 3 + 4 + 2 + LAT_STAGES * 4 + 2;     // 31
+
+const uint8_t V2_MIN_CHANNELS = 8;      // also the default until the host asks for more
+const uint8_t V2_MAX_CHANNELS = 16;
+const uint8_t V2_MAX_BATCH = 4;
+const size_t  V2_HEADER_SIZE = 10;
+const size_t  V2_CRC_SIZE = 2;
+
+/**
+ * @brief Bytes needed for 'count' channels at 12 bit.
+ */
+inline size_t packedChannelBytes(uint8_t count) {
+    return ((size_t)count * 12 + 7) / 8;
+}
+
+inline size_t v2SampleSize(uint8_t channels) {
+    return 3 + packedChannelBytes(channels);
+}
+
+inline size_t v2FrameSize(uint8_t channels, uint8_t samples) {
+    return V2_HEADER_SIZE + samples * v2SampleSize(channels) + V2_CRC_SIZE;
+}
+
+// Biggest possible v2 frame, used to size buffers
+const size_t V2_MAX_FRAME = V2_HEADER_SIZE + V2_MAX_BATCH * (3 + (V2_MAX_CHANNELS * 12 + 7) / 8) + V2_CRC_SIZE;
+
+inline void pack12(const uint16_t* ch, uint8_t count, uint8_t* out) {
+    for (uint8_t i = 0; i < count; i += 2) {
+        uint16_t a = ch[i] & 0x0FFF;
+        uint16_t b = (i + 1 < count) ? (ch[i + 1] & 0x0FFF) : 0;
+        *out++ = (uint8_t)a;
+        *out++ = (uint8_t)((a >> 8) | (b << 4));
+        if (i + 1 < count) *out++ = (uint8_t)(b >> 4);
+    }
+}
+
+inline void unpack12(const uint8_t* in, uint8_t count, uint16_t* ch) {
+    for (uint8_t i = 0; i < count; i += 2) {
+        uint8_t b0 = *in++;
+        uint8_t b1 = *in++;
+        ch[i] = (uint16_t)(b0 | ((b1 & 0x0F) << 8));
+        if (i + 1 < count) {
+            uint8_t b2 = *in++;
+            ch[i + 1] = (uint16_t)((b1 >> 4) | (b2 << 4));
+        }
+    }
+}
+
+inline size_t hostFrameSize(uint8_t channels) {
+    return HOST_HEADER_SIZE + packedChannelBytes(channels) + V2_CRC_SIZE;
+}
+
+// Biggest possible channel frame
+const size_t HOST_MAX_FRAME = HOST_HEADER_SIZE + (V2_MAX_CHANNELS * 12 + 7) / 8 + V2_CRC_SIZE;
+
+inline void putU16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+inline void putU32(uint8_t* p, uint32_t v) { putU16(p, (uint16_t)v); putU16(p + 2, (uint16_t)(v >> 16)); }
+inline uint16_t getU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline uint32_t getU32(const uint8_t* p) { return getU16(p) | ((uint32_t)getU16(p + 2) << 16); }
+
+/**
+ * @brief Builds a channel frame for the transmitter (host side of the trainer mode).
+ * @param count 1..V2_MAX_CHANNELS channels, 12 bit.
+ * @return Frame length, HOST_MAX_FRAME bytes are enough for 'out'.
+ */
+inline size_t makeChannelFrame(uint8_t seq, const uint16_t* ch, uint8_t count, uint8_t* out) {
+    out[0] = HEADER1;
+    out[1] = HEADER2;
+    out[2] = HOST_CHANNELS;
+    out[3] = seq;
+    out[4] = count;
+    pack12(ch, count, out + HOST_HEADER_SIZE);
+    size_t len = hostFrameSize(count);
+    putU16(out + len - V2_CRC_SIZE, Crc::crc16(out + 2, len - 2 - V2_CRC_SIZE));
+    return len;
+}
+
+} // namespace SimProto
@@ -0,0 +1,89 @@
+/**
+ * @file crc_bench.cpp
+ * @author Ebrahim Siami
+ * @brief Host micro-benchmark for the CRC routines in src/Crc.cpp
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Checks Crc::crc8() against the original bit-by-bit loop on random buffers
+ * (random lengths and split points, so the incremental API is covered too)
+ * and prints the throughput of each routine.
+ *
+ * Build both CRC-8 variants and compare:
+ *   g++ -O2 -std=c++14 -I../../src crc_bench.cpp ../../src/Crc.cpp -o crc_bench
+ *   g++ -O2 -std=c++14 -DCRC8_SLICE_BY_4 -I../../src crc_bench.cpp ../../src/Crc.cpp -o crc_bench_s4
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "Crc.h"
+
+// The original SimProto::crc8() (v4.0.1), kept as the reference
+static uint8_t crc8Bitwise(const uint8_t* data, size_t len, uint8_t crc = 0) {
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t i = 0; i < 8; i++)
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+    }
+    return crc;
+}
+
+template <typename F>
+static double measure(const char* name, const std::vector<uint8_t>& buf, size_t chunk, F fn) {
+    volatile uint32_t sink = 0;
+    size_t rounds = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double sec = 0;
+    do {
+        for (size_t off = 0; off + chunk <= buf.size(); off += chunk) sink += fn(buf.data() + off, chunk);
+        rounds++;
+        sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (sec < 0.3);
+    double mbps = (double)rounds * (buf.size() / chunk * chunk) / sec / 1e6;
+    printf("  %-14s %8.1f MB/s\n", name, mbps);
+    (void)sink;
+    return mbps;
+}
+
+int main() {
+    std::mt19937 rng(12345);
+    std::vector<uint8_t> buf(1 << 20);
+    for (auto& b : buf) b = (uint8_t)rng();
+
+    // --- correctness ---
+    size_t failures = 0;
+    for (int i = 0; i < 100000; i++) {
+        size_t len = rng() % 300;
+        size_t off = rng() % (buf.size() - len);
+        size_t split = len ? rng() % (len + 1) : 0;
+        const uint8_t* p = buf.data() + off;
+
+        uint8_t ref = crc8Bitwise(p, len);
+        uint8_t one = Crc::crc8(p, len);
+        uint8_t two = Crc::crc8(p + split, len - split, Crc::crc8(p, split));
+        if (ref != one || ref != two) failures++;
+    }
+#if defined(CRC8_SLICE_BY_4)
+    printf("crc8 variant: slice-by-4\n");
+#else
+    printf("crc8 variant: 256-entry table\n");
+#endif
+    printf("crc8 vs bitwise on 100000 random buffers: %s (%zu mismatches)\n\n", failures ? "FAIL" : "OK", failures);
+
+    // --- speed, 17 bytes = one v1 simulator packet, 4096 = bulk ---
+    const size_t chunks[] = { 17, 4096 };
+    for (size_t chunk : chunks) {
+        printf("chunk %zu bytes:\n", chunk);
+        double bit = measure("crc8 bitwise", buf, chunk, [](const uint8_t* d, size_t n) { return (uint32_t)crc8Bitwise(d, n); });
+        double tab = measure("crc8", buf, chunk, [](const uint8_t* d, size_t n) { return (uint32_t)Crc::crc8(d, n); });
+        measure("crc16", buf, chunk, [](const uint8_t* d, size_t n) { return (uint32_t)Crc::crc16(d, n); });
+        measure("crc32", buf, chunk, [](const uint8_t* d, size_t n) { return Crc::crc32(d, n); });
+        printf("  crc8 speed-up vs bitwise: %.1fx\n\n", tab / bit);
+    }
+
+    return failures ? 1 : 0;
+}
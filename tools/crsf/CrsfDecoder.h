@@ -0,0 +1,114 @@
+/**
+ * @file CrsfDecoder.h
+ * @author Ebrahim Siami
+ * @brief Host-side reference decoder for the CRSF output
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Feed it raw bytes from the module line (any chunk size), it resynchronizes
+ * on the address byte, checks the length and the CRC-8/DVB-S2 and calls back
+ * once per RC channels frame. Other frame types (telemetry from the module)
+ * are checked and counted but not decoded. The format lives in src/crsf_format.h.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "crsf_format.h"
+#include "Crc.h"
+
+namespace Crsf {
+
+// Addresses a frame can start with on the module line
+const uint8_t ADDR_BROADCAST = 0x00;
+const uint8_t ADDR_HANDSET = 0xEA;
+const uint8_t ADDR_RECEIVER = 0xEC;
+const uint8_t ADDR_FLIGHT_CONTROLLER = 0xC8;
+
+struct RcFrame {
+    uint8_t  address;
+    uint16_t channels[CHANNELS];     // 172..1811
+};
+
+struct DecoderStats {
+    uint64_t bytes = 0;
+    uint64_t frames = 0;         // valid frames of any type
+    uint64_t rcFrames = 0;
+    uint64_t otherFrames = 0;
+    uint64_t crcErrors = 0;
+    uint64_t badLength = 0;      // RC channels frame with a length other than 24
+    uint64_t skippedBytes = 0;   // bytes dropped while resynchronizing
+};
+
+class Decoder {
+public:
+    /**
+     * @brief Decodes as many complete frames as possible from 'data'.
+     * @param onFrame Callable as onFrame(const RcFrame&).
+     */
+    template <typename F>
+    void feed(const uint8_t* data, size_t len, F onFrame) {
+        _stats.bytes += len;
+        _buf.insert(_buf.end(), data, data + len);
+
+        while (true) {
+            size_t avail = _buf.size() - _pos;
+            const uint8_t* p = _buf.data() + _pos;
+
+            // 1. address + a length that fits the protocol
+            if (avail < 2) break;
+            if (!isAddress(p[0]) || p[1] < 2 || p[1] > MAX_FRAME_SIZE - 2) { skip(1); continue; }
+
+            size_t frameLen = (size_t)p[1] + 2;
+            if (avail < frameLen) break;
+
+            // 2. CRC over type + payload
+            if (Crc::crc8DvbS2(p + 2, frameLen - 3) != p[frameLen - 1]) {
+                _stats.crcErrors++;
+                skip(1);
+                continue;
+            }
+
+            // 3. hand out RC channels, count the rest
+            _stats.frames++;
+            if (p[2] != TYPE_RC_CHANNELS) {
+                _stats.otherFrames++;
+            } else if (p[1] != FRAME_LEN) {
+                _stats.badLength++;
+            } else {
+                RcFrame f;
+                f.address = p[0];
+                unpackChannels(p + 3, f.channels);
+                _stats.rcFrames++;
+                onFrame(f);
+            }
+            _pos += frameLen;
+        }
+
+        // keep the buffer from growing forever
+        if (_pos > 4096) {
+            _buf.erase(_buf.begin(), _buf.begin() + _pos);
+            _pos = 0;
+        }
+    }
+
+    const DecoderStats& stats() const { return _stats; }
+
+private:
+    std::vector<uint8_t> _buf;
+    size_t _pos = 0;
+    DecoderStats _stats;
+
+    static bool isAddress(uint8_t a) {
+        return a == ADDR_MODULE || a == ADDR_BROADCAST || a == ADDR_HANDSET ||
+               a == ADDR_RECEIVER || a == ADDR_FLIGHT_CONTROLLER;
+    }
+
+    void skip(size_t n) {
+        _pos += n;
+        _stats.skippedBytes += n;
+    }
+};
+
+} // namespace Crsf
@@ -0,0 +1,202 @@
+/**
+ * @file crsf_dump.cpp
+ * @author Ebrahim Siami
+ * @brief Dumps the CRSF output of the transmitter, or runs the frame / CRC self test
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Build (Linux / macOS):
+ *   g++ -O2 -std=c++14 -I../../src crsf_dump.cpp ../../src/Crc.cpp -o crsf_dump
+ *
+ * Usage:
+ *   crsf_dump capture.bin     print every RC channels frame (e.g. --crsf-out of the native replay)
+ *   crsf_dump -               read from stdin (a USB-UART on the module line, set to 400000 baud)
+ *   crsf_dump -q capture.bin  only the totals
+ *   crsf_dump --test          CRC-8/DVB-S2, channel packing and decoder checks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include "CrsfDecoder.h"
+
+using namespace Crsf;
+
+// =============================================================================
+// --- Reference encoder (bit by bit, independent of crsf_format.h) ---
+// =============================================================================
+
+static uint8_t crc8DvbS2Bitwise(const uint8_t* data, size_t len) {
+    uint8_t crc = 0;
+    while (len--) {
+        crc ^= *data++;
+        for (int b = 0; b < 8; b++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0xD5) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+static void packBitwise(const uint16_t ch[CHANNELS], uint8_t out[PAYLOAD_SIZE]) {
+    memset(out, 0, PAYLOAD_SIZE);
+    for (int i = 0; i < CHANNELS; i++) {
+        for (int b = 0; b < 11; b++) {
+            int bit = i * 11 + b;
+            if ((ch[i] >> b) & 1) out[bit / 8] |= (uint8_t)(1 << (bit % 8));
+        }
+    }
+}
+
+// Mirrors Crsf::buildRcFrame() in src/CrsfOutput.cpp
+static void encodeRc(const uint16_t ch[CHANNELS], uint8_t out[FRAME_SIZE]) {
+    out[0] = ADDR_MODULE;
+    out[1] = FRAME_LEN;
+    out[2] = TYPE_RC_CHANNELS;
+    packChannels(ch, &out[3]);
+    out[FRAME_SIZE - 1] = Crc::crc8DvbS2(&out[2], FRAME_SIZE - 3);
+}
+
+// =============================================================================
+// --- Self test ---
+// =============================================================================
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    printf("  %-58s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static int runTest() {
+    std::mt19937 rng(4242);
+
+    printf("crc:\n");
+    const uint8_t check9[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    check(Crc::crc8DvbS2(check9, sizeof(check9)) == 0xBC, "CRC-8/DVB-S2 check value of \"123456789\" is 0xBC");
+
+    bool same = true;
+    for (int i = 0; i < 100000 && same; i++) {
+        uint8_t buf[64];
+        size_t len = rng() % sizeof(buf);
+        for (size_t k = 0; k < len; k++) buf[k] = (uint8_t)rng();
+        size_t split = len ? rng() % len : 0;
+        uint8_t ref = crc8DvbS2Bitwise(buf, len);
+        same = Crc::crc8DvbS2(buf, len) == ref &&
+               Crc::crc8DvbS2(buf + split, len - split, Crc::crc8DvbS2(buf, split)) == ref;
+    }
+    check(same, "table vs bitwise on 100000 random buffers (also split)");
+
+    printf("channels:\n");
+    check(from12bit(0) == CHANNEL_MIN && from12bit(2048) == CHANNEL_MID && from12bit(4095) == CHANNEL_MAX,
+          "0 / 2048 / 4095 -> 172 / 992 / 1811");
+
+    bool monotonic = true, roundTrip = true;
+    for (int v = 0; v < 4096; v++) {
+        if (v > 0 && from12bit(v) < from12bit(v - 1)) monotonic = false;
+        if (abs(to12bit(from12bit(v)) - v) > 2) roundTrip = false;
+    }
+    check(monotonic, "12 bit -> CRSF is monotonic");
+    check(roundTrip, "CRSF -> 12 bit round trip within 2 steps");
+
+    bool packOk = true;
+    for (int i = 0; i < 10000 && packOk; i++) {
+        uint16_t ch[CHANNELS], back[CHANNELS];
+        uint8_t a[PAYLOAD_SIZE], b[PAYLOAD_SIZE];
+        for (int c = 0; c < CHANNELS; c++) ch[c] = (uint16_t)(rng() & 0x07FF);
+        packChannels(ch, a);
+        packBitwise(ch, b);
+        unpackChannels(a, back);
+        packOk = memcmp(a, b, PAYLOAD_SIZE) == 0 && memcmp(ch, back, sizeof(ch)) == 0;
+    }
+    check(packOk, "pack vs bitwise, unpack round trip on 10000 frames");
+
+    printf("decoder:\n");
+    std::vector<uint8_t> stream;
+    std::vector<RcFrame> sent;
+    int corrupted = 0;
+    for (int i = 0; i < 5000; i++) {
+        // garbage between frames now and then (line noise, telemetry of unknown type)
+        if (rng() % 10 == 0) {
+            for (int k = rng() % 8; k > 0; k--) stream.push_back((uint8_t)rng());
+        }
+
+        RcFrame f;
+        f.address = ADDR_MODULE;
+        for (int c = 0; c < CHANNELS; c++) f.channels[c] = (uint16_t)(CHANNEL_MIN + rng() % (CHANNEL_MAX - CHANNEL_MIN + 1));
+        uint8_t frame[FRAME_SIZE];
+        encodeRc(f.channels, frame);
+
+        if (rng() % 50 == 0) {
+            frame[3 + rng() % (FRAME_SIZE - 3)] ^= (uint8_t)(1 << (rng() % 8));   // one flipped bit
+            corrupted++;
+        } else {
+            sent.push_back(f);
+        }
+        stream.insert(stream.end(), frame, frame + FRAME_SIZE);
+    }
+
+    Decoder dec;
+    size_t got = 0;
+    bool match = true;
+    for (size_t off = 0; off < stream.size();) {
+        size_t n = 1 + rng() % 40;
+        if (n > stream.size() - off) n = stream.size() - off;
+        dec.feed(stream.data() + off, n, [&](const RcFrame& f) {
+            if (got >= sent.size() || memcmp(f.channels, sent[got].channels, sizeof(f.channels)) != 0) match = false;
+            got++;
+        });
+        off += n;
+    }
+    const DecoderStats& st = dec.stats();
+    printf("  (%zu frames sent, %d corrupted, %llu decoded, %llu crc errors, %llu bytes skipped)\n",
+           sent.size() + corrupted, corrupted, (unsigned long long)st.rcFrames,
+           (unsigned long long)st.crcErrors, (unsigned long long)st.skippedBytes);
+    check(match && got == sent.size(), "every good frame decoded in order, in random chunks");
+    check(st.crcErrors >= (uint64_t)corrupted, "every flipped bit caught by the CRC");
+
+    printf("\n%s (%d failed)\n", failures ? "FAIL" : "OK", failures);
+    return failures ? 1 : 0;
+}
+
+// =============================================================================
+// --- Dump ---
+// =============================================================================
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--test")) return runTest();
+        else if (!strcmp(argv[i], "-q")) quiet = true;
+        else path = argv[i];
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s [-q] <capture|->\n       %s --test\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    FILE* f = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+    if (!f) { perror(path); return 1; }
+
+    Decoder dec;
+    uint64_t index = 0;
+    uint8_t buf[512];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        dec.feed(buf, n, [&](const RcFrame& frame) {
+            if (!quiet) {
+                printf("%8llu ch=", (unsigned long long)index);
+                for (int i = 0; i < CHANNELS; i++) printf("%s%4u", i ? "," : "", frame.channels[i]);
+                printf("\n");
+            }
+            index++;
+        });
+    }
+    if (f != stdin) fclose(f);
+
+    const DecoderStats& st = dec.stats();
+    fprintf(stderr, "bytes %llu rc frames %llu other frames %llu crc errors %llu bad length %llu skipped %llu\n",
+            (unsigned long long)st.bytes, (unsigned long long)st.rcFrames, (unsigned long long)st.otherFrames,
+            (unsigned long long)st.crcErrors, (unsigned long long)st.badLength, (unsigned long long)st.skippedBytes);
+    return 0;
+}
@@ -0,0 +1,399 @@
+/**
+ * @file flash_model.cpp
+ * @author Ebrahim Siami
+ * @brief Host checks of the real FlashStorage_STM32 EEPROMClass on a RAM flash page
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * The native build replaces FlashStorage_STM32 by its own shim (lib_ignore),
+ * so the library code the board runs is never built there. This tool compiles
+ * lib/FlashStorage_STM32 as it is: FlashStorage_STM32.hpp (EEPROMClass) and
+ * utility/stm32_eeprom_Impl.h (buffer and flush). stm32_def.h next to this
+ * file puts the emulated EEPROM page into flashModelPage[] and declares the
+ * HAL flash calls, which are modelled below: erase sets the page to 0xFF,
+ * programming follows the rules of the chip and counts every call.
+ *
+ * Checks of EEPROMClass:
+ *
+ *   - get() returns what was in the flash page when it was first used
+ *   - put() / update() of an unchanged value leave the buffer clean and do not
+ *     flush, no erase and no program reach the HAL
+ *   - the dirty range handed to eeprom_buffer_flush_range() is exactly the
+ *     first .. last byte that changed, also when several puts are collected
+ *     with setCommitASAP(false)
+ *   - out-of-range puts are ignored
+ *   - after every commit the flash page holds what was put
+ *
+ * Checks of eeprom_buffer_flush_range(), with the erase and program counts:
+ *
+ *   - a changed unit that is still erased is programmed in place, no erase
+ *   - a unit that cannot be programmed over its flash content forces the
+ *     erase: on the F1 any halfword that is not 0xFFFF, on F2/F4/F7 any
+ *     0 -> 1 bit; then every unit that is not blank is programmed again
+ *   - the flash page ends up equal to the buffer and the modelled chip never
+ *     refuses a program (PGERR) or gets a cell that cannot go 0 -> 1
+ *
+ * The F1 rules are the default, -D MODEL_STM32F4 builds the F2/F4/F7 ones:
+ *
+ *   g++ -O2 -std=gnu++14 -I. -I../../native/include flash_model.cpp -o flash_model
+ *   g++ -O2 -std=gnu++14 -D MODEL_STM32F4 -I. -I../../native/include flash_model.cpp -o flash_model_f4
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../../lib/FlashStorage_STM32/src/utility/stm32_eeprom.hpp"
+#include "../../lib/FlashStorage_STM32/src/utility/stm32_eeprom_Impl.h"
+
+// EEPROMClass::commit() goes through here, so the range it asks for is seen
+static void recordFlushRange(const uint32_t& first, const uint32_t& last);
+#define eeprom_buffer_flush_range recordFlushRange
+#include "../../lib/FlashStorage_STM32/src/FlashStorage_STM32.hpp"
+#undef eeprom_buffer_flush_range
+
+// =============================================================================
+// --- Flash model ---
+// =============================================================================
+
+uint8_t flashModelPage[FLASH_PAGE_SIZE] __attribute__((aligned(8)));
+
+static struct {
+    bool     unlocked;
+    uint32_t unlocks;
+    uint32_t erases;
+    uint32_t programs;      // HAL_FLASH_Program() calls, one per program unit
+    uint32_t errors;        // what the chip would refuse or get wrong
+} hal;
+
+static uint8_t* pageAt(uint32_t address, uint32_t size) {
+    uint32_t offset = address - (uint32_t)FLASH_BASE_ADDRESS;
+    if (offset >= FLASH_PAGE_SIZE || offset + size > FLASH_PAGE_SIZE) return nullptr;
+    return flashModelPage + offset;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASH_Unlock(void) {
+    hal.unlocked = true;
+    hal.unlocks++;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASH_Lock(void) {
+    hal.unlocked = false;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef* pEraseInit, uint32_t* PageError) {
+#if defined(MODEL_STM32F4)
+    bool ours = pEraseInit->TypeErase == FLASH_TYPEERASE_SECTORS && pEraseInit->NbSectors == 1;
+#else
+    bool ours = pEraseInit->TypeErase == FLASH_TYPEERASE_PAGES && pEraseInit->NbPages == 1 &&
+                pEraseInit->PageAddress == (uint32_t)FLASH_BASE_ADDRESS;
+#endif
+    if (!hal.unlocked || !ours) {
+        hal.errors++;
+        *PageError = 0;
+        return HAL_ERROR;
+    }
+    memset(flashModelPage, 0xFF, sizeof(flashModelPage));
+    hal.erases++;
+    *PageError = 0xFFFFFFFFU;
+    return HAL_OK;
+}
+
+extern "C" HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data) {
+    uint32_t size = TypeProgram == FLASH_TYPEPROGRAM_DOUBLEWORD ? 8 : TypeProgram == FLASH_TYPEPROGRAM_WORD ? 4 : 2;
+    uint8_t* dst = pageAt(Address, size);
+    if (!hal.unlocked || dst == nullptr || (Address % size) != 0) {
+        hal.errors++;
+        return HAL_ERROR;
+    }
+    hal.programs++;
+
+#if defined(MODEL_STM32F4)
+    // Any word may be programmed, but a cell only goes 1 -> 0
+    for (uint32_t i = 0; i < size; i++) {
+        uint8_t value = (uint8_t)(Data >> (8 * i));
+        if ((dst[i] & value) != value) hal.errors++;
+        dst[i] &= value;
+    }
+#else
+    // F1: the HAL programs halfword by halfword, each one has to be 0xFFFF
+    // (or the new value 0x0000), else PGERR and it stops there
+    for (uint32_t i = 0; i < size; i += 2) {
+        uint16_t value = (uint16_t)(Data >> (8 * i));
+        uint16_t now = (uint16_t)(dst[i] | (dst[i + 1] << 8));
+        if (now != 0xFFFF && value != 0x0000) {
+            hal.errors++;
+            return HAL_ERROR;
+        }
+        dst[i] = (uint8_t)value;
+        dst[i + 1] = (uint8_t)(value >> 8);
+    }
+#endif
+    return HAL_OK;
+}
+
+// =============================================================================
+// --- Checks ---
+// =============================================================================
+
+static struct {
+    uint32_t calls;
+    uint32_t first, last;
+} flush;
+
+static void recordFlushRange(const uint32_t& first, const uint32_t& last) {
+    flush.calls++;
+    flush.first = first;
+    flush.last = last;
+    eeprom_buffer_flush_range(first, last);
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    printf("  %-62s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+// What should be in flash after each commit
+static uint8_t expect[E2END + 1];
+
+static bool flashMatches() {
+    return memcmp(flashModelPage, expect, sizeof(expect)) == 0 && hal.errors == 0;
+}
+
+struct Record {
+    uint32_t magic;
+    uint16_t values[20];
+    uint8_t  flags[6];
+};
+
+static const int ADDRESS = 10;
+
+static bool flushedExactly(uint32_t calls, uint32_t first, uint32_t last) {
+    return flush.calls == calls && flush.first == first && flush.last == last;
+}
+
+static void checkEeprom() {
+    printf("EEPROMClass:\n");
+
+    // --- what was in flash before the first access ---
+    memset(flashModelPage, 0xFF, sizeof(flashModelPage));
+    Record stored;
+    memset(&stored, 0, sizeof(stored));
+    stored.magic = 0x54534352;
+    for (int i = 0; i < 20; i++) stored.values[i] = (uint16_t)(1000 + i);
+    memcpy(flashModelPage + ADDRESS, &stored, sizeof(stored));
+    memcpy(expect, flashModelPage, sizeof(expect));
+
+    Record r;
+    EEPROM.get(ADDRESS, r);
+    check(memcmp(&r, &stored, sizeof(r)) == 0 && !EEPROM.isDirty(), "get() reads the page as it was in flash");
+
+    // --- unchanged ---
+    EEPROM.put(ADDRESS, r);
+    check(flush.calls == 0 && hal.erases == 0 && hal.programs == 0 && !EEPROM.isDirty(),
+          "unchanged put(): no flush, no erase, no program");
+    EEPROM.update(ADDRESS + 4, flashModelPage[ADDRESS + 4]);
+    EEPROM.commit();
+    check(flush.calls == 0 && hal.erases == 0 && hal.programs == 0, "unchanged update() + commit(): no flush");
+
+    // --- one byte in the middle ---
+    r.values[7] ^= 0x0100;
+    uint32_t at = ADDRESS + offsetof(Record, values) + 7 * 2 + 1;
+    EEPROM.put(ADDRESS, r);
+    memcpy(expect + ADDRESS, &r, sizeof(r));
+    check(flushedExactly(1, at, at), "one changed byte: dirty range is that byte");
+    check(flashMatches() && !EEPROM.isDirty(), "flash holds the new value");
+
+    // --- two bytes apart, the bytes between unchanged ---
+    r.values[2] = 7;
+    r.flags[3] = 1;
+    uint32_t from = ADDRESS + offsetof(Record, values) + 2 * 2;
+    uint32_t to = ADDRESS + offsetof(Record, flags) + 3;
+    EEPROM.put(ADDRESS, r);
+    memcpy(expect + ADDRESS, &r, sizeof(r));
+    check(flushedExactly(2, from, to), "first .. last changed byte, ends of the object trimmed");
+    check(flashMatches(), "flash holds the new values");
+
+    // --- collected with setCommitASAP(false) ---
+    EEPROM.setCommitASAP(false);
+    uint8_t a = 0x11, b = 0x22;
+    EEPROM.put(600, a);
+    EEPROM.put(40, b);
+    EEPROM.update(300, 0x33);
+    expect[600] = a;
+    expect[40] = b;
+    expect[300] = 0x33;
+    check(flush.calls == 2 && EEPROM.isDirty(), "setCommitASAP(false): put() only marks the buffer");
+    EEPROM.commit();
+    check(flushedExactly(3, 40, 600) && !EEPROM.isDirty(), "commit() flushes the union of the changes");
+    check(flashMatches(), "flash holds all three");
+    EEPROM.commit();
+    check(flush.calls == 3, "second commit() does nothing");
+
+    // --- a put that changes nothing after a change was committed ---
+    EEPROM.put(40, b);
+    EEPROM.commit();
+    check(flush.calls == 3 && !EEPROM.isDirty(), "same value again: still clean");
+    EEPROM.setCommitASAP(true);
+
+    // --- out of range ---
+    uint32_t programs = hal.programs;
+    Record far;
+    memset(&far, 0x5A, sizeof(far));
+    EEPROM.put(E2END - 4, far);
+    EEPROM.put(-1, far);
+    check(flush.calls == 3 && hal.programs == programs && flashMatches(), "out-of-range put() is ignored");
+    Record back;
+    memset(&back, 0xA5, sizeof(back));
+    EEPROM.get(E2END - 4, back);
+    check(back.magic == 0xA5A5A5A5, "out-of-range get() leaves the object alone");
+
+    printf("    (%u flushes, %u erases, %u programs)\n", flush.calls, hal.erases, hal.programs);
+}
+
+// Unit HAL_FLASH_Program() writes, as the reference manual has it
+#if defined(MODEL_STM32F4)
+static const uint32_t UNIT = 4;
+#else
+static const uint32_t UNIT = 8;
+#endif
+
+static const uint32_t IMAGE_AT = 10;        // SETTINGS_EEPROM_ADDRESS
+static const uint32_t IMAGE_SIZE = 350;     // header + StoredSettings v10
+
+static uint32_t unitsCovering(uint32_t first, uint32_t last) {
+    return last / UNIT - first / UNIT + 1;
+}
+
+static uint32_t nonBlankUnits() {
+    uint32_t n = 0;
+    for (uint32_t offset = 0; offset < sizeof(expect); offset += UNIT) {
+        for (uint32_t i = 0; i < UNIT; i++) {
+            if (expect[offset + i] != 0xFF) { n++; break; }
+        }
+    }
+    return n;
+}
+
+// Flash and buffer both hold 'expect', counters at 0
+static void startFromExpect() {
+    memcpy(flashModelPage, expect, sizeof(expect));
+    eeprom_buffer_fill();
+    memset(&hal, 0, sizeof(hal));
+}
+
+// Like a put() + commit(): buffer update, then the flush of the changed range
+static void write(uint32_t pos, const uint8_t* data, uint32_t len) {
+    memcpy(expect + pos, data, len);
+    uint32_t first, last;
+    if (eeprom_buffered_update(pos, data, len, &first, &last)) {
+        eeprom_buffer_flush_range(first, last);
+    }
+}
+
+static void writeByte(uint32_t pos, uint8_t value) {
+    write(pos, &value, 1);
+}
+
+static bool counts(uint32_t erases, uint32_t programs) {
+    return hal.erases == erases && hal.programs == programs && flashMatches() && !hal.unlocked;
+}
+
+static void report(const char* what, bool verbose = true) {
+    if (verbose) printf("    (%s: %u erases, %u programs)\n", what, hal.erases, hal.programs);
+}
+
+static void checkFlush() {
+    printf("\neeprom_buffer_flush_range(), %u byte program unit:\n", UNIT);
+
+    // A settings image at its usual place, no unit of it blank
+    uint8_t image[IMAGE_SIZE];
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < IMAGE_SIZE; i++) {
+        seed = seed * 1103515245 + 12345;
+        image[i] = (uint8_t)((seed >> 16) % 0xFF);      // never 0xFF
+    }
+    image[100] |= 0x01;
+    image[101] |= 0x01;
+    image[200] &= 0xFE;
+
+    // --- first save into a blank page ---
+    memset(expect, 0xFF, sizeof(expect));
+    startFromExpect();
+    write(IMAGE_AT, image, IMAGE_SIZE);
+    uint32_t imageUnits = unitsCovering(IMAGE_AT, IMAGE_AT + IMAGE_SIZE - 1);
+    report("first save");
+    check(counts(0, imageUnits), "blank page: no erase, only the units of the image");
+
+    // --- the same again ---
+    startFromExpect();
+    write(IMAGE_AT, image, IMAGE_SIZE);
+    check(counts(0, 0) && hal.unlocks == 0, "unchanged save: no erase, no program, not even unlocked");
+
+    // --- a value that only clears a bit ---
+    startFromExpect();
+    writeByte(IMAGE_AT + 100, image[100] & 0xFE);
+    report("1 -> 0 bit");
+#if defined(MODEL_STM32F4)
+    check(counts(0, 1), "1 -> 0 only: programmed in place");
+#else
+    check(counts(1, nonBlankUnits()), "1 -> 0 in a written halfword: erase, non-blank units again");
+#endif
+
+    // --- a value that sets a bit ---
+    startFromExpect();
+    writeByte(IMAGE_AT + 200, image[200] | 0x01);
+    report("0 -> 1 bit");
+    check(counts(1, nonBlankUnits()), "0 -> 1: erase, then every non-blank unit");
+
+    // --- back to 0xFF: that unit is blank after the erase and skipped ---
+    startFromExpect();
+    uint8_t blank[UNIT];
+    memset(blank, 0xFF, sizeof(blank));
+    uint32_t blankAt = IMAGE_AT + 40 - (IMAGE_AT + 40) % UNIT;
+    write(blankAt, blank, UNIT);
+    check(counts(1, nonBlankUnits()) && nonBlankUnits() == imageUnits - 1, "unit set back to 0xFF: erase, that unit not programmed");
+
+    // --- appending behind the image, into erased units ---
+    startFromExpect();
+    const uint8_t more[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    write(800, more, sizeof(more));
+    check(counts(0, unitsCovering(800, 807)), "aligned append into erased flash: no erase");
+    startFromExpect();
+    write(883, more, 5);
+    check(counts(0, unitsCovering(883, 887)), "unaligned append: only the units it touches");
+
+    // --- one unit in place, one not: the one that is not decides ---
+    startFromExpect();
+    uint8_t both[48];
+    memcpy(both, expect + IMAGE_AT + IMAGE_SIZE - 24, sizeof(both));
+    both[0] ^= 0x80;
+    both[40] = 0x42;            // behind the image, still erased
+    write(IMAGE_AT + IMAGE_SIZE - 24, both, sizeof(both));
+    report("mixed");
+#if defined(MODEL_STM32F4)
+    bool clears = (image[IMAGE_SIZE - 24] & 0x80) != 0;
+    check(clears ? counts(0, 2) : counts(1, nonBlankUnits()), "erased unit + changed unit: erase only if a bit must rise");
+#else
+    check(counts(1, nonBlankUnits()), "erased unit + written unit: erase, both back");
+#endif
+
+    // --- the whole page, like eeprom_buffer_flush() ---
+    startFromExpect();
+    eeprom_buffer_flush();
+    check(counts(0, 0), "eeprom_buffer_flush() of an unchanged buffer: nothing");
+
+    printf("    (before: %u erase(s) and %u programs on every save)\n", 1u, (uint32_t)sizeof(expect) / UNIT);
+}
+
+int main() {
+    checkEeprom();
+    checkFlush();
+
+    printf("\n%s (%d failed)\n", failures ? "FAIL" : "OK", failures);
+    return failures ? 1 : 0;
+}
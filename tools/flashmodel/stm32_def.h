@@ -0,0 +1,90 @@
+/**
+ * @file stm32_def.h
+ * @author Ebrahim Siami
+ * @brief The bits of the STM32 core / HAL that FlashStorage_STM32 uses, for the host flash model
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * lib/FlashStorage_STM32/src/utility/stm32_eeprom.hpp includes "stm32_def.h";
+ * with -I tools/flashmodel it finds this one. The emulated EEPROM page is
+ * flashModelPage[] in host RAM instead of the last page of the flash, the HAL
+ * flash calls are implemented in flash_model.cpp.
+ *
+ * Default is the F103 of the Blue Pill (1 KB page, halfword programming).
+ * -D MODEL_STM32F4 gives the F2/F4/F7 rules (word programming, bits may be
+ * cleared in place) on the same 1 KB.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(MODEL_STM32F4)
+  #define STM32F4xx
+  #define FLASH_SECTOR_TOTAL        8U
+#else
+  #define STM32F1xx
+  #define FLASH_BANK_1              1U
+  #define FLASH_BANK1_END           0x0800FFFFU
+#endif
+
+#define FLASH_PAGE_SIZE             0x400U
+#define FLASH_END                   0x0800FFFFU
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint8_t flashModelPage[FLASH_PAGE_SIZE];
+
+#ifdef __cplusplus
+}
+#endif
+
+// The emulated EEPROM lives in flashModelPage[]. HAL addresses are the low
+// 32 bits of it, flash_model.cpp maps them back.
+#define FLASH_BASE_ADDRESS          ((uintptr_t)flashModelPage)
+
+typedef enum {
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef struct {
+    uint32_t TypeErase;
+    uint32_t Banks;
+    uint32_t PageAddress;
+    uint32_t NbPages;
+    uint32_t Sector;
+    uint32_t NbSectors;
+    uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+#define FLASH_TYPEERASE_PAGES       0x00U
+#define FLASH_TYPEERASE_SECTORS     0x01U
+#define FLASH_VOLTAGE_RANGE_3       0x02U
+
+#define FLASH_TYPEPROGRAM_HALFWORD  0x01U
+#define FLASH_TYPEPROGRAM_WORD      0x02U
+#define FLASH_TYPEPROGRAM_DOUBLEWORD 0x03U
+
+#define FLASH_FLAG_EOP              0x20U
+#define FLASH_FLAG_WRPERR           0x10U
+#define FLASH_FLAG_PGERR            0x04U
+
+#define __HAL_FLASH_CLEAR_FLAG(flags) ((void)(flags))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef* pEraseInit, uint32_t* PageError);
+
+#ifdef __cplusplus
+}
+#endif
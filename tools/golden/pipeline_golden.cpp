@@ -0,0 +1,234 @@
+/**
+ * @file pipeline_golden.cpp
+ * @author Ebrahim Siami
+ * @brief Golden-output generator / checker for src/ChannelPipeline.cpp
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Sweeps all 4096 raw ADC values through processSticks() + applyMix() for a
+ * grid of calibration, expo, dual rate, EPA/sub-trim, trim, inversion,
+ * throttle mode, all five mixer presets and 5/9/17-point custom curves, and keeps one CRC-32 per configuration. A rewrite of
+ * the pipeline (fixed point, new mixer, ...) is bit-exact if --check passes.
+ *
+ * Build:
+ *   g++ -O2 -std=gnu++14 -I../../native/include -I../../src pipeline_golden.cpp \
+ *       ../../src/ChannelPipeline.cpp ../../src/Mixer.cpp ../../src/Curves.cpp \
+ *       ../../src/FlightModes.cpp ../../src/Crc.cpp ../../native/src/NativeHal.cpp -o pipeline_golden
+ *
+ * Usage:
+ *   pipeline_golden > pipeline.golden       regenerate (only after an intended change!)
+ *   pipeline_golden --check pipeline.golden compare, exit code 1 on any difference
+ *   pipeline_golden --bench                 throughput of the pipeline only
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include "ChannelPipeline.h"
+#include "Crc.h"
+
+static const int DEADBAND = 50;   // same as main.cpp
+static const int SAMPLES = 4096;
+
+// =============================================================================
+// --- Configuration grid ---
+// =============================================================================
+
+struct Calib { const char* name; int min, center, max; };
+struct Expo  { const char* name; int roll, pitch, yaw; };
+struct Rate  { const char* name; bool enabled; uint8_t roll, pitch, yaw; };
+struct Epa   { const char* name; int min, sub, max, trim1, trim2, trim3; };
+
+static const Calib CALIBS[] = {
+    { "full",   0,    2048, 4095 },
+    { "typ",    310,  2010, 3790 },
+    { "skew",   120,  1400, 3980 },
+    { "bad",    2000, 2048, 2100 },   // too narrow, processChannel() falls back to sub-trim
+};
+static const Expo EXPOS[] = {
+    { "e0",     0,   0,   0 },
+    { "e+",     35,  60,  100 },
+    { "e-",     -50, -25, -100 },
+};
+static const Rate RATES[] = {
+    { "dr-off", false, 50, 50, 50 },
+    { "dr",     true,  70, 100, 35 },
+};
+static const Epa EPAS[] = {
+    { "epa",    0,   2048, 4095, 2048, 2048, 2048 },
+    { "epa-",   500, 2048, 3500, 2148, 1958, 2048 },
+    { "sub",    0,   2300, 4095, 2048, 3072, 1024 },
+};
+
+struct CurveShape { const char* name; uint8_t points; int8_t y[CURVE_MAX_POINTS]; };
+
+static const CurveShape CURVES[] = {
+    { "c5",  5,  { -100, -40, 10, 50, 100 } },
+    { "c9",  9,  { -100, -80, -50, -20, 0, 30, 60, 90, 100 } },
+    { "c17", 17, { 100, 60, 20, -20, -60, -100, -70, -40, 0, 40, 70, 100, 75, 50, 25, 0, -25 } },   // not monotone on purpose
+};
+
+struct Config {
+    std::string name;
+    RadioSettings settings;
+};
+
+static std::vector<Config> buildConfigs() {
+    std::vector<Config> configs;
+    for (const Calib& c : CALIBS)
+    for (const Expo& e : EXPOS)
+    for (const Rate& r : RATES)
+    for (const Epa& p : EPAS)
+    for (int inv = 0; inv < 2; inv++)
+    for (int plane = 0; plane < 2; plane++)
+    for (uint8_t mix = 0; mix < 5; mix++) {
+        Config cfg;
+        RadioSettings& s = cfg.settings;
+        memset(&s, 0, sizeof(s));
+        for (int i = 0; i < 4; i++) {
+            s.calibMin[i] = c.min;
+            s.calibCenter[i] = c.center;
+            s.calibMax[i] = c.max;
+            s.epaMin[i] = p.min;
+            s.subTrim[i] = p.sub;
+            s.epaMax[i] = p.max;
+            s.channelInverted[i] = inv && (i != 1);   // pitch stays normal, so mixes see both senses
+        }
+        s.trim1 = p.trim1; s.trim2 = p.trim2; s.trim3 = p.trim3;
+        s.expoRoll = e.roll; s.expoPitch = e.pitch; s.expoYaw = e.yaw;
+        s.dualRateEnabled = r.enabled;
+        s.dualRateRoll = r.roll; s.dualRatePitch = r.pitch; s.dualRateYaw = r.yaw;
+        s.airplaneMode = plane;
+        s.mixMode = mix;
+        mixerApplyPreset(s.mixLines, mix);
+
+        char name[96];
+        snprintf(name, sizeof(name), "%s/%s/%s/%s/%s/%s/mix%u", c.name, e.name, r.name, p.name,
+                 inv ? "inv" : "nor", plane ? "plane" : "quad", mix);
+        cfg.name = name;
+        configs.push_back(cfg);
+
+        // Custom curves on all four sticks (names without a suffix have none)
+        if (mix != 0) continue;
+        for (const CurveShape& shape : CURVES) {
+            Config curved = cfg;
+            for (int i = 0; i < CURVE_CHANNELS; i++) {
+                CustomCurve& curve = curved.settings.stickCurves[i];
+                curve.points = shape.points;
+                memcpy(curve.y, shape.y, sizeof(curve.y));
+                curveBuild(curve);
+            }
+            curved.name += "/";
+            curved.name += shape.name;
+            configs.push_back(curved);
+        }
+    }
+    return configs;
+}
+
+// Every stick gets a different permutation of 0..4095, so the mixer sees all kinds of pairs
+static inline void stickInputs(int i, int raw[STICK_COUNT]) {
+    raw[STICK_ROLL]     = i;
+    raw[STICK_PITCH]    = 4095 - i;
+    raw[STICK_THROTTLE] = (i * 5 + 777) & 4095;
+    raw[STICK_YAW]      = (i * 7 + 1234) & 4095;
+}
+
+// One control tick, aux channels fixed (pots centered, switches off)
+static inline void runTick(const RadioSettings& s, const int raw[STICK_COUNT], int out[MIX_CHANNELS]) {
+    processSticks(s, DEADBAND, raw, out);
+    out[MIX_CH_AUX1] = 2048;
+    out[MIX_CH_AUX2] = 2048;
+    out[MIX_CH_AUX3] = 0;
+    out[MIX_CH_AUX4] = 0;
+    applyMix(s, out);
+}
+
+static uint32_t digest(const RadioSettings& s) {
+    uint8_t buf[SAMPLES * STICK_COUNT * 2];
+    uint8_t* q = buf;
+    for (int i = 0; i < SAMPLES; i++) {
+        int raw[STICK_COUNT], out[MIX_CHANNELS];
+        stickInputs(i, raw);
+        runTick(s, raw, out);
+        for (int ch = 0; ch < STICK_COUNT; ch++) {
+            *q++ = (uint8_t)out[ch];
+            *q++ = (uint8_t)(out[ch] >> 8);
+        }
+    }
+    return Crc::crc32(buf, sizeof(buf));
+}
+
+// =============================================================================
+// --- Modes ---
+// =============================================================================
+
+static int generate(const std::vector<Config>& configs) {
+    printf("# ChannelPipeline golden digests: CRC-32 of %d samples x (roll, pitch, throttle, yaw) u16 LE\n", SAMPLES);
+    printf("# calib/expo/dual-rate/epa+trim/inversion/throttle-mode/mix[/curve]\n");
+    for (const Config& c : configs) printf("%08x %s\n", digest(c.settings), c.name.c_str());
+    return 0;
+}
+
+static int check(const std::vector<Config>& configs, const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) { perror(path); return 2; }
+
+    std::map<std::string, uint32_t> golden;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        unsigned crc;
+        char name[200];
+        if (sscanf(line, "%8x %199s", &crc, name) == 2) golden[name] = crc;
+    }
+    fclose(f);
+
+    int failures = 0, missing = 0;
+    for (const Config& c : configs) {
+        auto it = golden.find(c.name);
+        if (it == golden.end()) { missing++; continue; }
+        uint32_t crc = digest(c.settings);
+        if (crc != it->second) {
+            if (failures < 20) printf("MISMATCH %s: %08x, golden %08x\n", c.name.c_str(), crc, it->second);
+            failures++;
+        }
+    }
+    printf("%zu configurations, %d mismatches, %d not in %s\n", configs.size(), failures, missing, path);
+    return (failures || missing) ? 1 : 0;
+}
+
+static int bench(const std::vector<Config>& configs) {
+    volatile int sink = 0;
+    uint64_t samples = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const Config& c : configs) {
+        for (int i = 0; i < SAMPLES; i++) {
+            int raw[STICK_COUNT], out[MIX_CHANNELS];
+            stickInputs(i, raw);
+            runTick(c.settings, raw, out);
+            sink += out[0] + out[1] + out[2] + out[3];
+        }
+        samples += SAMPLES;
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("processSticks() + applyMix(): %llu samples in %.3f s, %.2f M samples/s (%.1f ns per tick)\n",
+           (unsigned long long)samples, sec, samples / sec / 1e6, sec * 1e9 / samples);
+    (void)sink;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<Config> configs = buildConfigs();
+
+    if (argc == 3 && !strcmp(argv[1], "--check")) return check(configs, argv[2]);
+    if (argc == 2 && !strcmp(argv[1], "--bench")) return bench(configs);
+    if (argc == 1) return generate(configs);
+
+    fprintf(stderr, "usage: %s [--check file | --bench]\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file latency_analyze.cpp
+ * @author Ebrahim Siami
+ * @brief Latency distributions from the 'L' records of a -D LATENCY_TRACE build
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Reads the USB output of the transmitter (simulator frames in between are
+ * fine), validates the latency records and prints, per stage, the time from
+ * the start of the control slot plus the time each step took on its own.
+ *
+ * Build:
+ *   g++ -O2 -std=c++14 -I../../src -I../simproto latency_analyze.cpp ../../src/Crc.cpp -o latency_analyze
+ *
+ * Usage:
+ *   latency_analyze latency.bin              capture of the CDC port (cat /dev/ttyACM0 > latency.bin)
+ *   latency_analyze /dev/ttyACM0             live, prints the table on Ctrl-C
+ *   latency_analyze --csv slots.csv f.bin    also one line per slot (microseconds, -1 = not reached)
+ *
+ * Native build with simulated timing:
+ *   g++ -DLATENCY_TRACE ... -o program && program --replay flight.trace --sim --timing --sim-out latency.bin
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <errno.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include "SimDecoder.h"
+
+using namespace SimProto;
+
+static volatile bool running = true;
+static void onSignal(int) { running = false; }
+
+struct Distribution {
+    const char* name;
+    std::vector<double> us;
+
+    explicit Distribution(const char* n) : name(n) {}
+
+    void add(double v) { us.push_back(v); }
+
+    void print() {
+        if (us.empty()) {
+            printf("  %-24s %8s\n", name, "-");
+            return;
+        }
+        std::sort(us.begin(), us.end());
+        double sum = 0;
+        for (double v : us) sum += v;
+        auto pct = [&](double p) { return us[std::min(us.size() - 1, (size_t)(p * (us.size() - 1) + 0.5))]; };
+        printf("  %-24s %8zu %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+               name, us.size(), us.front(), pct(0.5), pct(0.9), pct(0.99), us.back(), sum / us.size());
+    }
+};
+
+static int openInput(const char* path) {
+    if (strcmp(path, "-") == 0) return STDIN_FILENO;
+
+    int fd = open(path, O_RDONLY | O_NOCTTY);
+    if (fd < 0) { perror(path); exit(1); }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    const char* csvPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--csv") && i + 1 < argc) csvPath = argv[++i];
+        else path = argv[i];
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s [--csv slots.csv] <capture|tty|->\n", argv[0]);
+        return 1;
+    }
+
+    int fd = openInput(path);
+    FILE* csv = csvPath ? fopen(csvPath, "w") : nullptr;
+    if (csvPath && !csv) { perror(csvPath); return 1; }
+    if (csv) fprintf(csv, "seq,sampled_us,pipeline_us,radio_us,usb_us,period_us\n");
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    // From the slot start
+    Distribution sampled{ "slot -> sampled" }, pipeline{ "slot -> pipeline done" };
+    Distribution radio{ "slot -> RF written" }, usb{ "slot -> USB queued" };
+    // Each step on its own
+    Distribution adcStep{ "  ADC reads" }, pipeStep{ "  pipeline" };
+    Distribution radioStep{ "  pipeline -> RF" }, usbStep{ "  pipeline -> USB" };
+    Distribution period{ "slot period" };
+
+    Decoder dec;
+    bool havePrev = false;
+    LatencyRecord prev = LatencyRecord();
+    uint8_t buf[4096];
+
+    while (running) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+
+        dec.feed(buf, (size_t)n, [](const Sample&) {}, [&](const LatencyRecord& r) {
+            double per = -1;
+            if (havePrev && r.seq == prev.seq + 1 && r.mhz == prev.mhz) {
+                per = (uint32_t)(r.t[LAT_SLOT] - prev.t[LAT_SLOT]) / (double)r.mhz;
+                period.add(per);
+            }
+            prev = r;
+            havePrev = true;
+
+            if (r.has(LAT_SAMPLED)) { sampled.add(r.us(LAT_SAMPLED)); adcStep.add(r.us(LAT_SAMPLED)); }
+            if (r.has(LAT_PIPELINE)) {
+                pipeline.add(r.us(LAT_PIPELINE));
+                if (r.has(LAT_SAMPLED)) pipeStep.add(r.us(LAT_PIPELINE) - r.us(LAT_SAMPLED));
+            }
+            if (r.has(LAT_RADIO)) {
+                radio.add(r.us(LAT_RADIO));
+                if (r.has(LAT_PIPELINE)) radioStep.add(r.us(LAT_RADIO) - r.us(LAT_PIPELINE));
+            }
+            if (r.has(LAT_USB)) {
+                usb.add(r.us(LAT_USB));
+                if (r.has(LAT_PIPELINE)) usbStep.add(r.us(LAT_USB) - r.us(LAT_PIPELINE));
+            }
+
+            if (csv) {
+                fprintf(csv, "%u", r.seq);
+                for (int s = LAT_SAMPLED; s < LAT_STAGES; s++) fprintf(csv, ",%.1f", r.has(s) ? r.us(s) : -1.0);
+                fprintf(csv, ",%.1f\n", per);
+            }
+        });
+    }
+    if (csv) fclose(csv);
+
+    const DecoderStats& st = dec.stats();
+    printf("%llu latency records (%llu lost), %llu simulator samples, %llu crc errors, %llu bytes skipped\n\n",
+           (unsigned long long)st.latencyRecords, (unsigned long long)st.latencyLost,
+           (unsigned long long)st.samples, (unsigned long long)st.crcErrors, (unsigned long long)st.skippedBytes);
+    printf("  %-24s %8s %9s %9s %9s %9s %9s %9s   (us)\n", "", "count", "min", "p50", "p90", "p99", "max", "mean");
+    sampled.print();
+    adcStep.print();
+    pipeline.print();
+    pipeStep.print();
+    radio.print();
+    radioStep.print();
+    usb.print();
+    usbStep.print();
+    period.print();
+    return st.latencyRecords ? 0 : 1;
+}
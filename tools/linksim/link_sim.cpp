@@ -0,0 +1,230 @@
+/**
+ * @file link_sim.cpp
+ * @author Ebrahim Siami
+ * @brief Frame error rate of the NRF24 link with and without redundant frames
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Sends the same frames through a lossy channel once per redundancy depth
+ * (radio_format.h) and decodes them with the receiver side (RedundantRx).
+ * The loss pattern is the same for every depth, so the rows compare fairly:
+ *
+ *   bytes / airtime   payload per packet and its time on the air at 250 kbps
+ *   pkt loss          packets lost by the channel
+ *   FER on time       frames not there in their own slot (what the servos see without redundancy)
+ *   FER effective     frames never delivered, not even late from a later packet
+ *   recovered         lost frames brought back 1 / 2 slots late (~ = with an escaped channel)
+ *   hole              longest run of frames missing on time / missing for good
+ *
+ * Every delivered frame is checked against what was sent.
+ *
+ * Build:
+ *   g++ -O2 -std=c++14 -I../../src link_sim.cpp -o link_sim
+ *
+ * Usage:
+ *   link_sim                           built-in stick sweeps, 60 s at 500 Hz, 5 % random loss
+ *   link_sim -p 0.2                    20 % random loss
+ *   link_sim -g 0.01,0.3,0.8           bursts: good->bad 1 %, bad->good 30 %, 80 % loss while bad
+ *   link_sim -f frames.bin             frames of a replay (program --replay t --data-out frames.bin)
+ *   link_sim -s 7                      another loss pattern
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <random>
+#include <vector>
+#include "radio_format.h"
+
+using namespace RadioFormat;
+
+// Air time at 250 kbps: preamble + 5 address bytes + payload + CRC-16, 32 us per byte
+static double airtimeUs(uint8_t payload) {
+    return (1 + 5 + payload + 2) * 8 * 4.0;
+}
+
+// =============================================================================
+// --- Frames ---
+// =============================================================================
+
+static bool loadFrames(const char* path, std::vector<data_t>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) { perror(path); return false; }
+    data_t d;
+    while (fread(&d, sizeof(d), 1, f) == 1) out.push_back(d);
+    fclose(f);
+    return !out.empty();
+}
+
+// Sticks on slow sweeps with a few fast flicks, like the native sweep plus some aggressive flying
+static void syntheticFrames(uint32_t count, std::vector<data_t>& out) {
+    for (uint32_t i = 0; i < count; i++) {
+        double t = i / 500.0;
+        double flick = fmod(t, 4.0) < 0.15 ? sin(2.0 * M_PI * t / 0.3) : 0.0;   // 150 ms stick flick every 4 s
+        data_t d;
+        d.roll     = (uint16_t)(1024 + 950 * (0.7 * sin(2.0 * M_PI * t / 2.0) + 0.3 * flick));
+        d.pitch    = (uint16_t)(1024 + 950 * sin(2.0 * M_PI * t / 3.0));
+        d.throttle = (uint16_t)(1023.5 - 1023.5 * cos(2.0 * M_PI * t / 5.0));
+        d.yaw      = (uint16_t)(1024 + 950 * sin(2.0 * M_PI * t / 7.0));
+        d.aux1     = (uint8_t)(128 + 120 * sin(2.0 * M_PI * t / 11.0));
+        d.aux2     = (uint8_t)(128 + 120 * sin(2.0 * M_PI * t / 13.0));
+        d.aux3     = fmod(t, 6.0) < 3.0;
+        d.aux4     = fmod(t, 10.0) < 5.0;
+        out.push_back(d);
+    }
+}
+
+// =============================================================================
+// --- Loss model ---
+// =============================================================================
+
+struct LossModel {
+    bool   burst = false;
+    double p = 0.05;            // random loss
+    double pGoodBad = 0.01;     // Gilbert-Elliott
+    double pBadGood = 0.3;
+    double lossBad = 0.8;
+    double lossGood = 0.0;
+};
+
+// One pass over the channel: true = packet i is lost
+static std::vector<bool> lossPattern(const LossModel& m, size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<bool> lost(count);
+    bool bad = false;
+    for (size_t i = 0; i < count; i++) {
+        if (m.burst) {
+            bad = bad ? (u(rng) >= m.pBadGood) : (u(rng) < m.pGoodBad);
+            lost[i] = u(rng) < (bad ? m.lossBad : m.lossGood);
+        } else {
+            lost[i] = u(rng) < m.p;
+        }
+    }
+    return lost;
+}
+
+// =============================================================================
+// --- Simulation ---
+// =============================================================================
+
+struct Result {
+    uint64_t lostPackets = 0;
+    uint64_t missedOnTime = 0;
+    uint64_t missedForGood = 0;
+    uint64_t recovered[MAX_DEPTH + 1] = {};
+    uint64_t approximate = 0;
+    uint64_t wrong = 0;
+    uint32_t holeOnTime = 0;
+    uint32_t holeForGood = 0;
+};
+
+static uint32_t longestRun(const std::vector<bool>& missing) {
+    uint32_t run = 0, best = 0;
+    for (bool m : missing) {
+        run = m ? run + 1 : 0;
+        if (run > best) best = run;
+    }
+    return best;
+}
+
+static Result simulate(const std::vector<data_t>& frames, const std::vector<bool>& lost, uint8_t depth) {
+    Result r;
+    RedundantRx rx;
+    std::vector<bool> onTime(frames.size(), false), delivered(frames.size(), false);
+    data_t history[MAX_DEPTH + 1];
+
+    for (size_t i = 0; i < frames.size(); i++) {
+        // transmitter: same history handling as radioWrite()
+        for (uint8_t j = 0; j <= MAX_DEPTH; j++) history[j] = frames[i >= j ? i - j : 0];
+        uint8_t packet[MAX_PACKET];
+        uint8_t len = depth ? makeRedundant(history, depth, (uint8_t)i, packet) : (uint8_t)sizeof(data_t);
+        if (!depth) memcpy(packet, &frames[i], sizeof(data_t));
+
+        if (lost[i]) {
+            r.lostPackets++;
+            continue;
+        }
+
+        // receiver
+        uint32_t approxBefore = rx.approximate;
+        rx.receive(packet, len, [&](const data_t& f, uint8_t late) {
+            size_t k = i - late;
+            bool approx = late && rx.approximate != approxBefore;
+            if (!approx && !sameFrame(f, frames[k])) r.wrong++;
+            if (late == 0) onTime[k] = true;
+            else {
+                r.recovered[late]++;
+                if (approx) r.approximate++;
+            }
+            delivered[k] = true;
+            approxBefore = rx.approximate;
+        });
+    }
+
+    std::vector<bool> missOnTime(frames.size()), missForGood(frames.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        missOnTime[i] = !onTime[i];
+        missForGood[i] = !delivered[i];
+        r.missedOnTime += missOnTime[i];
+        r.missedForGood += missForGood[i];
+    }
+    r.holeOnTime = longestRun(missOnTime);
+    r.holeForGood = longestRun(missForGood);
+    return r;
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    uint32_t seed = 1;
+    uint32_t seconds = 60;
+    LossModel model;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-f") && i + 1 < argc) path = argv[++i];
+        else if (!strcmp(argv[i], "-p") && i + 1 < argc) { model.burst = false; model.p = atof(argv[++i]); }
+        else if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+            model.burst = true;
+            sscanf(argv[++i], "%lf,%lf,%lf,%lf", &model.pGoodBad, &model.pBadGood, &model.lossBad, &model.lossGood);
+        }
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) seconds = (uint32_t)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-f frames.bin | -t seconds] [-p loss | -g pGB,pBG,lossBad[,lossGood]] [-s seed]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<data_t> frames;
+    if (path) {
+        if (!loadFrames(path, frames)) return 1;
+    } else {
+        syntheticFrames(seconds * 500, frames);
+    }
+
+    std::vector<bool> lost = lossPattern(model, frames.size(), seed);
+
+    printf("%zu frames (%.1f s at 500 Hz), ", frames.size(), frames.size() / 500.0);
+    if (model.burst) {
+        printf("burst loss: good->bad %.3f, bad->good %.3f, loss %.2f bad / %.2f good\n\n",
+               model.pGoodBad, model.pBadGood, model.lossBad, model.lossGood);
+    } else {
+        printf("random loss %.3f\n\n", model.p);
+    }
+
+    printf("  depth  bytes  airtime  pkt loss  FER on time  FER effective  recovered +1/+2 (~)   hole on time/good  wrong\n");
+    for (uint8_t depth = 0; depth <= MAX_DEPTH; depth++) {
+        Result r = simulate(frames, lost, depth);
+        double n = (double)frames.size();
+        printf("  %5u  %5u  %4.0f us  %7.3f%%  %10.4f%%  %12.4f%%  %7llu/%-7llu (%llu)  %8u/%-8u  %llu\n",
+               depth, packetSize(depth), airtimeUs(packetSize(depth)),
+               100.0 * r.lostPackets / n, 100.0 * r.missedOnTime / n, 100.0 * r.missedForGood / n,
+               (unsigned long long)r.recovered[1], (unsigned long long)r.recovered[2],
+               (unsigned long long)r.approximate, r.holeOnTime, r.holeForGood, (unsigned long long)r.wrong);
+    }
+    printf("\n  (the radio pads every payload to 32 bytes unless setPayloadSize() is used: %.0f us each)\n",
+           airtimeUs(32));
+    return 0;
+}
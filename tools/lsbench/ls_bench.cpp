@@ -0,0 +1,145 @@
+/**
+ * @file ls_bench.cpp
+ * @author Ebrahim Siami
+ * @brief Host check & micro-benchmark for the logical switches in src/LogicalSwitches.cpp
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Checks lsCompile() + lsEvaluate() against a plain evaluation of the user
+ * form (percent, seconds) on random switch setups and inputs, then prints the
+ * time per tick with no switch in use and with all LS_COUNT of them in use.
+ * The two numbers should be about the same, that's the point of the table.
+ *
+ *   g++ -O2 -std=gnu++14 -I../../native/include -I../../src ls_bench.cpp ../../src/LogicalSwitches.cpp -o ls_bench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <random>
+#include "LogicalSwitches.h"
+
+// Reference: straight from the user form, no precomputed anything
+static bool refOn(uint32_t state, uint8_t ref) {
+    uint8_t bit = ref & ~LS_REF_NOT;
+    bool on = bit != LS_REF_NONE && bit < LS_REF_COUNT && ((state >> bit) & 1);
+    return (ref & LS_REF_NOT) ? !on : on;
+}
+
+static uint32_t refEvaluate(const LogicalSwitch sw[LS_COUNT], const LsInputs& in, uint32_t state) {
+    state &= ~((1UL << LS_REF_NONE) | (1UL << LS_REF_AUX3) | (1UL << LS_REF_AUX4));
+    if (in.aux3) state |= 1UL << LS_REF_AUX3;
+    if (in.aux4) state |= 1UL << LS_REF_AUX4;
+
+    for (int i = 0; i < LS_COUNT; i++) {
+        const LogicalSwitch& s = sw[i];
+        bool on = false;
+        if (s.func >= LS_FUNC_GT && s.func <= LS_FUNC_ABS_LT && s.a < LS_INPUTS) {
+            double percent = (in.value[s.a] - 2048) * 100.0 / 2048.0;
+            double x = constrain(s.value, -100, 100);
+            // the table compares in 12-bit steps, round the threshold the same way
+            double k = (double)((int32_t)x * 2048 / 100) * 100.0 / 2048.0;
+            switch (s.func) {
+                case LS_FUNC_GT:     on = percent > k; break;
+                case LS_FUNC_LT:     on = percent < k; break;
+                case LS_FUNC_ABS_GT: on = (percent < 0 ? -percent : percent) > k; break;
+                case LS_FUNC_ABS_LT: on = (percent < 0 ? -percent : percent) < k; break;
+            }
+        } else if (s.func == LS_FUNC_AND) {
+            on = refOn(state, s.a) && refOn(state, s.b);
+        } else if (s.func == LS_FUNC_OR) {
+            on = refOn(state, s.a) || refOn(state, s.b);
+        } else if (s.func == LS_FUNC_XOR) {
+            on = refOn(state, s.a) != refOn(state, s.b);
+        } else if (s.func == LS_FUNC_TIMER) {
+            on = in.timerMs >= (uint32_t)constrain(s.value, 0, LS_TIMER_MAX_S) * 1000UL;
+        }
+        uint32_t mask = 1UL << (LS_REF_L1 + i);
+        state = on ? (state | mask) : (state & ~mask);
+    }
+    return state;
+}
+
+static void randomSwitches(std::mt19937& rng, LogicalSwitch sw[LS_COUNT], bool allUsed) {
+    for (int i = 0; i < LS_COUNT; i++) {
+        LogicalSwitch& s = sw[i];
+        s.func = allUsed ? 1 + rng() % (LS_FUNC_COUNT - 1) : rng() % (LS_FUNC_COUNT + 1);
+        if (lsIsLogic(s.func)) {
+            s.a = (rng() % LS_REF_COUNT) | ((rng() & 1) ? LS_REF_NOT : 0);
+            s.b = (rng() % LS_REF_COUNT) | ((rng() & 1) ? LS_REF_NOT : 0);
+        } else {
+            s.a = rng() % (LS_INPUTS + 1);
+            s.b = 0;
+        }
+        s.value = (s.func == LS_FUNC_TIMER) ? rng() % 600 : (int)(rng() % 221) - 110;
+    }
+}
+
+static void randomInputs(std::mt19937& rng, LsInputs& in) {
+    int ch[MIX_CHANNELS];
+    for (int i = 0; i < MIX_CHANNELS; i++) ch[i] = rng() % 4096;
+    lsSetChannels(in, ch);
+    in.aux3 = rng() & 1;
+    in.aux4 = rng() & 1;
+    in.timerMs = rng() % 700000;
+}
+
+static double nsPerTick(const LsProgram& program, const LsInputs* inputs, size_t count) {
+    volatile uint32_t sink = 0;
+    uint32_t state = 0;
+    size_t ticks = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double sec = 0;
+    do {
+        for (size_t i = 0; i < count; i++) state = lsEvaluate(program, inputs[i], state);
+        ticks += count;
+        sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (sec < 0.3);
+    sink = state;
+    (void)sink;
+    return sec * 1e9 / ticks;
+}
+
+int main() {
+    std::mt19937 rng(12345);
+
+    // --- correctness: 2000 setups, 500 ticks each (state carried over, like the firmware) ---
+    size_t failures = 0;
+    for (int setup = 0; setup < 2000; setup++) {
+        LogicalSwitch sw[LS_COUNT];
+        randomSwitches(rng, sw, setup & 1);
+        LsProgram program;
+        lsCompile(sw, program);
+
+        uint32_t state = 0, ref = 0;
+        for (int tick = 0; tick < 500; tick++) {
+            LsInputs in;
+            randomInputs(rng, in);
+            state = lsEvaluate(program, in, state);
+            ref = refEvaluate(sw, in, ref);
+            if (state != ref) { failures++; break; }
+        }
+    }
+    printf("lsEvaluate vs reference on 2000 random setups: %s (%zu mismatches)\n\n", failures ? "FAIL" : "OK", failures);
+
+    // --- speed: the same inputs with no switch and with all LS_COUNT switches in use ---
+    const size_t COUNT = 4096;
+    static LsInputs inputs[COUNT];
+    for (size_t i = 0; i < COUNT; i++) randomInputs(rng, inputs[i]);
+
+    LogicalSwitch none[LS_COUNT] = {};
+    LogicalSwitch full[LS_COUNT];
+    randomSwitches(rng, full, true);
+    LsProgram pNone, pFull;
+    lsCompile(none, pNone);
+    lsCompile(full, pFull);
+
+    double tNone = nsPerTick(pNone, inputs, COUNT);
+    double tFull = nsPerTick(pFull, inputs, COUNT);
+    printf("per tick, %d switches:\n", LS_COUNT);
+    printf("  none in use  %8.1f ns\n", tNone);
+    printf("  all in use   %8.1f ns\n", tFull);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file settings_bench.cpp
+ * @author Ebrahim Siami
+ * @brief Host benchmark of settingsLoad() / settingsSave() against the old byte-wise EEPROM path
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Builds src/SettingsStore.cpp against the RAM backed EEPROMClass of the
+ * native build and times per call:
+ *
+ *   - settingsLoad() / settingsSave() as they are: one bulk get()/put() of the
+ *     header + packed StoredSettings image, compare-before-write on put()
+ *   - the same image moved through the per-byte get()/put() loop of
+ *     FlashStorage_STM32 1.2.0 (one eeprom_buffered_read_byte() /
+ *     eeprom_buffered_write_byte() call per byte), same pack/unpack and CRC
+ *   - the original EEPROM.get(10, settings) / EEPROM.put(10, settings) of the
+ *     whole in-RAM RadioSettings, byte-wise, no header and no CRC
+ *
+ * Only the CPU side is measured. On the board a save that changed something
+ * also erases / programs the flash page, which costs milliseconds
+ * and dominates every number here.
+ *
+ *   g++ -O2 -std=gnu++14 -I../../native/include -I../../src settings_bench.cpp ../../src/SettingsStore.cpp ../../src/Crc.cpp \
+ *       ../../src/Mixer.cpp ../../src/Curves.cpp ../../src/FlightModes.cpp -o settings_bench
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include "SettingsStore.h"
+#include "Crc.h"
+#include <FlashStorage_STM32.hpp>
+
+// Defined in NativeHal.cpp for the firmware build
+EEPROMClass EEPROM;
+
+// =============================================================================
+// --- The old path ---
+// =============================================================================
+
+// FlashStorage_STM32 1.2.0: the buffered accessors live in stm32_eeprom_Impl.h,
+// compiled into main.cpp only, so get()/put() elsewhere call them per byte.
+static uint8_t oldBuffer[E2END + 1];
+
+__attribute__((noinline)) static uint8_t oldReadByte(const uint32_t& pos) {
+    return oldBuffer[pos];
+}
+
+__attribute__((noinline)) static void oldWriteByte(const uint32_t& pos, const uint8_t& value) {
+    oldBuffer[pos] = value;
+}
+
+template< typename T > static T& oldGet(const int& idx, T& t) {
+    uint16_t offset = idx;
+    uint8_t* _pointer = (uint8_t*)&t;
+    for (uint16_t count = sizeof(T); count; --count, ++offset) {
+        *_pointer++ = oldReadByte(offset);
+    }
+    return t;
+}
+
+template< typename T > static const T& oldPut(const int& idx, const T& t) {
+    uint16_t offset = idx;
+    const uint8_t* _pointer = (const uint8_t*)&t;
+    for (uint16_t count = sizeof(T); count; --count, ++offset) {
+        oldWriteByte(offset, *_pointer++);
+    }
+    // eeprom_buffer_flush() followed here, every time
+    return t;
+}
+
+struct __attribute__((packed)) Image {
+    SettingsHeader header;
+    StoredSettings payload;
+};
+
+static SettingsLoadResult oldLoad(RadioSettings& s) {
+    static uint8_t image[sizeof(Image)];     // as big as the one settingsLoad() reads
+    oldGet(SETTINGS_EEPROM_ADDRESS, image);
+    SettingsLoadResult result = settingsDecodeImage(image, sizeof(image), s);
+    if (result == SETTINGS_DEFAULTED) settingsSetDefaults(s);
+    return result;
+}
+
+static void oldSave(const RadioSettings& s) {
+    Image image;
+    image.header.magic = SETTINGS_HEADER_MAGIC;
+    image.header.version = SETTINGS_VERSION;
+    image.header.length = sizeof(StoredSettings);
+    image.header.reserved = 0;
+    settingsPack(s, image.payload);
+    uint16_t crc = Crc::crc16((const uint8_t*)&image.header.version, sizeof(image.header.version));
+    crc = Crc::crc16((const uint8_t*)&image.header.length, sizeof(image.header.length), crc);
+    image.header.crc = Crc::crc16((const uint8_t*)&image.payload, sizeof(image.payload), crc);
+    oldPut(SETTINGS_EEPROM_ADDRESS, image);
+}
+
+// =============================================================================
+// --- Timing ---
+// =============================================================================
+
+template< typename F > static double nsPerCall(F f) {
+    size_t calls = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double sec = 0;
+    do {
+        for (int i = 0; i < 1000; i++) f(i);
+        calls += 1000;
+        sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (sec < 0.3);
+    return sec * 1e9 / calls;
+}
+
+int main() {
+    RadioSettings a, b, check;
+    settingsSetDefaults(a);
+    settingsSetDefaults(b);
+    b.trim1 = 37;   // two settings that differ, so every save has something to write
+
+    // --- both paths store and read back the same thing ---
+    settingsSave(b);
+    oldSave(b);
+    bool same = memcmp(EEPROM.data() + SETTINGS_EEPROM_ADDRESS, oldBuffer + SETTINGS_EEPROM_ADDRESS, sizeof(Image)) == 0;
+    bool loaded = settingsLoad(check) == SETTINGS_LOADED && check.trim1 == 37;
+    loaded = loaded && oldLoad(check) == SETTINGS_LOADED && check.trim1 == 37;
+    printf("same image on both paths, read back: %s\n\n", same && loaded ? "OK" : "FAIL");
+
+    // --- speed ---
+    RadioSettings out;
+    double load    = nsPerCall([&](int) { settingsLoad(out); });
+    double save    = nsPerCall([&](int i) { settingsSave((i & 1) ? a : b); });
+    double same1   = nsPerCall([&](int) { settingsSave(a); });
+    double oldL    = nsPerCall([&](int) { oldLoad(out); });
+    double oldS    = nsPerCall([&](int i) { oldSave((i & 1) ? a : b); });
+    double rawL    = nsPerCall([&](int) { oldGet(SETTINGS_EEPROM_ADDRESS, out); });
+    double rawS    = nsPerCall([&](int i) { oldPut(SETTINGS_EEPROM_ADDRESS, (i & 1) ? a : b); });
+
+    printf("per call (host, CPU only):                     load          save\n");
+    printf("  settingsLoad/Save, bulk %3zu B image     %8.0f ns   %8.0f ns  (unchanged save %.0f ns)\n",
+           sizeof(Image), load, save, same1);
+    printf("  same image, byte-wise get/put (1.2.0)   %8.0f ns   %8.0f ns\n", oldL, oldS);
+    printf("  RadioSettings %3zu B, byte-wise, no CRC  %8.0f ns   %8.0f ns\n", sizeof(RadioSettings), rawL, rawS);
+    printf("\nflash writes counted by the native EEPROM: %u (one per changed save)\n", EEPROM.commits());
+    return same && loaded ? 0 : 1;
+}
@@ -0,0 +1,275 @@
+/**
+ * @file simbridge.cpp
+ * @author Ebrahim Siami
+ * @brief Linux bridge: simulator stream -> virtual joystick (uinput)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Reads the SimProto stream from the transmitter's CDC port (or a pipe/pty),
+ * resynchronizes on AA BB, validates CRC and sequence and publishes the
+ * channels as a uinput joystick that any simulator can use.
+ *
+ * Build:
+ *   g++ -O2 -std=c++14 -I../../src -I../simproto simbridge.cpp ../../src/Crc.cpp -o simbridge
+ *
+ * Usage:
+ *   simbridge /dev/ttyACM0               v1 stream, joystick "STM32 RC Transmitter"
+ *   simbridge -v 2 -b 4 /dev/ttyACM0     ask for protocol v2, 4 samples per frame
+ *   simbridge -v 2 -b 4 -c 16 /dev/ttyACM0   ... with 16 channels, one axis each
+ *   simbridge --pty                      create a pseudo-tty and read from it (no hardware)
+ *   simbridge --no-uinput - < capture    decode a capture without creating a device
+ *
+ * Needs write access to /dev/uinput (e.g. a udev rule or the 'input' group).
+ *
+ * Latency: the transmitter clock and the host clock are not synchronized, so
+ * for v2 the bridge reports (host arrival - transmitter timestamp) relative
+ * to the smallest value seen. That is the extra delay on top of the fastest
+ * sample, which is what shows up as jitter in the simulator. For both versions
+ * it also reports the time from read() returning to the uinput event.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <time.h>
+#include <errno.h>
+#include <algorithm>
+#include <vector>
+#include <linux/uinput.h>
+#include "SimDecoder.h"
+
+using namespace SimProto;
+
+static volatile bool running = true;
+static void onSignal(int) { running = false; }
+
+static uint64_t nowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+// =============================================================================
+// --- Virtual joystick ---
+// =============================================================================
+
+// Channel order of the transmitter: Roll, Pitch, Throttle, Yaw, Aux1, Aux2, Aux3, Aux4, ...
+static const int AXES[] = { ABS_X, ABS_Y, ABS_Z, ABS_RX, ABS_RY, ABS_RZ, ABS_THROTTLE, ABS_RUDDER,
+                            ABS_WHEEL, ABS_GAS, ABS_BRAKE, ABS_HAT0X, ABS_HAT0Y, ABS_HAT1X, ABS_HAT1Y, ABS_MISC };
+static const int SWITCH_BUTTONS = 8;
+
+class Joystick {
+public:
+    bool open() {
+        _fd = ::open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+        if (_fd < 0) { perror("/dev/uinput"); return false; }
+
+        ioctl(_fd, UI_SET_EVBIT, EV_ABS);
+        ioctl(_fd, UI_SET_EVBIT, EV_KEY);
+        ioctl(_fd, UI_SET_EVBIT, EV_SYN);
+
+        for (int axis : AXES) {
+            ioctl(_fd, UI_SET_ABSBIT, axis);
+            struct uinput_abs_setup abs;
+            memset(&abs, 0, sizeof(abs));
+            abs.code = axis;
+            abs.absinfo.minimum = 0;
+            abs.absinfo.maximum = 4095;
+            ioctl(_fd, UI_ABS_SETUP, &abs);
+        }
+        for (int i = 0; i < SWITCH_BUTTONS; i++) ioctl(_fd, UI_SET_KEYBIT, BTN_TRIGGER_HAPPY1 + i);
+        ioctl(_fd, UI_SET_KEYBIT, BTN_JOYSTICK);   // makes the device show up as a joystick
+
+        struct uinput_setup setup;
+        memset(&setup, 0, sizeof(setup));
+        setup.id.bustype = BUS_VIRTUAL;
+        setup.id.vendor = 0x1209;    // pid.codes test VID
+        setup.id.product = 0x5243;   // "RC"
+        setup.id.version = 1;
+        snprintf(setup.name, UINPUT_MAX_NAME_SIZE, "STM32 RC Transmitter");
+
+        if (ioctl(_fd, UI_DEV_SETUP, &setup) < 0 || ioctl(_fd, UI_DEV_CREATE) < 0) {
+            perror("uinput setup");
+            ::close(_fd);
+            _fd = -1;
+            return false;
+        }
+        return true;
+    }
+
+    void publish(const Sample& s) {
+        if (_fd < 0) return;
+        for (int i = 0; i < s.channelCount && i < (int)(sizeof(AXES) / sizeof(AXES[0])); i++) {
+            emit(EV_ABS, AXES[i], s.channels[i]);
+        }
+        for (int i = 0; i < SWITCH_BUTTONS; i++) {
+            emit(EV_KEY, BTN_TRIGGER_HAPPY1 + i, (s.switches >> i) & 1);
+        }
+        emit(EV_SYN, SYN_REPORT, 0);
+    }
+
+    ~Joystick() {
+        if (_fd >= 0) {
+            ioctl(_fd, UI_DEV_DESTROY);
+            ::close(_fd);
+        }
+    }
+
+private:
+    int _fd = -1;
+
+    void emit(int type, int code, int value) {
+        struct input_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.type = type;
+        ev.code = code;
+        ev.value = value;
+        if (write(_fd, &ev, sizeof(ev)) < 0 && errno != EAGAIN) perror("uinput write");
+    }
+};
+
+// =============================================================================
+// --- Statistics ---
+// =============================================================================
+
+struct LatencyStats {
+    std::vector<uint32_t> values;
+
+    void add(uint32_t us) { values.push_back(us); }
+
+    void print(const char* name) {
+        if (values.empty()) return;
+        std::sort(values.begin(), values.end());
+        auto pct = [&](double p) { return values[(size_t)(p * (values.size() - 1))]; };
+        fprintf(stderr, "  %-22s p50 %6u us  p99 %6u us  max %6u us\n", name, pct(0.5), pct(0.99), values.back());
+        values.clear();
+    }
+};
+
+// =============================================================================
+// --- Input ---
+// =============================================================================
+
+static int openInput(const char* path, bool pty) {
+    int fd;
+    if (pty) {
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (fd < 0 || grantpt(fd) < 0 || unlockpt(fd) < 0) { perror("pty"); exit(1); }
+        fprintf(stderr, "simbridge: reading from %s (write the stream into it)\n", ptsname(fd));
+    } else if (strcmp(path, "-") == 0) {
+        return STDIN_FILENO;
+    } else {
+        fd = open(path, O_RDWR | O_NOCTTY);
+        if (fd < 0) { perror(path); exit(1); }
+    }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    int version = 0, batch = 1, channels = V2_MIN_CHANNELS;
+    bool useUinput = true, pty = false;
+    int interval = 5;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-v") && i + 1 < argc) version = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) batch = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc) channels = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-i") && i + 1 < argc) interval = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--no-uinput")) useUinput = false;
+        else if (!strcmp(argv[i], "--pty")) pty = true;
+        else path = argv[i];
+    }
+    if (!path && !pty) {
+        fprintf(stderr, "usage: %s [-v 1|2] [-b batch] [-c channels] [-i stats_seconds] [--no-uinput] <tty|-|--pty>\n", argv[0]);
+        return 1;
+    }
+
+    int fd = openInput(path, pty);
+    // No SA_RESTART (signal() sets it): read() has to return EINTR, or a quiet
+    // or unplugged transmitter keeps it blocked and Ctrl-C never gets through
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onSignal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    Joystick joystick;
+    if (useUinput && !joystick.open()) return 1;
+
+    if (version) {
+        uint8_t req[REQUEST_SIZE];
+        Decoder::makeVersionRequest((uint8_t)version, (uint8_t)batch, (uint8_t)channels, req);
+        if (write(fd, req, sizeof(req)) != (ssize_t)sizeof(req)) perror("version request");
+    }
+
+    Decoder dec;
+    DecoderStats last;
+    LatencyStats linkLatency, bridgeLatency;
+    int64_t minOffset = INT64_MAX;
+    uint64_t nextReport = nowUs() + interval * 1000000ULL;
+    uint64_t lastReport = nowUs();
+    uint8_t buf[512];
+
+    while (running) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        uint64_t arrival = nowUs();
+
+        dec.feed(buf, (size_t)n, [&](const Sample& s) {
+            joystick.publish(s);
+            uint64_t published = nowUs();
+            bridgeLatency.add((uint32_t)(published - arrival));
+
+            if (s.version == VERSION_2) {
+                int64_t offset = (int64_t)arrival - (int64_t)s.timeUs;
+                if (offset < minOffset) minOffset = offset;
+                linkLatency.add((uint32_t)(offset - minOffset));
+            }
+        });
+
+        // Log drops as soon as they happen, everything else periodically
+        const DecoderStats& st = dec.stats();
+        if (st.lostFrames != last.lostFrames || st.outOfOrder != last.outOfOrder || st.crcErrors != last.crcErrors) {
+            fprintf(stderr, "simbridge: lost %llu, out-of-order %llu, crc errors %llu\n",
+                    (unsigned long long)(st.lostFrames - last.lostFrames),
+                    (unsigned long long)(st.outOfOrder - last.outOfOrder),
+                    (unsigned long long)(st.crcErrors - last.crcErrors));
+            last.lostFrames = st.lostFrames;
+            last.outOfOrder = st.outOfOrder;
+            last.crcErrors = st.crcErrors;
+        }
+
+        if (arrival >= nextReport) {
+            double sec = (arrival - lastReport) / 1e6;
+            fprintf(stderr, "simbridge: %.0f samples/s, %.0f frames/s, %.1f kB/s\n",
+                    (st.samples - last.samples) / sec, (st.frames - last.frames) / sec,
+                    (st.bytes - last.bytes) / sec / 1000.0);
+            linkLatency.print("link (relative, v2)");
+            bridgeLatency.print("read -> uinput");
+            last.samples = st.samples;
+            last.frames = st.frames;
+            last.bytes = st.bytes;
+            lastReport = arrival;
+            nextReport = arrival + interval * 1000000ULL;
+        }
+    }
+
+    const DecoderStats& st = dec.stats();
+    fprintf(stderr, "simbridge: total samples %llu frames %llu lost %llu out-of-order %llu crc errors %llu skipped bytes %llu\n",
+            (unsigned long long)st.samples, (unsigned long long)st.frames, (unsigned long long)st.lostFrames,
+            (unsigned long long)st.outOfOrder, (unsigned long long)st.crcErrors, (unsigned long long)st.skippedBytes);
+    return 0;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file SimDecoder.h
+ * @author Ebrahim Siami
+ * @brief Host-side reference decoder for the simulator protocol (v1 + v2)
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Feed it raw bytes from the CDC port (any chunk size), it resynchronizes on
+ * the AA BB header, checks the CRC and the sequence counter and calls back
+ * once per decoded sample. The format itself lives in src/sim_protocol_format.h.
+ * Latency records of -D LATENCY_TRACE builds are validated too and handed to
+ * a second callback if there is one.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "sim_protocol_format.h"
+#include "Crc.h"
+
+namespace SimProto {
+
+struct Sample {
+    uint8_t  version;
+    uint8_t  seq;            // packet/frame sequence number
+    uint32_t timeUs;         // transmitter micros() (v2 only, 0 for v1)
+    uint8_t  channelCount;
+    uint16_t channels[V2_MAX_CHANNELS];
+    uint8_t  switches;
+};
+
+struct LatencyRecord {
+    uint32_t seq;
+    uint8_t  mhz;                // cycle counter ticks per us
+    uint8_t  flags;              // bit n: t[n] reached
+    uint32_t t[LAT_STAGES];      // cycle counter per LatencyStage
+
+    bool has(uint8_t stage) const { return (flags >> stage) & 1; }
+
+    // Microseconds from the slot start to 'stage'
+    double us(uint8_t stage) const { return (uint32_t)(t[stage] - t[LAT_SLOT]) / (double)mhz; }
+};
+
+struct DecoderStats {
+    uint64_t bytes = 0;
+    uint64_t frames = 0;         // valid v1 packets + v2 frames
+    uint64_t samples = 0;
+    uint64_t crcErrors = 0;
+    uint64_t lostFrames = 0;     // counted from sequence gaps
+    uint64_t outOfOrder = 0;     // sequence went backwards (or repeated)
+    uint64_t skippedBytes = 0;   // bytes dropped while resynchronizing
+    uint64_t latencyRecords = 0;
+    uint64_t latencyLost = 0;    // counted from latency record sequence gaps
+};
+
+class Decoder {
+public:
+    /**
+     * @brief Decodes as many complete frames as possible from 'data'.
+     * @param onSample Callable as onSample(const Sample&).
+     */
+    template <typename F>
+    void feed(const uint8_t* data, size_t len, F onSample) {
+        feed(data, len, onSample, [](const LatencyRecord&) {});
+    }
+
+    /**
+     * @brief Same, with onLatency(const LatencyRecord&) for the latency records.
+     */
+    template <typename F, typename L>
+    void feed(const uint8_t* data, size_t len, F onSample, L onLatency) {
+        _stats.bytes += len;
+        _buf.insert(_buf.end(), data, data + len);
+
+        while (true) {
+            size_t avail = _buf.size() - _pos;
+            const uint8_t* p = _buf.data() + _pos;
+
+            // 1. find the header
+            if (avail < 3) break;
+            if (p[0] != HEADER1 || p[1] != HEADER2) { skip(1); continue; }
+
+            // 2. how long is this frame?
+            size_t frameLen = 0;
+            if (p[2] == VERSION_1) {
+                frameLen = 18;
+            } else if (p[2] == LATENCY_RECORD) {
+                frameLen = LATENCY_SIZE;
+            } else if (p[2] == VERSION_2) {
+                if (avail < 6) break;
+                if (p[4] == 0 || p[4] > V2_MAX_CHANNELS || p[5] == 0 || p[5] > V2_MAX_BATCH) { skip(1); continue; }
+                frameLen = v2FrameSize(p[4], p[5]);
+            } else {
+                skip(1);
+                continue;
+            }
+            if (avail < frameLen) break;
+
+            // 3. validate and hand out the samples
+            bool ok = (p[2] == VERSION_1)      ? decodeV1(p, onSample)
+                    : (p[2] == LATENCY_RECORD) ? decodeLatency(p, onLatency)
+                    :                            decodeV2(p, frameLen, onSample);
+            if (ok) {
+                _pos += frameLen;
+            } else {
+                _stats.crcErrors++;
+                skip(1);
+            }
+        }
+
+        // keep the buffer from growing forever
+        if (_pos > 4096) {
+            _buf.erase(_buf.begin(), _buf.begin() + _pos);
+            _pos = 0;
+        }
+    }
+
+    const DecoderStats& stats() const { return _stats; }
+
+    /**
+     * @brief Builds the version request the transmitter listens for.
+     * @param channels Channels per v2 sample, V2_MIN_CHANNELS..V2_MAX_CHANNELS.
+     */
+    static void makeVersionRequest(uint8_t version, uint8_t batch, uint8_t channels, uint8_t out[REQUEST_SIZE]) {
+        out[0] = HEADER1;
+        out[1] = HEADER2;
+        out[2] = REQUEST_VERSION;
+        out[3] = version;
+        out[4] = batch;
+        out[5] = channels;
+        out[6] = Crc::crc8(&out[2], REQUEST_SIZE - 3);
+    }
+
+private:
+    std::vector<uint8_t> _buf;
+    size_t _pos = 0;
+    DecoderStats _stats;
+    bool _haveSeq = false;
+    uint8_t _lastSeq = 0;
+    uint8_t _lastVersion = 0;
+    bool _haveLatencySeq = false;
+    uint32_t _lastLatencySeq = 0;
+
+    void skip(size_t n) {
+        _pos += n;
+        _stats.skippedBytes += n;
+    }
+
+    void trackSeq(uint8_t version, uint8_t seq) {
+        // v1 and v2 have their own counters, start over when the host switches
+        if (version != _lastVersion) _haveSeq = false;
+        _lastVersion = version;
+
+        if (_haveSeq) {
+            uint8_t gap = (uint8_t)(seq - _lastSeq - 1);
+            if (gap >= 128) _stats.outOfOrder++;   // went backwards or repeated
+            else _stats.lostFrames += gap;
+        }
+        _haveSeq = true;
+        _lastSeq = seq;
+        _stats.frames++;
+    }
+
+    template <typename F>
+    bool decodeV1(const uint8_t* p, F& onSample) {
+        if (Crc::crc8(p, 17) != p[17]) return false;
+
+        trackSeq(p[2], p[3]);
+
+        Sample s;
+        memset(&s, 0, sizeof(s));
+        s.version = VERSION_1;
+        s.seq = p[3];
+        s.channelCount = 6;
+        for (int i = 0; i < 6; i++) s.channels[i] = getU16(p + 4 + 2 * i) & 0x0FFF;
+        s.switches = p[16];
+
+        _stats.samples++;
+        onSample(s);
+        return true;
+    }
+
+    template <typename L>
+    bool decodeLatency(const uint8_t* p, L& onLatency) {
+        if (Crc::crc16(p + 2, LATENCY_SIZE - 2 - V2_CRC_SIZE) != getU16(p + LATENCY_SIZE - V2_CRC_SIZE)) return false;
+
+        LatencyRecord r;
+        r.seq = getU32(p + 3);
+        r.mhz = p[7];
+        r.flags = p[8];
+        for (int i = 0; i < LAT_STAGES; i++) r.t[i] = getU32(p + 9 + 4 * i);
+        if (r.mhz == 0) return false;
+
+        if (_haveLatencySeq && r.seq - _lastLatencySeq - 1 < 0x80000000UL) _stats.latencyLost += r.seq - _lastLatencySeq - 1;
+        _haveLatencySeq = true;
+        _lastLatencySeq = r.seq;
+        _stats.latencyRecords++;
+        onLatency(r);
+        return true;
+    }
+
+    template <typename F>
+    bool decodeV2(const uint8_t* p, size_t len, F& onSample) {
+        if (Crc::crc16(p + 2, len - 2 - V2_CRC_SIZE) != getU16(p + len - V2_CRC_SIZE)) return false;
+
+        trackSeq(p[2], p[3]);
+
+        uint8_t nCh = p[4];
+        uint8_t nSamples = p[5];
+        uint32_t t = getU32(p + 6);
+        const uint8_t* q = p + V2_HEADER_SIZE;
+
+        for (uint8_t i = 0; i < nSamples; i++) {
+            Sample s;
+            memset(&s, 0, sizeof(s));
+            s.version = VERSION_2;
+            s.seq = p[3];
+            t += getU16(q);
+            s.timeUs = t;
+            s.switches = q[2];
+            s.channelCount = nCh;
+            unpack12(q + 3, nCh, s.channels);
+            q += v2SampleSize(nCh);
+
+            _stats.samples++;
+            onSample(s);
+        }
+        return true;
+    }
+};
+
+} // namespace SimProto
@@ -0,0 +1,170 @@
+/**
+ * @file simproto_dump.cpp
+ * @author Ebrahim Siami
+ * @brief Dumps the simulator stream of the transmitter, or benchmarks the decoder
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Build (Linux / macOS):
+ *   g++ -O2 -std=c++14 -I../../src simproto_dump.cpp ../../src/Crc.cpp -o simproto_dump
+ *
+ * Usage:
+ *   simproto_dump /dev/ttyACM0            print every sample (v1 or v2, auto detected)
+ *   simproto_dump -v 2 -b 4 /dev/ttyACM0  ask the transmitter for v2, 4 samples per frame
+ *   simproto_dump -v 2 -b 4 -c 16 /dev/ttyACM0   ... with all 16 channels of the channel frame
+ *   simproto_dump -                       read from stdin (e.g. a recorded capture)
+ *   simproto_dump --bench 1000000         decoder throughput, v1 vs v2 on synthetic data
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <chrono>
+#include "SimDecoder.h"
+
+using namespace SimProto;
+
+static volatile bool running = true;
+
+static void onSignal(int) { running = false; }
+
+// =============================================================================
+// --- Synthetic encoder (mirrors src/sim_protocol.cpp) ---
+// =============================================================================
+
+static size_t encodeV1(uint8_t seq, const uint16_t* ch, uint8_t switches, uint8_t* out) {
+    out[0] = HEADER1; out[1] = HEADER2; out[2] = VERSION_1; out[3] = seq;
+    for (int i = 0; i < 6; i++) putU16(out + 4 + 2 * i, ch[i] & 0x0FFF);
+    out[16] = switches;
+    out[17] = Crc::crc8(out, 17);
+    return 18;
+}
+
+static size_t encodeV2(uint8_t seq, uint8_t nCh, uint8_t nSamples, uint32_t t0,
+                       const uint16_t* ch, uint8_t switches, uint8_t* out) {
+    out[0] = HEADER1; out[1] = HEADER2; out[2] = VERSION_2; out[3] = seq;
+    out[4] = nCh; out[5] = nSamples;
+    putU32(out + 6, t0);
+    uint8_t* q = out + V2_HEADER_SIZE;
+    for (uint8_t i = 0; i < nSamples; i++) {
+        putU16(q, i == 0 ? 0 : 2000);
+        q[2] = switches;
+        pack12(ch, nCh, q + 3);
+        q += v2SampleSize(nCh);
+    }
+    size_t len = v2FrameSize(nCh, nSamples);
+    putU16(out + len - V2_CRC_SIZE, Crc::crc16(out + 2, len - 2 - V2_CRC_SIZE));
+    return len;
+}
+
+static void runBench(uint64_t samples) {
+    struct Case { const char* name; uint8_t version, nCh, batch; };
+    const Case cases[] = {
+        { "v1  6ch         ", 1, 6, 1 },
+        { "v2  8ch batch 1 ", 2, 8, 1 },
+        { "v2  8ch batch 4 ", 2, 8, 4 },
+        { "v2 16ch batch 1 ", 2, 16, 1 },
+        { "v2 16ch batch 4 ", 2, 16, 4 },
+    };
+
+    printf("case              bytes/sample  writes/s@500Hz  decode Msamples/s\n");
+
+    for (const Case& c : cases) {
+        // Encode once into a big buffer, then time the decoder only
+        std::vector<uint8_t> stream;
+        uint16_t ch[V2_MAX_CHANNELS];
+        uint8_t frame[V2_MAX_FRAME];
+        uint64_t encoded = 0;
+        uint8_t seq = 0;
+        while (encoded < samples) {
+            for (int i = 0; i < V2_MAX_CHANNELS; i++) ch[i] = (uint16_t)((encoded * 7 + i * 331) & 0x0FFF);
+            size_t n = (c.version == 1) ? encodeV1(seq++, ch, 0x01, frame)
+                                        : encodeV2(seq++, c.nCh, c.batch, (uint32_t)encoded * 2000, ch, 0x01, frame);
+            stream.insert(stream.end(), frame, frame + n);
+            encoded += c.batch;
+        }
+
+        Decoder dec;
+        uint64_t checksum = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t off = 0; off < stream.size(); off += 64) {     // 64 = one USB FS packet
+            size_t n = stream.size() - off < 64 ? stream.size() - off : 64;
+            dec.feed(stream.data() + off, n, [&](const Sample& s) { checksum += s.channels[0]; });
+        }
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        printf("%s  %12.2f  %14.0f  %17.2f   (errors %llu, sum %llu)\n", c.name,
+               (double)stream.size() / dec.stats().samples,
+               500.0 / c.batch,
+               dec.stats().samples / sec / 1e6,
+               (unsigned long long)dec.stats().crcErrors, (unsigned long long)checksum);
+    }
+}
+
+// =============================================================================
+// --- Live dump ---
+// =============================================================================
+
+static int openPort(const char* path) {
+    if (strcmp(path, "-") == 0) return STDIN_FILENO;
+
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) { perror(path); exit(1); }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {   // only for real ttys, pipes are fine as they are
+        cfmakeraw(&tio);
+        cfsetspeed(&tio, B115200);    // ignored by CDC, but keeps the driver happy
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    int version = 0, batch = 1, channels = V2_MIN_CHANNELS;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--bench") && i + 1 < argc) { runBench(strtoull(argv[++i], nullptr, 10)); return 0; }
+        else if (!strcmp(argv[i], "-v") && i + 1 < argc) version = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) batch = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc) channels = atoi(argv[++i]);
+        else path = argv[i];
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s [-v 1|2] [-b batch] [-c channels] <tty|->\n       %s --bench <samples>\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    int fd = openPort(path);
+    signal(SIGINT, onSignal);
+
+    if (version) {
+        uint8_t req[REQUEST_SIZE];
+        Decoder::makeVersionRequest((uint8_t)version, (uint8_t)batch, (uint8_t)channels, req);
+        if (write(fd, req, sizeof(req)) != (ssize_t)sizeof(req)) perror("version request");
+    }
+
+    Decoder dec;
+    uint8_t buf[512];
+    while (running) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        dec.feed(buf, (size_t)n, [](const Sample& s) {
+            printf("v%u seq=%3u t=%10u sw=%02x ch=", s.version, s.seq, s.timeUs, s.switches);
+            for (int i = 0; i < s.channelCount; i++) printf("%s%4u", i ? "," : "", s.channels[i]);
+            printf("\n");
+        });
+    }
+
+    const DecoderStats& st = dec.stats();
+    fprintf(stderr, "bytes %llu frames %llu samples %llu crc errors %llu lost %llu out-of-order %llu skipped %llu\n",
+            (unsigned long long)st.bytes, (unsigned long long)st.frames, (unsigned long long)st.samples,
+            (unsigned long long)st.crcErrors, (unsigned long long)st.lostFrames,
+            (unsigned long long)st.outOfOrder, (unsigned long long)st.skippedBytes);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file trainer_client.cpp
+ * @author Ebrahim Siami
+ * @brief Streams channel frames into the transmitter for the trainer / HIL mode
+ * @version 4.0.1
+ * @date 2026-10-16
+ *
+ * Writes 'H' frames (src/sim_protocol_format.h) to the transmitter's CDC port
+ * at a fixed rate. Switch the transmitter to Features -> "Trainer USB" and it
+ * sends these channels to the model instead of the sticks; stop the client and
+ * the sticks are back after Trainer::TIMEOUT_MS.
+ *
+ * Build:
+ *   g++ -O2 -std=c++14 -I../../src trainer_client.cpp ../../src/Crc.cpp -o trainer_client
+ *
+ * Usage:
+ *   trainer_client /dev/ttyACM0                  built-in script: 1 s at idle, then slow sweeps
+ *   trainer_client -r 250 -s 30 /dev/ttyACM0     250 frames/s for 30 s
+ *   trainer_client -f flight.csv /dev/ttyACM0    one frame per line, values 0..4095 separated by ',' or spaces
+ *   trainer_client -f flight.csv -l ...          loop the file
+ *   trainer_client - > frames.bin                write the stream to stdout (e.g. for a pty)
+ *
+ * The throttle (3rd channel) has to be at idle for 100 ms before the
+ * transmitter lets it through, like the sticks at power-on. The built-in
+ * script starts that way, a CSV file should too.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <time.h>
+#include <errno.h>
+#include <math.h>
+#include <vector>
+#include "sim_protocol_format.h"
+
+using namespace SimProto;
+
+static volatile bool running = true;
+static void onSignal(int) { running = false; }
+
+static uint64_t nowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static void sleepUntil(uint64_t us) {
+    uint64_t now = nowUs();
+    if (us <= now) return;
+    struct timespec ts;
+    ts.tv_sec = (time_t)((us - now) / 1000000ULL);
+    ts.tv_nsec = (long)((us - now) % 1000000ULL) * 1000;
+    nanosleep(&ts, nullptr);
+}
+
+// =============================================================================
+// --- Channel sources ---
+// =============================================================================
+
+typedef std::vector<uint16_t> Frame;
+
+static bool loadCsv(const char* path, uint8_t channels, std::vector<Frame>& out) {
+    FILE* f = fopen(path, "r");
+    if (!f) { perror(path); return false; }
+
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        Frame frame(channels, 2048);
+        char* p = line;
+        for (uint8_t c = 0; c < channels; c++) {
+            char* end;
+            long v = strtol(p, &end, 10);
+            if (end == p) break;
+            frame[c] = (uint16_t)(v < 0 ? 0 : (v > 4095 ? 4095 : v));
+            p = end;
+            while (*p == ',' || *p == ' ' || *p == '\t') p++;
+        }
+        out.push_back(frame);
+    }
+    fclose(f);
+    return !out.empty();
+}
+
+// Built-in script: 1 s everything centered with the throttle at idle, then slow sweeps
+static void scripted(double t, uint8_t channels, Frame& frame) {
+    frame.assign(channels, 2048);
+    if (channels > 2) frame[2] = 0;
+    if (t < 1.0) return;
+
+    t -= 1.0;
+    const double periods[] = { 2.0, 3.0, 5.0, 7.0, 11.0, 13.0 };
+    for (uint8_t c = 0; c < channels && c < 6; c++) {
+        double s = sin(2.0 * M_PI * t / periods[c]);
+        frame[c] = (uint16_t)(c == 2 ? 2047.5 - 2047.5 * cos(2.0 * M_PI * t / periods[c]) : 2048 + 1900 * s);
+    }
+    for (uint8_t c = 6; c < channels; c++) {
+        frame[c] = fmod(t, 2.0 * (c - 4)) < (c - 4) ? 0 : 4095;   // switches flipping every few seconds
+    }
+}
+
+// =============================================================================
+// --- Output ---
+// =============================================================================
+
+static int openOutput(const char* path) {
+    if (strcmp(path, "-") == 0) return STDOUT_FILENO;
+
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) { perror(path); exit(1); }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    int rate = 500, channels = 8;
+    double seconds = 0;
+    bool loopFile = false;
+    const char* csvPath = nullptr;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-r") && i + 1 < argc) rate = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc) channels = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) csvPath = argv[++i];
+        else if (!strcmp(argv[i], "-l")) loopFile = true;
+        else path = argv[i];
+    }
+    if (!path || rate < 1 || rate > 1000 || channels < 1 || channels > V2_MAX_CHANNELS) {
+        fprintf(stderr, "usage: %s [-r frames_per_s (500)] [-c channels (8)] [-s seconds] [-f file.csv [-l]] <tty|->\n",
+                argv[0]);
+        return 1;
+    }
+
+    std::vector<Frame> file;
+    if (csvPath && !loadCsv(csvPath, (uint8_t)channels, file)) return 1;
+
+    int fd = openOutput(path);
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    const uint64_t periodUs = 1000000ULL / rate;
+    const uint64_t start = nowUs();
+    uint64_t next = start;
+    uint64_t sent = 0, late = 0;
+    uint8_t seq = 0;
+    Frame frame;
+
+    while (running) {
+        double t = (next - start) / 1e6;
+        if (seconds > 0 && t >= seconds) break;
+
+        if (csvPath) {
+            if (sent >= file.size() && !loopFile) break;
+            frame = file[sent % file.size()];
+        } else {
+            scripted(t, (uint8_t)channels, frame);
+        }
+
+        uint8_t buf[HOST_MAX_FRAME];
+        size_t len = makeChannelFrame(seq++, frame.data(), (uint8_t)channels, buf);
+        ssize_t n = write(fd, buf, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n != (ssize_t)len) { perror("write"); break; }
+        sent++;
+
+        // fixed schedule, a late frame doesn't shift the ones after it
+        next += periodUs;
+        if (nowUs() > next) late++;
+        sleepUntil(next);
+    }
+
+    double sec = (nowUs() - start) / 1e6;
+    fprintf(stderr, "trainer_client: %llu frames in %.1f s (%.0f/s), %llu late\n",
+            (unsigned long long)sent, sec, sec > 0 ? sent / sec : 0.0, (unsigned long long)late);
+    return 0;
+}